@@ -43,12 +43,28 @@ SOURCES += \
     src/ui/DrillControlPage.cpp \
     src/ui/PlanVisualizerPage.cpp \
     src/dataACQ/BaseWorker.cpp \
+    src/dataACQ/BufferPool.cpp \
+    src/dataACQ/LatencyHistogram.cpp \
+    src/dataACQ/PipelineLatency.cpp \
+    src/dataACQ/SampleClock.cpp \
+    src/dataACQ/VibrationKernels.cpp \
     src/dataACQ/VibrationWorker.cpp \
+    src/dataACQ/MdbSensorMap.cpp \
     src/dataACQ/MdbWorker.cpp \
     src/dataACQ/MotorWorker.cpp \
+    src/dataACQ/ReplayWorker.cpp \
+    src/dataACQ/SyntheticWorker.cpp \
     src/database/DbWriter.cpp \
+    src/database/DbStoragePolicy.cpp \
+    src/database/WalCheckpointer.cpp \
+    src/database/VibrationCodec.cpp \
+    src/database/VibrationSegments.cpp \
+    src/database/VibrationPyramid.cpp \
+    src/database/ScalarBlockCodec.cpp \
     src/database/DataQuerier.cpp \
+    src/control/AcquisitionConfig.cpp \
     src/control/AcquisitionManager.cpp \
+    src/control/ThreadPlacement.cpp \
     src/control/MotionLockManager.cpp \
     src/control/MotionConfigManager.cpp \
     src/control/MechanismTypes.cpp \
@@ -83,13 +99,31 @@ HEADERS += \
     include/ui/ControlPage.h \
     include/ui/DatabasePage.h \
     include/dataACQ/DataTypes.h \
+    include/dataACQ/SpscRing.h \
+    include/dataACQ/CreditGate.h \
+    include/dataACQ/BufferPool.h \
+    include/dataACQ/LatencyHistogram.h \
+    include/dataACQ/PipelineLatency.h \
+    include/dataACQ/SampleClock.h \
     include/dataACQ/BaseWorker.h \
+    include/dataACQ/VibrationKernels.h \
     include/dataACQ/VibrationWorker.h \
+    include/dataACQ/MdbSensorMap.h \
     include/dataACQ/MdbWorker.h \
     include/dataACQ/MotorWorker.h \
+    include/dataACQ/ReplayWorker.h \
+    include/dataACQ/SyntheticWorker.h \
     include/database/DbWriter.h \
+    include/database/DbStoragePolicy.h \
+    include/database/WalCheckpointer.h \
+    include/database/VibrationCodec.h \
+    include/database/VibrationSegments.h \
+    include/database/VibrationPyramid.h \
+    include/database/ScalarBlockCodec.h \
     include/database/DataQuerier.h \
+    include/control/AcquisitionConfig.h \
     include/control/AcquisitionManager.h \
+    include/control/ThreadPlacement.h \
     include/control/MotionLockManager.h \
     include/control/MotionConfigManager.h \
     include/control/MechanismDefs.h \
@@ -116,6 +150,19 @@ HEADERS += \
     include/ui/PlanVisualizerPage.h \
     include/ui/AutoTaskPage.h
 
+# ==================================================
+# 性能基准（qmake CONFIG+=bench 时编入，默认构建不含 --bench-* 入口）
+# ==================================================
+CONFIG(bench) {
+    DEFINES += DRILLCONTROL_BENCH
+    SOURCES += \
+        src/dataACQ/SampleClockBenchmark.cpp \
+        src/dataACQ/VibrationKernelsBenchmark.cpp \
+        src/dataACQ/MotorWorkerBenchmark.cpp \
+        src/database/DbWriterBenchmark.cpp \
+        src/database/VibrationCodecBenchmark.cpp
+}
+
 # ==================================================
 # UI界面文件
 # ==================================================
@@ -1,6 +1,8 @@
 -- ==================================================
 -- 钻机数据采集系统数据库 Schema v2.0
 -- 设计理念：时间窗口对齐机制，支持多频率传感器数据
+-- 说明：本文件为v2设计文档，程序不执行此脚本。
+--       实际建表/补列以 DbWriter::createTables() 为准（含后续新增的表和列）
 -- ==================================================
 
 -- SQLite 性能优化配置
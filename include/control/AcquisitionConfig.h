@@ -0,0 +1,63 @@
+#ifndef ACQUISITIONCONFIG_H
+#define ACQUISITIONCONFIG_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include "control/ThreadPlacement.h"
+#include "database/DbStoragePolicy.h"
+
+/**
+ * @brief 采集硬件布局配置（从config/acquisition.json加载）
+ *
+ * 由AcquisitionManager在initialize()中读取，决定创建几个振动Worker/线程，以及各采集线程的
+ * 放置策略（优先级、CPU绑定）和数据库持久性档位。
+ * 配置文件缺失或解析失败时使用内置默认值（单卡，卡号0），与原固定布局一致。
+ */
+class AcquisitionConfig
+{
+public:
+    static constexpr int MAX_VIBRATION_CARDS = 8;   // VK701卡号范围0-7
+
+    AcquisitionConfig();
+
+    /**
+     * @brief 内置默认配置：单张VK701，卡号0
+     */
+    static AcquisitionConfig defaultConfig();
+
+    /**
+     * @brief 在常用位置查找配置文件，找不到返回空字符串
+     */
+    static QString locateConfigFile();
+
+    bool loadFromFile(const QString &filePath, QString *errorMessage = nullptr);
+    bool loadFromJson(const QJsonObject &root, QString *errorMessage = nullptr);
+
+    /**
+     * @brief 振动采集卡号列表（按顺序分配全局通道号：第i张卡 = i*3 ~ i*3+2）
+     */
+    const QList<int> &vibrationCardIds() const { return m_vibrationCardIds; }
+    QString sourcePath() const { return m_sourcePath; }
+
+    /**
+     * @brief 线程放置策略（threads节）
+     * @param role 线程角色：vibration / vibration<卡号> / mdb / motor / db
+     * @param fallbackRole role未配置时使用的角色（如各卡共用vibration），都未配置返回Inherit
+     */
+    ThreadPolicy threadPolicy(const QString &role, const QString &fallbackRole = QString()) const;
+
+    /**
+     * @brief 数据库持久性档位和WAL检查点策略（database节，省略时为balanced + 1秒后台检查点）
+     */
+    const DbStoragePolicy &storagePolicy() const { return m_storagePolicy; }
+
+private:
+    QList<int> m_vibrationCardIds;
+    QMap<QString, ThreadPolicy> m_threadPolicies;   // key = 线程角色
+    DbStoragePolicy m_storagePolicy;
+    QString m_sourcePath;           // 配置来源（内置默认为空）
+};
+
+#endif // ACQUISITIONCONFIG_H
@@ -3,13 +3,22 @@
 
 #include <QObject>
 #include <QThread>
+#include <QMap>
+#include <QStringList>
+#include <QVector>
 #include "dataACQ/DataTypes.h"
+#include "dataACQ/SpscRing.h"
+#include "dataACQ/CreditGate.h"
+#include "dataACQ/PipelineLatency.h"
+#include "control/AcquisitionConfig.h"
 
 // 前向声明
 class BaseWorker;
 class VibrationWorker;
 class MdbWorker;
 class MotorWorker;
+class ReplayWorker;
+class SyntheticWorker;
 class DbWriter;
 
 /**
@@ -20,8 +29,15 @@ class DbWriter;
  * 2. 创建和管理DbWriter + 线程
  * 3. 提供统一的启动/停止接口
  * 4. 管理round_id生命周期
- * 5. 连接Worker信号到DbWriter
+ * 5. 通过无锁环形队列连接Worker到DbWriter
  * 6. 统一的错误处理和状态通知
+ * 7. 回放模式：用ReplayWorker替换硬件Worker，回放已记录的轮次（压测、问题复现）
+ * 8. 合成负载模式：用SyntheticWorker替换振动Worker，按指定采样率×通道数压测管线
+ * 9. 多卡振动采集：config/acquisition.json中每张VK701卡一个Worker + 线程 + 环形队列 + 写入额度，
+ *    第i张卡输出全局通道 i*3 ~ i*3+2，各卡互不共享采集路径，吞吐随卡数线性扩展
+ * 10. 线程放置：按配置设置各采集线程的OS线程名、调度优先级和CPU绑定，启动时输出生效结果和唤醒抖动
+ * 11. 管线延迟：按传感器类型汇总采集/排队/提交/渲染分段延迟，随statisticsUpdated输出，按轮次落盘
+ * 12. 数据库持久性：按配置的档位打开数据库，WAL大小和后台检查点耗时随statisticsUpdated输出
  *
  * 注意：
  * - 运动控制由 ZMotionDriver 和 MotionLockManager 统一管理
@@ -39,17 +55,51 @@ public:
     bool initialize(const QString &dbPath = "database/drill_data.db");
     void shutdown();
 
+    static constexpr int VIBRATION_CHANNELS_PER_CARD = 3;     // 每张VK701卡的振动通道数（X/Y/Z）
+
     // 获取Worker实例（用于配置）
-    VibrationWorker* vibrationWorker() { return m_vibrationWorker; }
+    VibrationWorker* vibrationWorker(int cardIndex = 0) const;     // 按配置顺序的第cardIndex张卡
+    QList<VibrationWorker*> vibrationWorkers() const;
+    int vibrationCardCount() const { return m_vibrationCards.size(); }
     MdbWorker* mdbWorker() { return m_mdbWorker; }
     MotorWorker* motorWorker() { return m_motorWorker; }
     DbWriter* dbWriter() { return m_dbWriter; }
+    SyntheticWorker* syntheticWorker() { return m_syntheticWorker; }
+
+    /**
+     * @brief 管线延迟统计（线程安全）：UI页面渲染数据块后调用recordRendered记录渲染分段
+     */
+    PipelineLatency* pipelineLatency() { return &m_pipelineLatency; }
 
     // 获取当前状态
     int currentRoundId() const { return m_currentRoundId; }
     bool isRunning() const { return m_isRunning; }
     QString dbPath() const { return m_dbPath; }
 
+    /**
+     * @brief 设置回放源：之后的startAll/startXxx启动回放Worker而不是硬件Worker（采集停止时调用）
+     * @param roundId 要回放的轮次，0表示关闭回放、恢复硬件采集
+     * @param speed 倍速（1 = 原始节奏，0 = 尽快）
+     * @param dbPath 源数据库，空表示当前数据库
+     *
+     * 回放数据写入新轮次，并经硬件Worker的UI环形队列/dataBlockReady信号交给UI和AutoDrillManager。
+     */
+    void setReplaySource(int roundId, double speed = 1.0, const QString &dbPath = QString());
+    bool isReplayMode() const { return m_replayRoundId > 0; }
+
+    /**
+     * @brief 振动数据流改由SyntheticWorker生成（采集停止时调用，优先于回放）
+     *
+     * 采样率和通道数通过syntheticWorker()配置；合成数据与实采数据走相同的通道和信号。
+     */
+    void setSyntheticVibration(bool enabled);
+    bool isSyntheticVibration() const { return m_syntheticVibration; }
+
+    /**
+     * @brief 启动报告：各采集线程实际生效的放置策略和唤醒抖动（抖动测量约1秒后完成）
+     */
+    QStringList threadPlacementReport() const;
+
 public slots:
     void startAll();
     void stopAll();
@@ -59,6 +109,7 @@ public slots:
     void stopVibration();
     void stopMdb();
     void stopMotor();
+    void startMotorCapture();   // 控制器端高速采集（MotorWorker::startCapture）
     void startNewRound(const QString &operatorName = QString(),
                        const QString &note = QString());
     void endCurrentRound();
@@ -71,20 +122,57 @@ signals:
     void statisticsUpdated(const QString &info);
 
 private:
+    void loadConfig();
     void setupWorkers();
     void setupThreads();
     void connectSignals();
+    void applyThreadPlacement();
+    void onThreadPlacementMeasured(const ThreadPlacementReport &report);
     void cleanupThreads();
+    void emitStatistics();
+    QList<BaseWorker*> vibrationSources() const;    // 当前模式下实际运行的Worker
+    BaseWorker *mdbSource() const;
+    BaseWorker *motorSource() const;
+    QList<BaseWorker*> allWorkers() const;
 
 private:
+    static constexpr int VIBRATION_BLOCK_DURATION_MS = 100;    // 振动流式块时长
+    static constexpr int VIBRATION_WRITE_CREDITS = 4096;       // 每张卡的振动写入额度（约4MB在途载荷）
+    static constexpr int VIBRATION_UI_RING_CAPACITY = 16;      // 每张卡到UI的块数（100ms块约1.6秒）
+    static constexpr int JITTER_PROBE_PERIOD_MS = 10;          // 唤醒抖动探测周期（与振动轮询节奏一致）
+    static constexpr int JITTER_PROBE_SAMPLES = 100;           // 探测次数（约1秒）
+
+    // 振动采集卡：每张卡独立的Worker、线程、输出通道和写入额度
+    struct VibrationCard {
+        VibrationWorker *worker = nullptr;
+        QThread *thread = nullptr;
+        DataBlockRing *ring = nullptr;
+        DataBlockRing *uiRing = nullptr;    // 到VibrationPage的通道（UI线程拉取）
+        CreditGate *credits = nullptr;
+        ReplayWorker *replay = nullptr;     // 回放本卡的通道，与worker共用线程和输出通道
+    };
+    QVector<VibrationCard> m_vibrationCards;   // 按配置顺序，[0]同时承载合成负载
+    AcquisitionConfig m_config;
+
     // Worker实例
-    VibrationWorker *m_vibrationWorker;
     MdbWorker *m_mdbWorker;
     MotorWorker *m_motorWorker;
     DbWriter *m_dbWriter;
 
+    // 回放Worker（MDB/电机各一个，振动按卡见VibrationCard::replay；运行在对应硬件Worker的线程中）
+    ReplayWorker *m_replayMdb;
+    ReplayWorker *m_replayMotor;
+    int m_replayRoundId;                // 回放源轮次（0 = 硬件采集）
+
+    // 合成负载Worker（运行在第一张卡的振动线程中）
+    SyntheticWorker *m_syntheticWorker;
+    bool m_syntheticVibration;
+
+    // Worker → DbWriter 无锁通道（每个Worker一个，振动通道见m_vibrationCards）
+    DataBlockRing *m_mdbRing;
+    DataBlockRing *m_motorRing;
+
     // 线程实例
-    QThread *m_vibrationThread;
     QThread *m_mdbThread;
     QThread *m_motorThread;
     QThread *m_dbThread;
@@ -95,6 +183,19 @@ private:
     bool m_isInitialized;
 
     QString m_dbPath;
+
+    // 线程放置启动报告
+    QList<ThreadPlacementReport> m_threadReports;
+    int m_threadReportsPending;         // 尚未完成抖动测量的线程数
+
+    // 统计信息（合并后通过statisticsUpdated输出）
+    QString m_dbStatsInfo;
+    QMap<QString, QString> m_ringStatsInfo;
+    QString m_latencyStatsInfo;
+    QString m_walStatsInfo;
+
+    // 管线分段延迟（DbWriter线程记录落盘分段，GUI线程记录渲染分段）
+    PipelineLatency m_pipelineLatency;
 };
 
 #endif // ACQUISITIONMANAGER_H
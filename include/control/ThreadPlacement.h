@@ -0,0 +1,81 @@
+#ifndef THREADPLACEMENT_H
+#define THREADPLACEMENT_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <functional>
+#include "dataACQ/LatencyHistogram.h"
+
+class QObject;
+
+/**
+ * @brief 单个采集线程的放置策略（优先级 + CPU绑定）
+ */
+struct ThreadPolicy {
+    enum class Priority {
+        Inherit,        // 不修改（继承进程默认）
+        Normal,
+        High,           // Linux: nice -10；Windows: THREAD_PRIORITY_HIGHEST
+        RealTime        // Linux: SCHED_FIFO（无权限时退回High）；Windows: THREAD_PRIORITY_TIME_CRITICAL
+    };
+
+    Priority priority = Priority::Inherit;
+    int realtimePriority = 50;      // SCHED_FIFO优先级（1-99，仅RealTime）
+    QList<int> cpus;                // 绑定的CPU编号，空 = 不绑定
+
+    /**
+     * @brief 从JSON解析：{"priority": "realtime", "rt_priority": 80, "cpus": [2, 3]}
+     */
+    static bool fromJson(const QJsonObject &json, ThreadPolicy &policy, QString *errorMessage = nullptr);
+    static QString priorityName(Priority priority);
+    QString describe() const;
+};
+
+/**
+ * @brief 线程放置结果与唤醒抖动（启动报告的一行）
+ */
+struct ThreadPlacementReport {
+    QString threadName;
+    QString requested;              // 请求的策略
+    QString priorityApplied;        // 实际生效的调度策略（含退回原因）
+    QString affinityApplied;        // 实际生效的CPU绑定
+    bool nameApplied = false;       // OS线程名是否设置成功（top -H / perf可见）
+    int probePeriodMs = 0;
+    LatencyHistogram wakeJitter;    // 定时器唤醒抖动（相邻两次触发间隔与周期之差的绝对值，微秒）
+
+    QString summary() const;
+};
+
+/**
+ * @brief 采集线程放置：在目标线程内调用，设置OS线程名、调度优先级和CPU绑定，并测量唤醒抖动
+ *
+ * UI大量重绘时振动线程10ms轮询节奏会抖动；实时调度/绑核让采集线程不被UI线程抢占。
+ * 所有设置都是尽力而为：权限不足或平台不支持时记录实际生效的结果，不影响采集。
+ */
+class ThreadPlacement
+{
+public:
+    static constexpr int OS_NAME_MAX_LENGTH = 15;   // Linux线程名上限（不含结尾0）
+
+    /**
+     * @brief 对当前线程应用策略（必须在目标线程内调用）
+     */
+    static ThreadPlacementReport applyToCurrentThread(const QString &name, const ThreadPolicy &policy);
+
+    /**
+     * @brief 在当前线程启动唤醒抖动探测（必须在目标线程内调用，不阻塞其事件循环）
+     *
+     * 用periodMs的精确定时器触发iterations次，测量的是事件循环中定时器的实际节奏。
+     * 完成后在当前线程调用done；定时器挂在parent下，探测未完成时随parent一起释放。
+     */
+    static void startWakeJitterProbe(const ThreadPlacementReport &report, int periodMs, int iterations,
+                                     QObject *parent, std::function<void(const ThreadPlacementReport &)> done);
+
+private:
+    static bool setCurrentThreadName(const QString &name);
+    static QString setCurrentThreadPriority(const ThreadPolicy &policy);
+    static QString setCurrentThreadAffinity(const QList<int> &cpus);
+};
+
+#endif // THREADPLACEMENT_H
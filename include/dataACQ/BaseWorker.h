@@ -9,14 +9,20 @@
 #include <QWaitCondition>
 #include <QElapsedTimer>
 #include "DataTypes.h"
+#include "SpscRing.h"
+#include "CreditGate.h"
+#include "SampleClock.h"
 
 /**
  * @brief 数据采集Worker基类
  * 
  * 所有采集Worker继承此类，提供统一接口：
  * - start/stop/pause生命周期管理
- * - 统一的dataBlockReady信号
+ * - 统一的dataBlockReady信号；设置UI环形队列后改为UI拉取 + blocksAvailable通知
  * - 统一的状态管理和错误处理
+ * - 采样时钟模型：硬件连续采样的Worker用sampleTimestampUs()为块打时间戳，
+ *   按样本计数估计真实采样时钟，消除"读回时刻≠采样时刻"的块长偏差
+ * - 信用额度反压：设置CreditGate后发布块需先取得额度，子类可按creditLevel()提前降级
  */
 class BaseWorker : public QObject
 {
@@ -32,6 +38,37 @@ public:
     // 获取当前轮次ID
     int currentRoundId() const { return m_currentRoundId; }
 
+    /**
+     * @brief 设置到DbWriter的无锁输出通道（须在start之前设置）
+     * @param ring 环形队列，nullptr表示不经过环形队列
+     */
+    void setOutputRing(DataBlockRing *ring) { m_outputRing = ring; }
+    DataBlockRing* outputRing() const { return m_outputRing; }
+
+    /**
+     * @brief 设置到UI的无锁输出通道（须在start之前设置）
+     *
+     * 设置后发布的块写入该环形队列而不再发射dataBlockReady，UI线程自行拉取；
+     * 只有UI请求过通知（已停止轮询）时才发射一次blocksAvailable。
+     * @param ring 环形队列，nullptr表示通过dataBlockReady发送
+     */
+    void setUiRing(DataBlockRing *ring) { m_uiRing = ring; }
+    DataBlockRing* uiRing() const { return m_uiRing; }
+
+    /**
+     * @brief publishBlock发出的跨线程信号数（每个排队信号分配一个事件和参数拷贝）
+     *
+     * 仅在Worker线程读取。设置UI环形队列后稳态下应保持不变。
+     */
+    qint64 publishSignalCount() const { return m_publishSignalCount; }
+
+    /**
+     * @brief 设置DbWriter授予的信用额度（须在start之前设置，不拥有）
+     * @param gate 信用额度，nullptr表示只受环形队列容量限制
+     */
+    void setCreditGate(CreditGate *gate) { m_creditGate = gate; }
+    CreditGate* creditGate() const { return m_creditGate; }
+
 public slots:
     /**
      * @brief 启动采集
@@ -79,6 +116,13 @@ signals:
      * @param block 数据块
      */
     void dataBlockReady(const DataBlock &block);
+
+    /**
+     * @brief UI环形队列有新数据（不携带数据，UI从uiRing()拉取）
+     *
+     * 只在UI通过requestNotify()请求后发射一次，UI轮询期间不发射。
+     */
+    void blocksAvailable();
     
     /**
      * @brief 状态变化信号
@@ -142,6 +186,48 @@ protected:
      */
     qint64 currentTimestampUs() const;
 
+    /**
+     * @brief 块内第一个样本的校正时间戳（在整块读回后立即调用）
+     *
+     * 以当前时刻作为块到达时刻输入采样时钟模型，返回按估计采样时钟反推的首样本时间。
+     * 块内第i个样本 = 返回值 + m_sampleClock.sampleOffsetUs(i)。
+     * @param numSamples 本块每通道样本数
+     */
+    qint64 sampleTimestampUs(int numSamples);
+
+    /**
+     * @brief 采样重新开始（样本序号归零）时重置时钟模型
+     */
+    void resetSampleClock();
+
+    /**
+     * @brief 输出并清空采样时钟的漂移/抖动统计（轮次切换、停止时调用）
+     */
+    void logClockStatistics(const char *reason);
+
+    /**
+     * @brief 记录硬件读取完成时刻（读回后立即调用），之后发布的块以此作为管线起点
+     *
+     * 回放/合成负载等不读硬件的Worker不调用，其块的管线起点为发布时刻。
+     */
+    void markHardwareRead() { m_hardwareReadUs = PipelineTrace::nowUs(); }
+
+    /**
+     * @brief 发布数据块：取得额度后写入DbWriter环形队列，并交给UI
+     *
+     * 交给UI：有UI环形队列时写入队列（必要时通知），否则发射dataBlockReady。
+     * 额度不足或环形队列满时块不进入DbWriter（UI仍然收到）。
+     * 发布时在块上记录管线阶段时刻（硬件读取完成/发布/入队），用于延迟分解。
+     */
+    void publishBlock(const DataBlock &block);
+
+    /**
+     * @brief 剩余写入额度比例（0~1）：信用额度与环形队列空闲槽位取较小者
+     *
+     * 降级后的小块占用额度少但仍占一个槽位，因此槽位也计入额度。
+     */
+    double creditLevel() const;
+
 protected:
     mutable QMutex m_mutex;         // 状态保护互斥锁
     WorkerState m_state;            // 当前状态
@@ -152,6 +238,14 @@ protected:
     qint64 m_timeBaseUs;            // Base timestamp in microseconds
     QElapsedTimer m_elapsedTimer;   // Monotonic timer since base
     bool m_hasTimeBase;             // Whether a base timestamp is set
+    DataBlockRing *m_outputRing;    // 到DbWriter的无锁通道（不拥有）
+    qint64 m_ringDropReported;      // 已报告的环形队列丢弃数
+    DataBlockRing *m_uiRing;        // 到UI的无锁通道（不拥有，可为nullptr）
+    qint64 m_publishSignalCount;    // publishBlock发出的跨线程信号数
+    CreditGate *m_creditGate;       // DbWriter授予的信用额度（不拥有，可为nullptr）
+    qint64 m_creditDeniedReported;  // 已报告的额度不足拒绝数
+    SampleClock m_sampleClock;      // 采样时钟模型（仅在Worker线程使用）
+    qint64 m_hardwareReadUs;        // 最近一次硬件读取完成时刻（管线时钟，0 = 未读取）
 
     // 掉线检测
     int m_consecutiveFails;         // 连续失败计数器
@@ -0,0 +1,89 @@
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <QtGlobal>
+
+/**
+ * @brief 池化缓冲区句柄
+ *
+ * 引用计数的轻量句柄（拷贝只增加计数，不分配内存），
+ * 最后一个引用释放时缓冲区自动归还到所属的BufferPool。
+ * DataBlock通过此句柄引用池化存储，DbWriter和UI用完后自动回收。
+ */
+class PooledBuffer
+{
+public:
+    PooledBuffer() : m_slot(nullptr) {}
+    PooledBuffer(const PooledBuffer &other);
+    PooledBuffer(PooledBuffer &&other) noexcept;
+    PooledBuffer &operator=(const PooledBuffer &other);
+    PooledBuffer &operator=(PooledBuffer &&other) noexcept;
+    ~PooledBuffer();
+
+    bool isNull() const { return m_slot == nullptr; }
+
+    char *data();
+    const char *constData() const;
+
+    // 已使用字节数 / 缓冲区容量
+    int size() const;
+    void setSize(int bytes);
+    int capacity() const;
+
+    template <typename T>
+    T *dataAs() { return reinterpret_cast<T*>(data()); }
+
+    template <typename T>
+    const T *constDataAs() const { return reinterpret_cast<const T*>(constData()); }
+
+private:
+    friend class BufferPool;
+    struct Slot;
+    explicit PooledBuffer(Slot *slot) : m_slot(slot) {}
+    void release();
+
+    Slot *m_slot;
+};
+
+/**
+ * @brief 可回收缓冲区池
+ *
+ * 由采集Worker持有，预热后采集路径不再进行堆分配：
+ * - acquire() 优先复用空闲缓冲区，容量不足时才分配（计入allocationCount）
+ * - 句柄全部释放后缓冲区回到空闲列表
+ * - 池销毁后仍在外部流转的缓冲区会在最后释放时直接删除
+ *
+ * 线程安全：acquire可在任意线程调用，归还可发生在任意线程（DbWriter/UI）。
+ */
+class BufferPool
+{
+public:
+    explicit BufferPool(int maxFreeBuffers = 256);
+    ~BufferPool();
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    /**
+     * @brief 获取至少bytes字节的缓冲区（size()已设置为bytes）
+     */
+    PooledBuffer acquire(int bytes);
+
+    /**
+     * @brief 预热：预先分配count个bytes大小的缓冲区
+     */
+    void reserve(int count, int bytes);
+
+    // 统计
+    qint64 allocationCount() const;     // 堆分配次数（新建槽位、新建或扩容存储）
+    qint64 acquireCount() const;        // 获取次数
+    int freeCount() const;              // 当前空闲缓冲区数
+    int outstandingCount() const;       // 当前在外流转的缓冲区数
+
+    struct State;
+
+private:
+    State *m_state;
+};
+
+#endif // BUFFERPOOL_H
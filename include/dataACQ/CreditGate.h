@@ -0,0 +1,89 @@
+#ifndef CREDITGATE_H
+#define CREDITGATE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include "dataACQ/DataTypes.h"
+
+/**
+ * @brief 写入方→生产者的信用额度（反压协议）
+ *
+ * 环形队列满时只能丢块；信用额度让生产者提前感知写入方的落后程度：
+ * - 生产者（Worker线程）发布块前 tryAcquire(costOf(block))，额度不足则不发布
+ * - 写入方（DbWriter线程）在块所在事务提交后 release() 归还额度
+ * - 生产者读取 level()（剩余额度比例）决定是否进入降级模式，在额度耗尽前主动减少数据量
+ *
+ * 额度单位按载荷字节折算（每块至少1个），使降级后的小块占用更少额度。
+ * 线程安全：一个生产者线程 + 一个写入方线程，全部操作为原子操作。
+ */
+class CreditGate
+{
+public:
+    static constexpr int BYTES_PER_CREDIT = 1024;   // 1个额度对应的载荷字节数
+
+    explicit CreditGate(int capacity)
+        : m_capacity(qMax(1, capacity))
+        , m_available(m_capacity)
+        , m_deniedCount(0)
+    {
+    }
+
+    CreditGate(const CreditGate &) = delete;
+    CreditGate &operator=(const CreditGate &) = delete;
+
+    /**
+     * @brief 块占用的额度：1 + 载荷字节数/BYTES_PER_CREDIT（标量按每值8字节计）
+     *
+     * 生产者和写入方对同一个块计算结果必须一致，因此只依赖块内容。
+     */
+    static int costOf(const DataBlock &block)
+    {
+        const qint64 bytes = static_cast<qint64>(block.payloadSize()) +
+                             static_cast<qint64>(block.values.size()) * static_cast<qint64>(sizeof(double));
+        return 1 + static_cast<int>(bytes / BYTES_PER_CREDIT);
+    }
+
+    /**
+     * @brief 申请额度（仅生产者线程调用）
+     * @return 额度不足返回false（不扣减，计入拒绝计数）
+     */
+    bool tryAcquire(int credits)
+    {
+        int available = m_available.load(std::memory_order_acquire);
+        while (available >= credits) {
+            if (m_available.compare_exchange_weak(available, available - credits,
+                                                  std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        m_deniedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * @brief 归还额度（写入方落盘后调用；生产者推送失败时也可退回），不超过容量
+     */
+    void release(int credits)
+    {
+        if (credits <= 0) {
+            return;
+        }
+        int available = m_available.load(std::memory_order_relaxed);
+        int next;
+        do {
+            next = qMin(m_capacity, available + credits);
+        } while (!m_available.compare_exchange_weak(available, next, std::memory_order_acq_rel));
+    }
+
+    int capacity() const { return m_capacity; }
+    int available() const { return m_available.load(std::memory_order_acquire); }
+    double level() const { return static_cast<double>(available()) / m_capacity; }   // 剩余额度比例 0~1
+    qint64 deniedCount() const { return m_deniedCount.load(std::memory_order_relaxed); }
+
+private:
+    const int m_capacity;
+    std::atomic<int> m_available;
+    std::atomic<qint64> m_deniedCount;
+};
+
+#endif // CREDITGATE_H
@@ -3,7 +3,11 @@
 
 #include <QString>
 #include <QVector>
+#include <QByteArray>
 #include <QMetaType>
+#include <QElapsedTimer>
+#include <limits>
+#include "dataACQ/BufferPool.h"
 
 /**
  * @brief 传感器类型枚举
@@ -19,16 +23,47 @@ enum class SensorType {
     Vibration_X = 200,      // X轴振动
     Vibration_Y = 201,      // Y轴振动
     Vibration_Z = 202,      // Z轴振动
+    Vibration_Packed = 210, // 三通道打包振动（SoA载荷：X|Y|Z依次连续，共享时间戳）
+    Vibration_Summary = 211, // 振动统计摘要（反压降级时替代波形，布局见VibrationSummary）
     
     // 电机参数（可配置频率）
     Motor_Position = 300,   // 电机位置
     Motor_Speed = 301,      // 电机速度
     Motor_Torque = 302,     // 电机扭矩
     Motor_Current = 303,    // 电机电流
+    Motor_Snapshot = 310,   // 电机快照（一个tick内全部电机×参数，布局见MotorSnapshot）
     
     Unknown = 999           // 未知类型
 };
 
+/**
+ * @brief 电机快照块布局
+ *
+ * values[param * channelCount + motorId]，channelCount = 最大电机ID + 1，
+ * 参数顺序为位置/速度/扭矩/电流，未采集或读取失败的槽位为NaN。
+ */
+namespace MotorSnapshot {
+enum Param { Position = 0, Speed, Torque, Current, ParamCount };
+
+inline SensorType paramSensorType(int param) {
+    static const SensorType types[ParamCount] = {
+        SensorType::Motor_Position, SensorType::Motor_Speed,
+        SensorType::Motor_Torque, SensorType::Motor_Current
+    };
+    return (param >= 0 && param < ParamCount) ? types[param] : SensorType::Unknown;
+}
+} // namespace MotorSnapshot
+
+/**
+ * @brief 振动摘要块布局
+ *
+ * values[ch * StatCount + stat]，channelCount为通道数，numSamples为统计区间内每通道样本数，
+ * startTimestampUs为区间首样本时刻。写入scalar_samples时channel_id = ch * StatCount + stat。
+ */
+namespace VibrationSummary {
+enum Stat { Min = 0, Max, Rms, Mean, StatCount };
+} // namespace VibrationSummary
+
 /**
  * @brief Worker工作状态
  */
@@ -42,6 +77,45 @@ enum class WorkerState {
     Error           // 错误状态
 };
 
+/**
+ * @brief 数据块经过管线各阶段的时刻（进程内单调时钟，微秒；0 = 尚未经过该阶段）
+ *
+ * 用于把端到端延迟拆分为采集处理 / 排队 / SQLite提交 / UI渲染，只在内存中随块传递，不落盘。
+ */
+struct PipelineTrace {
+    enum Stage {
+        HardwareRead = 0,   // 硬件读取完成（Worker）
+        Emitted,            // Worker发布
+        Enqueued,           // 进入DbWriter队列（环形队列或信号队列）
+        Dequeued,           // DbWriter取出
+        Committed,          // 所在事务提交
+        Rendered,           // UI首次渲染
+        StageCount
+    };
+
+    qint64 stageUs[StageCount] = {};
+
+    void mark(Stage stage) { stageUs[stage] = nowUs(); }
+    void mark(Stage stage, qint64 timeUs) { stageUs[stage] = timeUs; }
+    qint64 at(Stage stage) const { return stageUs[stage]; }
+    bool has(Stage stage) const { return stageUs[stage] != 0; }
+
+    /**
+     * @brief 两个阶段之间的耗时（任一阶段未记录时返回-1）
+     */
+    qint64 elapsedUs(Stage from, Stage to) const {
+        return (has(from) && has(to)) ? stageUs[to] - stageUs[from] : -1;
+    }
+
+    /**
+     * @brief 管线时钟：进程内所有线程共用的单调时钟（微秒，从首次调用起算，恒大于0）
+     */
+    static qint64 nowUs() {
+        static const QElapsedTimer clock = [] { QElapsedTimer timer; timer.start(); return timer; }();
+        return clock.nsecsElapsed() / 1000 + 1;
+    }
+};
+
 /**
  * @brief 统一数据块结构
  * 
@@ -53,14 +127,20 @@ struct DataBlock {
     int channelId;                  // 通道ID（电机号、振动通道等）
     qint64 startTimestampUs;        // 起始时间戳（微秒）
     double sampleRate;              // 采样频率（Hz）
-    int numSamples;                 // 样本数量
+    int numSamples;                 // 样本数量（打包块为每通道样本数）
+    int channelCount;               // 载荷通道数（打包块 > 1，其余为1）
+    float quantStep;                // 振动样本量化步长（ADC 1 LSB换算到输出单位），0 = 未知
+    int decimation;                 // 振动包络抽取因子：1 = 原始波形，>1 = 每decimation个原样本一对(min, max)
     
-    // 数据内容（两种方式二选一）
+    // 数据内容（三种方式选其一）
     QVector<double> values;         // 标量数据（用于10Hz低频数据）
     QByteArray blobData;            // BLOB数据（用于5000Hz高频振动）
+    PooledBuffer pooledData;        // 池化BLOB数据（振动采集复用缓冲路径，优先于blobData）
     
     // 可选的额外信息
     QString comment;                // 备注信息
+
+    PipelineTrace trace;            // 管线阶段时刻（延迟统计用）
     
     DataBlock() 
         : roundId(0)
@@ -69,9 +149,60 @@ struct DataBlock {
         , startTimestampUs(0)
         , sampleRate(0.0)
         , numSamples(0)
+        , channelCount(1)
+        , quantStep(0.0f)
+        , decimation(1)
     {}
+
+    // 振动打包块（SoA）；电机快照的channelCount是槽位数，不算打包
+    bool isPacked() const { return sensorType == SensorType::Vibration_Packed; }
+
+    /**
+     * @brief 电机快照块中某电机某参数的值（无效时返回NaN）
+     */
+    double snapshotValue(int param, int motorId) const {
+        const int index = param * channelCount + motorId;
+        if (motorId < 0 || motorId >= channelCount || index < 0 || index >= values.size()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        return values[index];
+    }
+
+    /**
+     * @brief 打包块第ch个通道的float数据（SoA布局，每通道numSamples个）
+     */
+    const float *channelData(int ch) const {
+        return reinterpret_cast<const float*>(payloadData()) + static_cast<qint64>(ch) * numSamples;
+    }
+
+    /**
+     * @brief BLOB载荷访问（兼容池化存储和QByteArray）
+     */
+    const char *payloadData() const {
+        return pooledData.isNull() ? blobData.constData() : pooledData.constData();
+    }
+
+    int payloadSize() const {
+        return pooledData.isNull() ? static_cast<int>(blobData.size()) : pooledData.size();
+    }
+
+    /**
+     * @brief 以QByteArray形式访问载荷（池化存储时不拷贝，调用方需保证block存活）
+     */
+    QByteArray payloadBytes() const {
+        return pooledData.isNull() ? blobData
+                                   : QByteArray::fromRawData(pooledData.constData(), pooledData.size());
+    }
 };
 
+/**
+ * @brief 辅助函数：是否为振动数据（单通道或打包块）
+ */
+inline bool isVibrationType(SensorType type) {
+    return (type >= SensorType::Vibration_X && type <= SensorType::Vibration_Z) ||
+           type == SensorType::Vibration_Packed;
+}
+
 // 注册到Qt元类型系统，使其可以在信号槽中传递
 Q_DECLARE_METATYPE(DataBlock)
 Q_DECLARE_METATYPE(SensorType)
@@ -89,10 +220,13 @@ inline QString sensorTypeToString(SensorType type) {
         case SensorType::Vibration_X: return "Vibration_X";
         case SensorType::Vibration_Y: return "Vibration_Y";
         case SensorType::Vibration_Z: return "Vibration_Z";
+        case SensorType::Vibration_Packed: return "Vibration_Packed";
+        case SensorType::Vibration_Summary: return "Vibration_Summary";
         case SensorType::Motor_Position: return "Motor_Position";
         case SensorType::Motor_Speed: return "Motor_Speed";
         case SensorType::Motor_Torque: return "Motor_Torque";
         case SensorType::Motor_Current: return "Motor_Current";
+        case SensorType::Motor_Snapshot: return "Motor_Snapshot";
         default: return "Unknown";
     }
 }
@@ -0,0 +1,59 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 延迟直方图（对数分桶，微秒）
+ *
+ * 每个2的幂区间再细分4个子桶，相对误差约25%，覆盖1us ~ 数小时。
+ * 记录为O(1)且不分配内存，适合在采集路径上统计往返/处理延迟。
+ *
+ * 线程安全：非线程安全，由单一线程记录和读取。
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    /**
+     * @brief 记录一个延迟样本（微秒，负值按0处理）
+     */
+    void record(qint64 latencyUs);
+
+    void reset();
+
+    qint64 count() const { return m_count; }
+    qint64 minUs() const { return m_count > 0 ? m_min : 0; }
+    qint64 maxUs() const { return m_max; }
+    double meanUs() const { return m_count > 0 ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+    /**
+     * @brief 百分位数估计（返回所在桶的上界，限制在实际最小/最大值之间）
+     * @param percentile 0 ~ 100
+     */
+    qint64 percentileUs(double percentile) const;
+
+    /**
+     * @brief 单行摘要：n/min/p50/p95/p99/max（毫秒）
+     */
+    QString summary() const;
+
+private:
+    static int bucketIndex(quint64 value);
+    static quint64 bucketUpperBound(int index);
+
+    static constexpr int SUB_BUCKET_BITS = 2;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKET_COUNT = 64 * SUB_BUCKETS;
+
+    QVector<qint64> m_buckets;
+    qint64 m_count;
+    qint64 m_sum;
+    qint64 m_min;
+    qint64 m_max;
+};
+
+#endif // LATENCYHISTOGRAM_H
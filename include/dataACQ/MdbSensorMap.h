@@ -0,0 +1,90 @@
+#ifndef MDBSENSORMAP_H
+#define MDBSENSORMAP_H
+
+#include <QString>
+#include <QVector>
+#include <QJsonObject>
+#include "dataACQ/DataTypes.h"
+
+/**
+ * @brief 单个MDB传感器的声明式定义
+ *
+ * 物理值 = decode(寄存器) [负值加negativeWrap] * scale + offset
+ */
+struct MdbSensorDef {
+    enum class Decode {
+        Int32TwosComplement,    // concatenateShortsToLong：32位补码（拉力传感器）
+        Int32                   // shortsToLong：两个短字拼接（扭矩、位置传感器）
+    };
+
+    QString name;                   // 显示名称（日志/事件）
+    SensorType sensorType = SensorType::Unknown;
+    int channelId = 0;              // 同类型多个传感器时区分通道
+    int deviceIndex = 0;            // 设备索引（IP = 基础地址末位 + deviceIndex）
+    int unitId = 1;                 // Modbus单元ID
+    int registerAddr = 0;           // 起始保持寄存器地址
+    int numRegisters = 2;           // 寄存器个数（当前解码方式均为2）
+    Decode decode = Decode::Int32;
+    bool highWordFirst = true;      // 寄存器顺序：高字在前（现有设备均为高字在前）
+    double negativeWrap = 0.0;      // 原始值为负时加上该值（位置传感器：2*32767）
+    double scale = 1.0;
+    double offset = 0.0;
+
+    static bool fromJson(const QJsonObject &json, MdbSensorDef &def, QString *errorMessage);
+};
+
+/**
+ * @brief 合并后的一次Modbus读取（同一设备/单元ID的连续寄存器）
+ */
+struct MdbReadGroup {
+    int deviceIndex = 0;
+    int unitId = 1;
+    int startRegister = 0;
+    int numRegisters = 0;
+    QVector<int> sensorIndexes;     // 本次读取覆盖的传感器（MdbSensorMap::sensors()下标）
+};
+
+/**
+ * @brief MDB传感器映射（从config/mdb_sensors.json加载）
+ *
+ * 将同一设备、同一单元ID上地址连续（间隙不超过maxRegisterGap）的寄存器
+ * 合并为一次读取，例如上/下压力（450、452）合并为一次4寄存器请求。
+ * 新增传感器只需修改配置文件，无需改代码。
+ */
+class MdbSensorMap
+{
+public:
+    static constexpr int MAX_DEVICES = 4;               // MdbWorker固定4个网关
+    static constexpr int MAX_REGISTERS_PER_READ = 125;  // Modbus单次读保持寄存器上限
+
+    MdbSensorMap();
+
+    /**
+     * @brief 内置默认映射（与原硬编码的4个传感器一致，配置文件缺失时使用）
+     */
+    static MdbSensorMap defaultMap();
+
+    /**
+     * @brief 在常用位置查找配置文件，找不到返回空字符串
+     */
+    static QString locateConfigFile();
+
+    bool loadFromFile(const QString &filePath, QString *errorMessage = nullptr);
+    bool loadFromJson(const QJsonObject &root, QString *errorMessage = nullptr);
+
+    const QVector<MdbSensorDef> &sensors() const { return m_sensors; }
+    const QVector<MdbReadGroup> &readGroups() const { return m_readGroups; }
+    int maxRegisterGap() const { return m_maxRegisterGap; }
+    QString sourcePath() const { return m_sourcePath; }
+    bool isEmpty() const { return m_sensors.isEmpty(); }
+
+private:
+    void buildReadGroups();
+
+    QVector<MdbSensorDef> m_sensors;
+    QVector<MdbReadGroup> m_readGroups;
+    int m_maxRegisterGap;           // 允许合并的寄存器间隙（间隙内的寄存器一并读取后丢弃）
+    QString m_sourcePath;           // 配置来源（内置默认为空）
+};
+
+#endif // MDBSENSORMAP_H
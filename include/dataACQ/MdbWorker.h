@@ -2,7 +2,12 @@
 #define MDBWORKER_H
 
 #include "dataACQ/BaseWorker.h"
+#include "dataACQ/LatencyHistogram.h"
+#include "dataACQ/MdbSensorMap.h"
+#include <QHash>
 #include <QTimer>
+#include <QPointer>
+#include <QElapsedTimer>
 #include <QTcpSocket>
 #include <QModbusTcpClient>
 #include <QModbusDataUnit>
@@ -12,24 +17,26 @@
  * @brief MDB传感器采集Worker (Modbus TCP)
  *
  * 硬件：4个独立的Modbus TCP设备
- * 设备映射：
+ * 设备/寄存器映射由config/mdb_sensors.json声明（缺失时使用内置默认映射）：
  *   - 设备1 (192.168.1.200): 保留
  *   - 设备2 (192.168.1.201): 位置传感器，寄存器0x00，设备ID=2
  *   - 设备3 (192.168.1.202): 扭矩传感器，寄存器0x00，设备ID=1
- *   - 设备4 (192.168.1.203): 上下压力传感器，寄存器450/452，设备ID=1
- * 传感器类型：
+ *   - 设备4 (192.168.1.203): 上下压力传感器，寄存器450/452，设备ID=1（合并为一次读取）
+ * 传感器类型（默认映射）：
  *   - 上拉力传感器 (Force_Upper)
  *   - 下拉力传感器 (Force_Lower)
  *   - 扭矩传感器 (Torque_MDB)
  *   - 位置传感器 (Position_MDB)
- * 默认采样频率：10Hz（可配置）
+ * 默认采样频率：10Hz（可配置，异步轮询可稳定运行于50-100Hz）
  * 数据格式：低频标量数据
  *
  * 功能：
  * 1. 连接4个独立的Modbus TCP设备
- * 2. 定时读取传感器数据（10Hz）
+ * 2. 定时读取传感器数据：连续寄存器合并为一次请求，每个tick同时发出全部请求，
+ *    在同一截止时间内异步收集应答，慢速/离线设备只影响自身样本
  * 3. 处理零点校准
  * 4. 打包成DataBlock发送
+ * 5. 统计每个读取请求的往返延迟直方图
  */
 class MdbWorker : public BaseWorker
 {
@@ -43,11 +50,20 @@ public:
     void setServerAddress(const QString &address) { m_serverAddress = address; }
     void setServerPort(int port) { m_serverPort = port; }
     
+    /**
+     * @brief 传感器映射文件路径（为空时在常用位置查找config/mdb_sensors.json）
+     *
+     * 映射在每次initializeHardware时重新加载，修改配置后重新开始采集即可生效。
+     */
+    void setSensorMapPath(const QString &path) { m_sensorMapPath = path; }
+    const MdbSensorMap &sensorMap() const { return m_sensorMap; }
+
     // 零点校准
-    void setForceUpperZero(double zero) { m_forceUpperZero = zero; }
-    void setForceLowerZero(double zero) { m_forceLowerZero = zero; }
-    void setTorqueZero(double zero) { m_torqueZero = zero; }
-    void setPositionZero(double zero) { m_positionZero = zero; }
+    void setSensorZero(SensorType type, double zero, int channelId = 0) { m_zeroOffsets[sensorKey(type, channelId)] = zero; }
+    void setForceUpperZero(double zero) { setSensorZero(SensorType::Force_Upper, zero); }
+    void setForceLowerZero(double zero) { setSensorZero(SensorType::Force_Lower, zero); }
+    void setTorqueZero(double zero) { setSensorZero(SensorType::Torque_MDB, zero); }
+    void setPositionZero(double zero) { setSensorZero(SensorType::Position_MDB, zero); }
     
     // 测试连接（不启动采集）
     Q_INVOKABLE bool testConnection();
@@ -56,6 +72,11 @@ public:
     // 手动断开连接
     void disconnect();
 
+    /**
+     * @brief 各读取请求往返延迟摘要（多行文本）
+     */
+    Q_INVOKABLE QString latencySummary() const;  // 需在Worker线程调用
+
 public slots:
     void performZeroCalibration();  // 执行零点校准
 
@@ -66,13 +87,26 @@ protected:
     void runAcquisition() override;
 
 private slots:
-    void readSensors();  // 定时读取传感器
+    void readSensors();  // 定时读取传感器（发出本tick的全部请求）
+    void finalizeTick(); // tick截止：未应答的请求所覆盖的传感器记为失败
 
 private:
     bool connectToServer();
     void disconnectFromServer();
     bool readFromDevice(int deviceIndex, int deviceId, int registerAddr, int numRegisters, QVector<quint16> &values);
-    void sendDataBlock(SensorType type, double value);
+    void sendDataBlock(SensorType type, int channelId, double value, qint64 timestampUs);
+
+    // 传感器映射
+    void reloadSensorMap();
+    void resetPollingState();
+    static int sensorKey(SensorType type, int channelId) { return static_cast<int>(type) * 100 + channelId; }
+
+    // 异步轮询（按合并后的读取组）
+    bool issueGroupRead(int groupIndex);
+    void onGroupReadFinished(int groupIndex, quint64 tickId);
+    int completeGroup(int groupIndex, const QVector<quint16> &registers);  // 返回成功解码的传感器数
+    bool decodeSensorValue(int sensorIndex, const QVector<quint16> &registers, int offset, double &physical);
+    void applySensorValue(int sensorIndex, double physical, qint64 timestampUs);
 
     // 数据解析辅助函数
     int64_t concatenateShortsToLong(int16_t lower, int16_t upper);
@@ -88,24 +122,35 @@ private:
     QModbusTcpClient *m_modbusDevices[4];  // 4个Modbus TCP设备
     QTimer *m_readTimer;                    // 读取定时器
     
-    // 零点校准值
-    double m_forceUpperZero;
-    double m_forceLowerZero;
-    double m_torqueZero;
-    double m_positionZero;
-    
-    // 最新读数（用于显示）
-    double m_lastForceUpper;
-    double m_lastForceLower;
-    double m_lastTorque;
-    double m_lastPosition;
+    // 传感器映射
+    MdbSensorMap m_sensorMap;
+    QString m_sensorMapPath;
+
+    // 零点校准值（key: sensorKey(类型, 通道)）
+    QHash<int, double> m_zeroOffsets;
 
     bool m_isConnected;
     qint64 m_sampleCount;       // 样本计数
 
-    // 单个传感器掉线检测
-    int m_sensorFailCount[4];       // 每个传感器的连续失败次数
-    bool m_sensorDisconnected[4];   // 每个传感器是否已报告掉线
+    // 异步轮询状态（每个读取组最多一个在途请求，下标与m_sensorMap.readGroups()一致）
+    struct PendingRead {
+        QPointer<QModbusReply> reply;
+        qint64 sentNs = 0;              // 发出时刻（m_latencyClock）
+    };
+    QVector<PendingRead> m_pending;
+    QVector<bool> m_tickDone;           // 本tick已完成（成功或失败）
+    bool m_tickOpen;                    // 当前tick尚未截止
+    quint64 m_tickId;
+    qint64 m_tickTimestampUs;           // 本tick样本时间戳（全部传感器共用）
+    int m_tickSuccessCount;             // 本tick成功的传感器数
+    QTimer *m_deadlineTimer;            // 单次定时器：tick截止
+    QElapsedTimer m_latencyClock;
+    QVector<LatencyHistogram> m_latency;
+    qint64 m_lateReplies;               // 截止后才到达的应答数
+
+    // 单个传感器掉线检测（下标与m_sensorMap.sensors()一致）
+    QVector<int> m_sensorFailCount;     // 每个传感器的连续失败次数
+    QVector<bool> m_sensorDisconnected; // 每个传感器是否已报告掉线
     static const int SENSOR_DISCONNECT_THRESHOLD = 30;  // 连续30次失败（3秒@10Hz）认为掉线
 };
 
@@ -2,8 +2,10 @@
 #define MOTORWORKER_H
 
 #include "dataACQ/BaseWorker.h"
+#include "dataACQ/LatencyHistogram.h"
 #include <QTimer>
 #include <QVector>
+#include <QElapsedTimer>
 
 /**
  * @brief ZMotion电机参数采集Worker
@@ -19,9 +21,12 @@
  *
  * 功能：
  * 1. 使用全局 g_handle 读取电机参数（只读，不负责连接）
- * 2. 定时读取电机参数
+ * 2. 定时读取电机参数：默认批量模式，每个参数一次ZAux_Direct_GetAllAxisPara
+ *    读取全部轴，整个tick只持有一次g_mutex（逐轴模式为 电机数×参数数 次往返和加锁）
  * 3. 支持多电机同时采集
- * 4. 打包成DataBlock发送
+ * 4. 每个tick打包成一个电机快照DataBlock（Motor_Snapshot，全部电机×参数）发送
+ * 5. 控制器端高速采集：SCOPE按伺服周期把MPOS/DAC写入TABLE，结束后用
+ *    ZAux_Direct_GetTable分段读回，发送带采样率的多样本DataBlock（可达1kHz）
  *
  * 注意：
  * - 此类只负责数据采集（只读），不负责连接管理
@@ -33,6 +38,41 @@ class MotorWorker : public BaseWorker
     Q_OBJECT
 
 public:
+    /**
+     * @brief 参数读取方式
+     */
+    enum class ReadMode {
+        PerAxis,    // 逐轴逐参数读取（每次调用单独加锁）
+        Batched     // 多轴批量读取（一次加锁）
+    };
+
+#ifdef DRILLCONTROL_BENCH
+    /**
+     * @brief 单一读取方式的基准结果
+     */
+    struct BenchmarkResult {
+        ReadMode mode;
+        int ticks;                  // 成功的tick数
+        int failures;               // 失败的tick数
+        int transactionsPerTick;    // 每tick的ZAux调用次数
+        double meanTickUs;          // 平均每tick耗时（含加锁）
+        qint64 p99TickUs;
+        double maxSampleRateHz;     // 可达采样率上限（1e6 / 平均耗时）
+    };
+#endif
+
+    /**
+     * @brief 控制器端高速采集配置（SCOPE → TABLE）
+     */
+    struct CaptureConfig {
+        QVector<int> motorIds;          // 采集的电机（为空时使用采集电机列表）
+        bool position = true;           // MPOS
+        bool current = true;            // DAC
+        int servoCyclesPerSample = 1;   // 采样间隔（伺服周期数，1ms伺服周期时1 = 1kHz）
+        int tableStart = 10000;         // 使用的TABLE起始编号（避开BASIC程序常用区）
+        int durationMs = 1000;          // 单次采集时长
+    };
+
     explicit MotorWorker(QObject *parent = nullptr);
     ~MotorWorker();
 
@@ -40,17 +80,47 @@ public:
     void setControllerAddress(const QString &address) { m_controllerAddress = address; }
     void setMotorIds(const QVector<int> &ids) { m_motorIds = ids; }
     void setReadParameters(bool pos, bool speed, bool torque, bool current);
+    void setReadMode(ReadMode mode) { m_readMode = mode; m_batchUnsupported = false; }
+    ReadMode readMode() const { return m_readMode; }
+    void setCaptureConfig(const CaptureConfig &config) { m_captureConfig = config; }
+    bool isCapturing() const { return m_captureActive; }
 
     // 检查全局句柄是否已连接
     bool isConnected() const;
 
+    static const char* readModeName(ReadMode mode);
+
+#ifdef DRILLCONTROL_BENCH
+    /**
+     * @brief 基准测试：分别以逐轴/批量方式连续读取，测量每tick耗时和可达采样率
+     *
+     * 需要全局 g_handle 已连接；在调用线程中同步执行，不启动采集。
+     */
+    static QVector<BenchmarkResult> runBenchmark(const QVector<int> &motorIds, int ticksPerMode = 200);
+
+    /**
+     * @brief 连接控制器并运行基准测试，结果输出到日志（命令行 --bench-motor）
+     */
+    static void logBenchmark(const QString &controllerAddress);
+#endif
+
 public slots:
     void readMotorParameters();  // 读取电机参数
 
+    /**
+     * @brief 启动一次控制器端高速采集（配置SCOPE并TRIGGER），需在Worker线程调用
+     * @return 采集是否已启动
+     */
+    bool startCapture();
+    void stopCapture();          // 中止采集（已采集的数据丢弃）
+
 signals:
     // 连接状态改变（由外部连接管理器触发）
     void connectionStateChanged(bool connected);
 
+    // 高速采集结束（samplesPerChannel为每通道读回的样本数）
+    void captureFinished(bool success, int samplesPerChannel);
+
 protected:
     // 实现BaseWorker抽象方法
     bool initializeHardware() override;
@@ -58,11 +128,34 @@ protected:
     void runAcquisition() override;
 
 private:
+    // 参数下标与MotorSnapshot::Param一致
+    enum Param {
+        ParamPosition = MotorSnapshot::Position,
+        ParamSpeed = MotorSnapshot::Speed,
+        ParamTorque = MotorSnapshot::Torque,
+        ParamCurrent = MotorSnapshot::Current,
+        ParamCount = MotorSnapshot::ParamCount
+    };
+
+    // 一个tick读取到的全部参数（下标与m_motorIds一致）
+    bool readTelemetry(ReadMode mode);
+    bool readTelemetryPerAxis();
+    bool readTelemetryBatched();
+    void prepareTelemetryBuffers();
+    bool isParamEnabled(int param) const;
+    int transactionsPerTick(ReadMode mode) const;
+
+    // 高速采集
+    void pollCapture();
+    void finishCapture(int samplesPerChannel);
+    bool queryControllerValue(const char *expression, double &value);  // 调用方需持有g_mutex
+    bool executeCommand(const QString &command);                       // 调用方需持有g_mutex
+
     bool readMotorPosition(int motorId, double &position);
     bool readMotorSpeed(int motorId, double &speed);
     bool readMotorTorque(int motorId, double &torque);
     bool readMotorCurrent(int motorId, double &current);
-    void sendDataBlock(int motorId, SensorType type, double value);
+    int sendSnapshotBlock();     // 发送本tick的电机快照块，返回有效值个数
 
 private:
     QString m_controllerAddress;    // 控制器地址（仅用于日志）
@@ -75,6 +168,29 @@ private:
     bool m_readTorque;
     bool m_readCurrent;
 
+    ReadMode m_readMode;
+    bool m_batchUnsupported;        // 控制器不支持批量读取时回退到逐轴模式
+
+    // 本tick读数（预分配，采集路径不分配内存）
+    QVector<double> m_values[ParamCount];
+    QVector<bool> m_valid[ParamCount];
+    QVector<float> m_axisBuffer;    // 批量读取缓冲（按实际轴号索引）
+    qint64 m_tickTimestampUs;
+    LatencyHistogram m_tickLatency; // 每tick读取耗时（含等待g_mutex）
+
+    // 高速采集状态
+    static const int MAX_SCOPE_CHANNELS = 16;  // SCOPE单次最多记录的参数个数
+    static const int TABLE_READ_CHUNK = 250;   // 每次GetTable读取的数量（分段加锁，不阻塞控制命令）
+    CaptureConfig m_captureConfig;
+    QTimer *m_captureTimer;         // 轮询SCOPE_POS
+    bool m_captureActive;
+    QVector<int> m_captureMotors;   // 每个SCOPE通道对应的电机ID（顺序：电机 × [MPOS, DAC]）
+    QVector<SensorType> m_captureTypes;  // 每个SCOPE通道对应的数据类型
+    int m_captureDepth;             // 每通道样本数
+    double m_captureSampleRate;     // Hz
+    qint64 m_captureStartUs;        // 第一个样本的时间戳
+    QElapsedTimer m_captureClock;
+
     qint64 m_sampleCount;           // 样本计数
 };
 
@@ -0,0 +1,72 @@
+#ifndef PIPELINELATENCY_H
+#define PIPELINELATENCY_H
+
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "dataACQ/DataTypes.h"
+#include "dataACQ/LatencyHistogram.h"
+
+/**
+ * @brief 管线分段延迟统计（按传感器类型 × 分段的延迟直方图）
+ *
+ * 由DataBlock::trace的阶段时刻计算：
+ * - Acquire：硬件读取完成 → Worker发布（解交织/标定/降级等处理）
+ * - Queue：进入DbWriter队列 → 被取出（排队等待）
+ * - Commit：取出 → 所在事务提交（SQLite写入）
+ * - Storage：硬件读取完成 → 提交（端到端落盘）
+ * - Render：Worker发布 → UI首次渲染（GUI线程排队 + 重绘）
+ *
+ * 线程安全：DbWriter线程记录落盘分段，GUI线程记录渲染分段，内部加锁（每批/每次渲染一次）。
+ */
+class PipelineLatency
+{
+public:
+    enum Segment { Acquire = 0, Queue, Commit, Storage, Render, SegmentCount };
+
+    struct Row {
+        SensorType sensorType;
+        Segment segment;
+        qint64 count;
+        qint64 p50Us;
+        qint64 p99Us;
+        qint64 maxUs;
+        double meanUs;
+    };
+
+    static QString segmentName(Segment segment);
+
+    /**
+     * @brief 记录一批已提交的块（DbWriter在事务提交并标记Committed后调用）
+     */
+    void recordCommitted(const QVector<DataBlock> &blocks);
+
+    /**
+     * @brief 记录UI渲染完成（页面处理完dataBlockReady并重绘后调用）
+     */
+    void recordRendered(const DataBlock &block);
+
+    QVector<Row> snapshot() const;
+
+    /**
+     * @brief 单行摘要（状态栏）：每种传感器类型的排队/提交/渲染p99和端到端p50/p99/max
+     */
+    QString summary() const;
+
+    /**
+     * @brief 多行报告（日志）：每种传感器类型每个分段一行
+     */
+    QStringList report() const;
+
+    void reset();
+
+private:
+    void recordLocked(SensorType type, Segment segment, qint64 latencyUs);
+
+    mutable QMutex m_mutex;
+    QMap<SensorType, QVector<LatencyHistogram>> m_histograms;   // 每种类型SegmentCount个直方图
+};
+
+#endif // PIPELINELATENCY_H
@@ -0,0 +1,112 @@
+#ifndef REPLAYWORKER_H
+#define REPLAYWORKER_H
+
+#include "dataACQ/BaseWorker.h"
+#include <QList>
+#include <QVector>
+
+class DataQuerier;
+
+/**
+ * @brief 回放Worker：把数据库中已记录的轮次按原始或加速节奏重新发布
+ *
+ * 用于在没有钻机和模拟器的情况下压测DbWriter、UI页面和AutoDrillManager，
+ * 以及复现现场问题。每个实例回放一路数据流（每张振动卡/MDB/电机），由AcquisitionManager
+ * 替换对应的硬件Worker：写入同一组环形队列（DbWriter/UI），dataBlockReady和blocksAvailable
+ * 转发到硬件Worker的信号，下游消费者无需修改。
+ *
+ * 回放格式与实时采集一致：
+ * - 振动：Vibration_Packed打包块，按块时长（默认100ms）切分
+ * - MDB：每传感器每次采样一个标量块
+ * - 电机：同一时刻的各电机参数重新组装为Motor_Snapshot块
+ *
+ * 时间戳：保持原始相对时间，平移到当前时间基（新轮次中的数据与原轮次逐点对应）；
+ * 倍速只改变发布节奏，不压缩时间戳。数据按1秒窗口分批读取，内存占用与轮次长度无关。
+ * 写入方跟不上时回放等待写入额度（不丢块），"尽快"模式下的实际倍速即管线吞吐上限。
+ */
+class ReplayWorker : public BaseWorker
+{
+    Q_OBJECT
+
+public:
+    enum class Stream {
+        Vibration,
+        Mdb,
+        Motor
+    };
+
+    explicit ReplayWorker(Stream stream, QObject *parent = nullptr);
+    ~ReplayWorker();
+
+    /**
+     * @brief 设置回放源（须在start之前设置）
+     * @param dbPath 数据库路径
+     * @param roundId 要回放的轮次ID
+     */
+    void setSource(const QString &dbPath, int roundId);
+
+    /**
+     * @brief 设置回放倍速：1 = 原始节奏，10 = 10倍速，0 = 尽快（吞吐基准）
+     */
+    void setSpeed(double speed) { m_speed = qMax(0.0, speed); }
+    double speed() const { return m_speed; }
+
+    /**
+     * @brief 振动回放块时长（毫秒），默认100ms（与流式采集一致）
+     */
+    void setBlockDurationMs(int ms) { m_blockDurationMs = qMax(1, ms); }
+
+    /**
+     * @brief 振动回放的全局通道范围（多卡轮次按卡回放：firstChannel = 卡序号 × 3），默认0~2
+     */
+    void setVibrationChannels(int firstChannel, int channelCount);
+
+    Stream stream() const { return m_stream; }
+    static QString streamName(Stream stream);
+
+signals:
+    /**
+     * @brief 回放结束（到达轮次末尾）
+     * @param blocks 已发布的块数
+     * @param achievedSpeed 实际倍速（原始时长 / 回放耗时）
+     */
+    void replayFinished(qint64 blocks, double achievedSpeed);
+
+protected:
+    bool initializeHardware() override;
+    void shutdownHardware() override;
+    void runAcquisition() override;
+
+private:
+    bool loadNextWindow();
+    void loadVibrationWindow(qint64 windowStartUs);
+    void loadScalarWindow(qint64 windowStartUs);
+    bool waitUntil(qint64 sourceTimestampUs);
+    void finishReplay();
+
+private:
+    static constexpr double MIN_CREDIT_LEVEL = 0.1;    // 剩余写入额度低于该比例时暂停发布
+
+    Stream m_stream;
+    QString m_dbPath;
+    int m_sourceRoundId;
+    double m_speed;
+    int m_blockDurationMs;
+    int m_firstChannel;             // 振动回放的首个全局通道
+    int m_channelCount;             // 振动回放的通道数
+
+    DataQuerier *m_querier;         // 在Worker线程中创建（连接名按线程区分）
+    QList<qint64> m_windows;        // 源轮次的窗口起始时间
+    int m_nextWindow;               // 下一个待读取的窗口
+    QVector<DataBlock> m_pending;   // 当前窗口的待发布块（源时间戳）
+    int m_pendingIndex;
+
+    qint64 m_sourceOriginUs;        // 源轮次时间零点（轮次开始时刻）
+    qint64 m_replayOriginUs;        // 回放开始时的当前时间戳
+    QElapsedTimer m_wallTimer;      // 回放节奏计时
+    qint64 m_lastSourceUs;          // 最后发布块的源时间戳
+    qint64 m_blocksReplayed;
+    bool m_finished;
+};
+
+#endif // REPLAYWORKER_H
@@ -0,0 +1,117 @@
+#ifndef SAMPLECLOCK_H
+#define SAMPLECLOCK_H
+
+#include <QtGlobal>
+#include <QString>
+#ifdef DRILLCONTROL_BENCH
+#include <QVector>
+#endif
+
+/**
+ * @brief 采样时钟模型（按块到达时刻在线估计真实采样时钟）
+ *
+ * 硬件按自身晶振连续采样，主机只能在整块读回时打时间戳，块时间戳因此滞后
+ * 一个块长并带有调度抖动。本模型对"累计样本序号 → 到达时刻"做带遗忘因子的
+ * 在线线性回归，斜率即实际采样周期（反映晶振漂移），截距吸收固定传输延迟，
+ * 从而为每个块的第一个样本给出校正后的时间戳，后续样本按估计周期等间隔递推
+ * （发布的块以estimatedRateHz()作为sampleRate，下游按 起始时间戳 + i / sampleRate 计算）。
+ *
+ * 样本丢失（设备溢出、暂停）会使到达时刻偏离模型，残差超过阈值时重新同步。
+ *
+ * 线程安全：非线程安全，由所属Worker线程使用。
+ */
+class SampleClock
+{
+public:
+    SampleClock();
+
+    /**
+     * @brief 重新开始（样本计数归零，清空模型和统计）
+     * @param nominalRateHz 标称采样率
+     */
+    void reset(double nominalRateHz);
+
+    /**
+     * @brief 只清空漂移/抖动统计（轮次切换时调用），模型保持锁定
+     */
+    void resetStatistics();
+
+    /**
+     * @brief 记录一个刚读回的数据块
+     * @param arrivalUs 块读回时刻（单调时间基下的微秒）
+     * @param numSamples 块内每通道样本数
+     * @return 块内第一个样本的校正时间戳（微秒）
+     */
+    qint64 onBlock(qint64 arrivalUs, int numSamples);
+
+    /**
+     * @brief 按估计周期计算块内第index个样本相对首样本的偏移（微秒）
+     */
+    double sampleOffsetUs(int index) const { return index * m_periodUs; }
+
+    bool isLocked() const { return m_fitBlocks >= MIN_FIT_BLOCKS; }
+    double nominalRateHz() const { return m_nominalRate; }
+    double estimatedRateHz() const { return m_periodUs > 0 ? 1e6 / m_periodUs : 0.0; }
+    double driftPpm() const;                    // (估计采样率 - 标称) / 标称 × 1e6
+    double jitterRmsUs() const;                 // 到达时刻相对模型的残差RMS
+    double maxJitterUs() const { return m_maxResidual; }
+    qint64 blockCount() const { return m_statBlocks; }
+    qint64 resyncCount() const { return m_resyncs; }
+
+    /**
+     * @brief 单行摘要：标称/估计采样率、漂移、抖动、重新同步次数
+     */
+    QString summary() const;
+
+#ifdef DRILLCONTROL_BENCH
+    /**
+     * @brief 漂移校验结果（单个模拟漂移）
+     */
+    struct DriftCheckResult {
+        double driftPpm;            // 模拟的晶振漂移
+        double estimatedPpm;        // 模型估计的漂移（结束时）
+        double nominalErrorUs;      // 按标称采样率递推时，1秒窗口内逐样本时间的最大误差
+        double correctedErrorUs;    // 按估计采样率递推时的最大误差
+    };
+
+    /**
+     * @brief 漂移校验：模拟带晶振漂移、固定传输延迟和到达抖动的采集卡，
+     *        比较按标称/估计采样率递推的逐样本时间与真实采样时刻（锁定后统计）
+     */
+    static QVector<DriftCheckResult> runDriftCheck(const QVector<double> &driftsPpm, double nominalRateHz = 5000.0,
+                                                   int blockSamples = 500, int seconds = 120);
+
+    /**
+     * @brief 运行漂移校验并输出到日志（命令行 --bench-clock）
+     * @return 校正后的误差均小于半个采样周期时返回true
+     */
+    static bool logDriftCheck();
+#endif
+
+private:
+    void clearFit();
+
+    static constexpr int MIN_FIT_BLOCKS = 4;            // 少于该块数时使用标称周期
+    static constexpr double TIME_CONSTANT_S = 30.0;     // 遗忘因子时间常数（秒）
+    static constexpr double MAX_DRIFT_PPM = 1000.0;     // 估计周期相对标称的最大偏差
+    static constexpr double RESYNC_THRESHOLD_US = 100000.0;  // 残差超过100ms认为样本丢失
+
+    double m_nominalRate;
+    qint64 m_sampleIndex;       // 已记录的累计样本数
+
+    // 回归坐标原点：最近一个块的末样本序号与到达时刻（每块平移，保持数值精度）
+    qint64 m_originIndex;
+    qint64 m_originUs;
+    double m_sw, m_sx, m_sy, m_sxx, m_sxy;  // 加权和（x = 样本序号偏移，y = 到达时刻偏移）
+    int m_fitBlocks;
+    double m_periodUs;          // 估计采样周期
+    double m_interceptUs;       // 原点处的模型时刻（相对m_originUs）
+
+    // 统计（按轮次清空）
+    qint64 m_statBlocks;
+    double m_residualSq;
+    double m_maxResidual;
+    qint64 m_resyncs;
+};
+
+#endif // SAMPLECLOCK_H
@@ -0,0 +1,147 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <utility>
+#include <vector>
+#include "dataACQ/DataTypes.h"
+
+/**
+ * @brief 单生产者/单消费者无锁环形队列
+ *
+ * 用于采集Worker线程 → DbWriter线程 / UI线程的数据通道，替代QueuedConnection：
+ * - 生产者（Worker线程）调用 tryPush()，不加锁、不经过事件循环
+ * - 消费者（DbWriter线程或UI线程）调用 tryPop()，由批量写入定时器/显示刷新定时器排空
+ * - 容量向上取整到2的幂；队列满时拒绝写入并计入丢弃计数
+ *
+ * 消费者也可以不轮询：空闲前调用requestNotify()，生产者写入后由takeNotifyRequest()
+ * 得知需要唤醒消费者（每次请求只通知一次，连续写入不会逐个发通知）。
+ *
+ * 注意：每个环只能有一个生产者线程和一个消费者线程。
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(int capacity = 4096)
+        : m_head(0)
+        , m_tail(0)
+        , m_highWaterMark(0)
+        , m_droppedCount(0)
+        , m_notifyRequested(false)
+    {
+        int cap = 2;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        m_slots.resize(cap);
+        m_mask = static_cast<quint64>(cap - 1);
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    /**
+     * @brief 写入一个元素（仅生产者线程调用）
+     * @return 队列已满返回false
+     */
+    bool tryPush(const T &item)
+    {
+        T copy(item);
+        return tryPush(std::move(copy));
+    }
+
+    bool tryPush(T &&item)
+    {
+        const quint64 head = m_head.load(std::memory_order_relaxed);
+        const quint64 tail = m_tail.load(std::memory_order_acquire);
+
+        if (head - tail > m_mask) {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        m_slots[head & m_mask] = std::move(item);
+        m_head.store(head + 1, std::memory_order_release);
+
+        // 更新高水位（只有生产者写入，relaxed即可）
+        const int occupancy = static_cast<int>(head + 1 - tail);
+        if (occupancy > m_highWaterMark.load(std::memory_order_relaxed)) {
+            m_highWaterMark.store(occupancy, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 取出一个元素（仅消费者线程调用）
+     * @return 队列为空返回false
+     */
+    bool tryPop(T &out)
+    {
+        const quint64 tail = m_tail.load(std::memory_order_relaxed);
+        const quint64 head = m_head.load(std::memory_order_acquire);
+
+        if (tail == head) {
+            return false;
+        }
+
+        T &slot = m_slots[tail & m_mask];
+        out = std::move(slot);
+        slot = T();  // 立即释放槽位持有的数据引用
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 当前占用（近似值，任意线程可调用）
+     */
+    int size() const
+    {
+        const quint64 tail = m_tail.load(std::memory_order_acquire);
+        const quint64 head = m_head.load(std::memory_order_acquire);
+        return static_cast<int>(head - tail);
+    }
+
+    bool isEmpty() const { return size() == 0; }
+    int capacity() const { return static_cast<int>(m_mask + 1); }
+    int highWaterMark() const { return m_highWaterMark.load(std::memory_order_relaxed); }
+    qint64 droppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+    void resetHighWaterMark() { m_highWaterMark.store(size(), std::memory_order_relaxed); }
+
+    /**
+     * @brief 请求下一次写入后通知（仅消费者线程调用，通常在停止轮询前）
+     *
+     * 请求之后须再检查一次isEmpty()：请求生效前写入的元素不会触发通知。
+     */
+    void requestNotify() { m_notifyRequested.store(true, std::memory_order_release); }
+
+    /**
+     * @brief 取走通知请求（仅生产者线程在写入后调用）
+     * @return 消费者请求过通知返回true，请求随之清除
+     */
+    bool takeNotifyRequest()
+    {
+        return m_notifyRequested.load(std::memory_order_relaxed)
+               && m_notifyRequested.exchange(false, std::memory_order_acq_rel);
+    }
+
+private:
+    std::vector<T> m_slots;
+    quint64 m_mask;
+
+    // head/tail分别由生产者/消费者独占写入，分开缓存行避免伪共享
+    alignas(64) std::atomic<quint64> m_head;    // 下一个写入位置
+    alignas(64) std::atomic<quint64> m_tail;    // 下一个读取位置
+    alignas(64) std::atomic<int> m_highWaterMark;
+    std::atomic<qint64> m_droppedCount;
+    std::atomic<bool> m_notifyRequested;        // 消费者等待写入通知
+};
+
+/**
+ * @brief Worker → DbWriter / UI 数据块通道
+ */
+using DataBlockRing = SpscRing<DataBlock>;
+
+#endif // SPSCRING_H
@@ -0,0 +1,104 @@
+#ifndef SYNTHETICWORKER_H
+#define SYNTHETICWORKER_H
+
+#include "dataACQ/BaseWorker.h"
+#include "dataACQ/BufferPool.h"
+#include <QVector>
+
+/**
+ * @brief 合成高频负载Worker（压力测试用）
+ *
+ * 按配置生成多通道振动信号（正弦 + 高斯噪声 + 衰减冲击），输出与VibrationWorker
+ * 完全相同的Vibration_Packed块（SoA载荷、池化缓冲区），由AcquisitionManager替换
+ * 振动Worker接入管线，用于在提高VK701采样率之前找出DbWriter/UI的承载上限。
+ *
+ * - 采样率最高100kHz，通道数最多16
+ * - 按墙钟节奏生成：落后时连续生成追赶，实际速率与请求速率每秒上报一次
+ * - 使用DbWriter写入额度：额度耗尽被拒绝的块数即管线过载的直接证据
+ * - 时间戳按样本序号精确递推（无采集抖动）
+ */
+class SyntheticWorker : public BaseWorker
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MAX_CHANNELS = 16;
+    static constexpr double MAX_SAMPLE_RATE = 100000.0;
+
+    /**
+     * @brief 单通道信号配置（单位g）
+     */
+    struct ChannelSignal {
+        double sineAmplitude = 1.0;     // 正弦幅值
+        double sineFrequency = 50.0;    // 正弦频率（Hz）
+        double noiseRms = 0.05;         // 高斯噪声RMS
+        double impulseAmplitude = 5.0;  // 冲击峰值
+        double impulseRate = 1.0;       // 冲击平均频率（次/秒，泊松分布）
+        double impulseDecayMs = 2.0;    // 冲击衰减时间常数
+    };
+
+    explicit SyntheticWorker(QObject *parent = nullptr);
+    ~SyntheticWorker();
+
+    /**
+     * @brief 通道数（1-16），须在start之前设置；新增通道按通道号错开正弦频率
+     */
+    void setChannelCount(int count);
+    int channelCount() const { return m_channelCount; }
+
+    void setChannelSignal(int channel, const ChannelSignal &signal);
+
+    /**
+     * @brief 块时长（毫秒），默认100ms（与流式采集一致）
+     */
+    void setBlockDurationMs(int ms) { m_blockDurationMs = qMax(1, ms); }
+
+    /**
+     * @brief 最近一个统计周期的实际采样率（每通道）
+     */
+    double achievedRate() const { return m_achievedRate; }
+
+protected:
+    bool initializeHardware() override;
+    void shutdownHardware() override;
+    void runAcquisition() override;
+
+private:
+    struct ChannelState {
+        double re = 1.0;                // 正弦相量（旋转递推，每块重新归一化）
+        double im = 0.0;
+        double stepRe = 1.0;
+        double stepIm = 0.0;
+        float impulse = 0.0f;           // 当前冲击包络
+        float impulseDecay = 0.0f;      // 每样本衰减系数
+        double impulseProbability = 0.0;    // 每样本触发概率
+    };
+
+    void generateBlock(float *base, int numSamples);
+    double nextUniform();
+    void reportRate(bool final);
+
+private:
+    int m_channelCount;
+    int m_blockDurationMs;
+    double m_rate;                      // 本次运行的有效采样率
+    QVector<ChannelSignal> m_signals;
+    QVector<ChannelState> m_states;
+    quint64 m_rngState;                 // xorshift64*
+
+    BufferPool m_bufferPool;
+    qint64 m_originUs;                  // 第0个样本的时间戳
+    qint64 m_sampleIndex;               // 已生成的每通道样本数
+    QElapsedTimer m_wallTimer;
+
+    // 速率统计
+    qint64 m_reportSamples;             // 上次上报时的样本数
+    qint64 m_reportNs;                  // 上次上报时刻
+    qint64 m_reportDenied;              // 上次上报时的额度拒绝数
+    qint64 m_startDenied;               // 启动时的额度拒绝数/环形队列丢弃数（额度与通道与振动Worker共用）
+    qint64 m_startDropped;
+    double m_achievedRate;
+    double m_minAchievedRate;
+};
+
+#endif // SYNTHETICWORKER_H
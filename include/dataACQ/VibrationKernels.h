@@ -0,0 +1,92 @@
+#ifndef VIBRATIONKERNELS_H
+#define VIBRATIONKERNELS_H
+
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 单通道标定参数：输出 = 输入电压(V) * gain + offset
+ *
+ * 例：灵敏度100mV/g → gain = 1 / 0.1 = 10，offset = 0
+ */
+struct ChannelCalibration {
+    float gain = 1.0f;
+    float offset = 0.0f;
+};
+
+/**
+ * @brief VK701数据帧处理内核
+ *
+ * VK701返回4通道交织的double数组 [ch0, ch1, ch2, ch3, ch0, ...]，
+ * fusedDeinterleave 一次遍历完成：解交织、丢弃第4通道、double→float、每通道标定。
+ *
+ * 运行时按CPU能力选择实现：AVX2 > SSE2 > 标量。
+ */
+class VibrationKernels
+{
+public:
+    enum class Isa {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * @brief 融合内核（自动选择当前CPU支持的最快实现）
+     * @param interleaved 4通道交织数据，长度 frames * 4
+     * @param frames 帧数（每通道样本数）
+     * @param out 3个通道的输出数组，每个长度 frames
+     * @param calibration 3个通道的标定参数
+     */
+    static void fusedDeinterleave(const double *interleaved, int frames,
+                                  float *const out[3], const ChannelCalibration calibration[3]);
+
+    /**
+     * @brief 指定实现版本（用于基准测试和结果校验）
+     * @return CPU不支持该实现时返回false
+     */
+    static bool fusedDeinterleave(Isa isa, const double *interleaved, int frames,
+                                  float *const out[3], const ChannelCalibration calibration[3]);
+
+    /**
+     * @brief 包络抽取：每factor个样本输出一对(min, max)，按出现先后排列
+     *
+     * 用于反压降级，数据量降为2/factor且保留峰值（冲击、颤振不会被平均掉）。
+     * 末尾不足factor的样本单独成一对。out可以与in相同（原地抽取），
+     * 此时要求返回值不超过n（factor ≥ 4 且 n ≥ factor时总是成立）。
+     * @return 输出样本数 = 2 * ceil(n / factor)
+     */
+    static int envelopeDecimate(const float *in, int n, int factor, float *out);
+
+    static Isa activeIsa();
+    static bool isSupported(Isa isa);
+    static QString isaName(Isa isa);
+
+#ifdef DRILLCONTROL_BENCH
+    /**
+     * @brief 基准测试结果（单个采样率 × 单个实现）
+     */
+    struct BenchmarkResult {
+        Isa isa;
+        int sampleRate;             // 采样率（每块帧数 = 1秒数据）
+        double nsPerBlock;          // 处理1秒数据块的耗时（纳秒）
+        double megaSamplesPerSec;   // 吞吐（百万输出样本/秒，3通道合计）
+        float maxAbsError;          // 与标量实现的最大绝对误差
+    };
+
+    /**
+     * @brief 微基准：在给定采样率下测量各实现的吞吐
+     * @param sampleRates 采样率列表（Hz）
+     * @param minDurationMs 每项测量的最短时长
+     */
+    static QVector<BenchmarkResult> runBenchmark(const QVector<int> &sampleRates,
+                                                 int minDurationMs = 200);
+
+    /**
+     * @brief 以默认参数（5kHz~100kHz）运行基准测试并输出到日志
+     */
+    static void logBenchmark();
+#endif
+};
+
+#endif // VIBRATIONKERNELS_H
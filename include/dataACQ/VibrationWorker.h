@@ -2,6 +2,8 @@
 #define VIBRATIONWORKER_H
 
 #include "dataACQ/BaseWorker.h"
+#include "dataACQ/BufferPool.h"
+#include "dataACQ/VibrationKernels.h"
 #include <QThread>
 #include <QLibrary>
 
@@ -11,18 +13,23 @@
  * 硬件：VK701采集卡（TCP端口：8234固定）
  * 传感器类型：3通道振动传感器（X, Y, Z轴）
  * 默认采样频率：5000Hz（可配置1K-100K Hz）
+ * 块时长：默认1秒/块；流式模式可配置为50/100/250ms等亚秒级块（DbWriter按窗口合并）
  * 数据格式：高频BLOB数据
  *
  * 功能：
  * 1. 连接VK701采集卡（固定TCP端口8234）
  * 2. 配置采样参数（频率、通道数）
- * 3. 循环采集3通道振动数据（第4通道被忽略）
- * 4. 打包成DataBlock发送
+ * 3. 循环采集3通道振动数据（第4通道被忽略），SIMD融合内核完成解交织与V→g标定
+ * 4. 每帧打包成一个Vibration_Packed块，经环形队列交给DbWriter和UI（SoA载荷X|Y|Z，池化缓冲区，预热后零堆分配）
+ * 5. 反压降级：DbWriter信用额度不足时改为包络抽取或只写统计摘要，区间记录到events表
  *
  * 连接参数：
  * - cardId: 卡号（0-7）
  * - port: 固定为8234（无需配置）
  *
+ * 多卡：每张卡一个Worker实例和线程（各自的缓冲池、环形队列和写入额度），
+ * 通过channelBase区分全局通道号，所有卡共用同一个TCP服务器端口。
+ *
  * 注意：使用QLibrary动态加载VK70xNMC_DAQ2.dll，与官方例程一致
  */
 class VibrationWorker : public BaseWorker
@@ -33,16 +40,79 @@ public:
     explicit VibrationWorker(QObject *parent = nullptr);
     ~VibrationWorker();
 
+    /**
+     * @brief 输出模式（反压降级）
+     */
+    enum class OutputMode {
+        Full,           // 全速率波形
+        Decimate,       // 包络抽取：每factor个样本保留min/max两点（块标记decimation），另输出每秒摘要保留RMS/均值
+        SummaryOnly     // 只写摘要：每秒每通道min/max/RMS/均值（Vibration_Summary）
+    };
+
     // VK701特定配置
     void setCardId(int cardId) { m_cardId = cardId; }
     void setChannelCount(int count) { m_channelCount = count; }
+    int cardId() const { return m_cardId; }
+
+    /**
+     * @brief 全局通道号起点：本卡输出的块channelId = channelBase + 本卡通道号（多卡时各卡不重叠）
+     */
+    void setChannelBase(int base) { m_channelBase = qMax(0, base); }
+    int channelBase() const { return m_channelBase; }
+
+    /**
+     * @brief 设置每块点数（每通道），0表示按块时长计算
+     *
+     * 点数超过1秒数据量时按1秒截断。
+     */
     void setBlockSize(int size) { m_blockSize = size; }
 
+    /**
+     * @brief 设置块时长（毫秒），setBlockSize为0时生效，默认1000ms
+     *
+     * 流式模式使用较短的块（如50/100/250ms）降低实时曲线和安全逻辑的延迟。
+     */
+    void setBlockDurationMs(int ms) { m_blockDurationMs = ms; }
+
+    /**
+     * @brief 当前采样率下每次读取的点数（每通道）
+     */
+    int effectiveBlockSize() const;
+
+    /**
+     * @brief 设置通道标定：加速度(g) = 电压(V) * gain + offset
+     * @param channel 通道号（0-2）
+     */
+    void setChannelCalibration(int channel, float gain, float offset = 0.0f);
+
+    /**
+     * @brief 设置反压降级策略（须在start之前设置）
+     * @param mode 剩余额度低于degradeBelow时进入的模式，Full表示不降级（额度耗尽时块不落盘）
+     * @param decimationFactor 包络抽取倍数（4-1000，数据量降为2/factor）
+     * @param degradeBelow 剩余额度比例低于该值时降级（默认25%）
+     * @param recoverAbove 剩余额度比例高于该值时恢复全速率（默认50%，回差避免频繁切换）
+     *
+     * 剩余额度低于SUMMARY_CREDIT_LEVEL时，无论配置为何种降级模式都退到只写摘要。
+     */
+    void setDegradePolicy(OutputMode mode, int decimationFactor = 10,
+                          double degradeBelow = 0.25, double recoverAbove = 0.5);
+    OutputMode outputMode() const { return m_outputMode; }
+
     // 测试连接
     Q_INVOKABLE bool testConnection();
     bool isConnected() const { return m_isCardConnected; }
     void disconnect();
 
+    /**
+     * @brief 采集路径的堆分配次数（预热后应保持不变）
+     *
+     * 计入每块路径上所有会分配的位置：缓冲池新建槽位/存储、原始接收缓冲区扩容、
+     * 摘要缓冲区增长，以及publishBlock发出的跨线程信号（每个分配一个事件）。
+     * 块经环形队列交给DbWriter和UI，只拷贝隐式共享的载荷引用。
+     * 不计入诊断输出：约每10秒一行调试日志、每100块一次statisticsUpdated。
+     */
+    qint64 heapAllocationCount() const;
+
 protected:
     // 实现BaseWorker抽象方法
     bool initializeHardware() override;
@@ -58,16 +128,67 @@ private:
     bool startSampling();
     void stopSampling();
     bool readDataBlock();
-    void processAndSendData(float *ch0Data, float *ch1Data, float *ch2Data, int numSamples);
+    void processAndSendData(PooledBuffer &packedData, int numSamples, qint64 firstSampleUs);
+    void updateOutputMode(qint64 timestampUs);
+    void endDegradedInterval(qint64 timestampUs, const QString &reason);
+    void accumulateSummary(const PooledBuffer &packedData, int channelCount, int numSamples, qint64 firstSampleUs);
+    void flushSummary();
+    static QString outputModeName(OutputMode mode);
+
+    /**
+     * @brief 当前标定下ADC 1 LSB对应的输出单位（各通道取最小值），供DbWriter量化压缩
+     */
+    float quantStep() const;
 
 private:
     static constexpr int VK701_TCP_PORT = 8234;  // VK701固定TCP端口
+    static constexpr double VK701_REF_VOLTAGE = 1.0;    // 参考电压（V），24位模式满量程
+    static constexpr int VK701_ADC_BITS = 24;
     int m_cardId;               // 采集卡ID（0-7）
     int m_channelCount;         // 通道数（固定为3）
-    int m_blockSize;            // 每次读取的块大小（点数）
+    int m_channelBase;          // 全局通道号起点（卡序号 × 每卡通道数）
+    int m_blockSize;            // 每次读取的块大小（点数，0=按块时长）
+    int m_blockDurationMs;      // 块时长（毫秒）
 
     int m_blockSequence;        // 块序号
 
+    // 每通道标定（默认灵敏度100mV/g → gain = 10）
+    ChannelCalibration m_calibration[3];
+
+    // 池化采集缓冲（样本数据不随块分配）
+    static constexpr int POOL_WARMUP_BUFFERS = 8;   // 预热缓冲区数（约8个数据帧在途，另加UI队列容量）
+    BufferPool m_bufferPool;        // 打包帧缓冲池（DataBlock载荷引用）
+    QVector<double> m_rawBuffer;    // VK701 4通道交织原始数据（复用）
+    qint64 m_scratchAllocations;    // 原始缓冲区扩容次数
+
+    // 反压降级
+    static constexpr double SUMMARY_CREDIT_LEVEL = 0.05;   // 低于该额度比例时只写摘要
+    OutputMode m_degradeMode;       // 配置的降级模式
+    OutputMode m_outputMode;        // 当前输出模式
+    int m_decimationFactor;         // 包络抽取倍数
+    double m_degradeBelow;          // 降级阈值（剩余额度比例）
+    double m_recoverAbove;          // 恢复阈值（剩余额度比例）
+    qint64 m_degradedSinceUs;       // 当前降级区间起点（-1 = 未降级）
+    qint64 m_degradedBlocks;        // 当前降级区间内降级处理的块数
+    OutputMode m_deepestMode;       // 当前降级区间内最深的模式
+
+    // 摘要累加（包络抽取/只写摘要模式，每秒输出一个Vibration_Summary块）
+    struct SummaryAccumulator {
+        qint64 startUs = -1;        // 区间首样本时刻（-1 = 空）
+        int count = 0;              // 每通道样本数
+        int channelCount = 0;
+        float min[3];
+        float max[3];
+        double sum[3];
+        double sumSq[3];
+    };
+    SummaryAccumulator m_summary;
+
+    // 摘要块数据缓冲（轮流复用，下游释放引用后原地改写，不随摘要块分配）
+    static constexpr int SUMMARY_BUFFERS = 4;
+    QVector<double> m_summaryBuffers[SUMMARY_BUFFERS];
+    qint64 m_summaryAllocations;    // 摘要缓冲区仍被下游持有而重新分配的次数
+
     bool m_isCardConnected;     // 是否已连接采集卡
     bool m_isSampling;          // 是否正在采样
     bool m_isDllLoaded;         // DLL是否已加载
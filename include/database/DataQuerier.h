@@ -7,7 +7,9 @@
 #include <QVector>
 #include <QList>
 #include <QMap>
+#include <QStringList>
 #include "dataACQ/DataTypes.h"
+#include "database/VibrationSegments.h"
 
 /**
  * @brief 数据查询类 - 查询多频率对齐的传感器数据
@@ -16,6 +18,9 @@
  * 1. 按时间窗口查询数据（1秒窗口对齐）
  * 2. 查询某1秒内的所有数据（5000个振动点 + 10个MDB点 + 100个电机点）
  * 3. 简洁高效的查询接口
+ * 4. 标量数据同时读取scalar_samples（每值一行，旧库）和scalar_blocks（每窗口/传感器/通道一行打包数组）
+ * 5. 振动数据在段文件中时映射段文件读取（不经过SQLite BLOB拷贝）
+ * 6. 长时间范围的振动概览从降采样金字塔（vibration_pyramid）读取，不解码原始BLOB
  */
 class DataQuerier : public QObject
 {
@@ -29,6 +34,9 @@ public:
         qint64 windowStartUs;                               // 窗口起始时间（微秒）
         QMap<int, QVector<float>> vibrationData;            // key=channelId(0/1/2), value=振动数据数组
         QMap<int, QVector<double>> scalarData;              // key=sensorType, value=标量数据数组
+        QMap<int, int> vibrationSampleCounts;               // key=channelId，振动样本数（不解码时也填写）
+        QMap<int, int> vibrationDecimation;                 // key=channelId，反压降级的包络抽取因子
+                                                            // （仅含抽取行的通道，其样本为(min, max)对）
 
         WindowData() : windowStartUs(0) {}
     };
@@ -77,21 +85,26 @@ public:
      * @brief 查询指定窗口的所有数据（核心功能）
      * @param roundId 轮次ID
      * @param windowStartUs 窗口起始时间（微秒）
+     * @param decodeVibration false时不解码振动BLOB，只填写vibrationSampleCounts
      * @return 该窗口内的所有数据
      */
-    WindowData getWindowData(int roundId, qint64 windowStartUs);
+    WindowData getWindowData(int roundId, qint64 windowStartUs, bool decodeVibration = true);
 
     /**
      * @brief 查询时间范围内的所有窗口数据
      * @param roundId 轮次ID
      * @param startTimeUs 起始时间（微秒）
      * @param endTimeUs 结束时间（微秒）
+     * @param decodeVibration false时不解码振动BLOB，只填写vibrationSampleCounts（概览用金字塔）
      * @return 窗口数据列表
      */
-    QList<WindowData> getTimeRangeData(int roundId, qint64 startTimeUs, qint64 endTimeUs);
+    QList<WindowData> getTimeRangeData(int roundId, qint64 startTimeUs, qint64 endTimeUs,
+                                       bool decodeVibration = true);
 
     /**
      * @brief 获取振动数据的统计信息（不解析BLOB，直接读预计算值）
+     *
+     * 包络抽取行的meanValue/rmsValue为NaN（真实值在同窗口的Vibration_Summary中）。
      */
     struct VibrationStats {
         qint64 timestampUs;
@@ -103,6 +116,116 @@ public:
     QList<VibrationStats> getVibrationStats(int roundId, int channelId,
                                             qint64 startTimeUs, qint64 endTimeUs);
 
+    /**
+     * @brief 振动包络：每点为一个桶的min/max/mean/RMS
+     */
+    struct VibrationEnvelope {
+        qint64 bucketUs;                // 每点覆盖的时长
+        QVector<qint64> timestampsUs;   // 桶起始时间
+        QVector<float> minValues;
+        QVector<float> maxValues;
+        QVector<float> meanValues;
+        QVector<float> rmsValues;
+
+        VibrationEnvelope() : bucketUs(0) {}
+    };
+
+    /**
+     * @brief 查询单通道的振动包络（概览绘图）
+     *
+     * 从vibration_pyramid中选择桶宽不超过 (endTimeUs - startTimeUs) / maxPoints 的最粗层级，
+     * 点数约为maxPoints（请求比10ms更细时返回10ms层级，需要原始波形时用getWindowData）。
+     * 没有金字塔的旧轮次退回vibration_blocks的预计算统计（每块一点）。
+     */
+    VibrationEnvelope getVibrationEnvelope(int roundId, int channelId,
+                                           qint64 startTimeUs, qint64 endTimeUs, int maxPoints);
+
+    /**
+     * @brief 采样对齐的多通道振动帧（SoA：X|Y|Z依次连续，与Vibration_Packed载荷布局一致）
+     */
+    struct VibrationFrame {
+        qint64 startTimestampUs;
+        double sampleRate;
+        int numSamples;                 // 每通道样本数
+        int channelCount;
+        int decimation;                 // 包络抽取因子（1 = 原始波形，>1时样本为(min, max)对）
+        QVector<float> data;            // channelCount * numSamples
+
+        VibrationFrame() : startTimestampUs(0), sampleRate(0.0), numSamples(0), channelCount(0), decimation(1) {}
+
+        const float *channel(int ch) const { return data.constData() + ch * numSamples; }
+    };
+
+    /**
+     * @brief 查询时间范围内的振动帧（按起始时间戳将各通道的行拼成对齐帧）
+     *
+     * 同一打包块拆出的各通道行共享起始时间戳和样本数，直接组成一帧；
+     * 缺少通道或样本数不一致的行被跳过。
+     * 多卡时各卡时间戳不同，按卡查询：firstChannel = 卡序号 × 3。
+     */
+    QList<VibrationFrame> getVibrationFrames(int roundId, qint64 startTimeUs, qint64 endTimeUs,
+                                             int channelCount = 3, int firstChannel = 0);
+
+    /**
+     * @brief 单个标量样本
+     */
+    struct ScalarSample {
+        int sensorType;
+        int channelId;
+        qint64 timestampUs;
+        double value;
+    };
+
+    /**
+     * @brief 查询时间范围[startTimeUs, endTimeUs)内指定传感器类型范围的标量样本（两种存储布局合并）
+     * @return 按时间戳、传感器类型、通道排序的样本
+     */
+    QVector<ScalarSample> getScalarSamples(int roundId, qint64 startTimeUs, qint64 endTimeUs,
+                                           SensorType firstType, SensorType lastType);
+
+    /**
+     * @brief 数据库中是否存在scalar_blocks表（由DbWriter创建，旧库打开前可能没有）
+     */
+    bool hasScalarBlocks();
+
+    /**
+     * @brief 单个振动块（一行vibration_blocks）
+     */
+    struct VibrationBlockView {
+        qint64 startTimestampUs;
+        double sampleRate;
+        int numSamples;
+        int decimation;                 // 包络抽取因子（1 = 原始波形）
+        QByteArray blob;                // 编码后的BLOB（VibrationCodec::decode解码）；段文件存储时为
+                                        // 映射内存的视图，不拷贝，在releaseSegments()/close()前有效
+    };
+
+    /**
+     * @brief 查询单通道时间范围内的振动块（按起始时间排序，不解码）
+     */
+    QList<VibrationBlockView> getVibrationBlocks(int roundId, int channelId,
+                                                 qint64 startTimeUs, qint64 endTimeUs);
+
+    /**
+     * @brief 解除段文件映射（删除段文件前调用；之前返回的视图失效）
+     */
+    void releaseSegments() { m_segments.release(); }
+
+    /**
+     * @brief 数据库中是否有vibration_segments表（vibration_blocks已有段位置列）
+     */
+    bool hasVibrationSegments();
+
+    /**
+     * @brief 数据库中是否有vibration_pyramid表
+     */
+    bool hasVibrationPyramid();
+
+    /**
+     * @brief 删除段文件（先解除映射；文件仍被占用时只记录警告）
+     */
+    void removeSegmentFiles(const QStringList &fileNames);
+
     /**
      * @brief 获取轮次的实际数据时长（从实际数据时间戳计算）
      * @param roundId 轮次ID
@@ -119,9 +242,40 @@ signals:
     void errorOccurred(const QString &error);
 
 private:
+    /**
+     * @brief 读取scalar_blocks查询结果（sensor_type, channel_id, start_ts_us, n_samples, ts_blob, value_blob），
+     *        展开为样本并追加到out，只保留[startTimeUs, endTimeUs)内的样本
+     */
+    static void appendScalarBlocks(QSqlQuery &query, qint64 startTimeUs, qint64 endTimeUs,
+                                   QVector<ScalarSample> &out);
+    static void sortScalarSamples(QVector<ScalarSample> &samples);
+
+    /**
+     * @brief vibration_blocks查询中BLOB来源的列：data_blob, segment_id, segment_offset, segment_length
+     *        （旧库没有段位置列时后三列为NULL）
+     */
+    bool hasTable(const QString &name);
+    QString vibrationPayloadColumns();
+
+    /**
+     * @brief vibration_blocks查询中的抽取因子列（旧库没有该列时为NULL，按1处理）
+     */
+    QString vibrationDecimationColumn();
+    static int decimationOf(const QVariant &value) { return value.isNull() ? 1 : qMax(1, value.toInt()); }
+
+    /**
+     * @brief 从vibrationPayloadColumns()起始于column的4列取得BLOB（段文件中的返回映射视图）
+     */
+    QByteArray vibrationBlob(int roundId, const QSqlQuery &query, int column);
+
     QString m_dbPath;
     QSqlDatabase m_db;
     bool m_isInitialized;
+    bool m_hasScalarBlocks;     // 一旦检测到即不再查询sqlite_master
+    bool m_hasVibrationSegments;
+    bool m_hasVibrationPyramid;
+    bool m_hasVibrationDecimation;
+    VibrationSegmentReader m_segments;
 };
 
 #endif // DATAQUERIER_H
@@ -0,0 +1,61 @@
+#ifndef DBSTORAGEPOLICY_H
+#define DBSTORAGEPOLICY_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief 采集数据库的持久性配置（durability档位 + WAL检查点策略 + 振动/标量数据存放方式）
+ *
+ * 由AcquisitionManager从config/acquisition.json的database节读取，DbWriter每次打开数据库时
+ * 按档位执行PRAGMA（不依赖schema文件），并在后台线程定时执行WAL检查点。
+ */
+struct DbStoragePolicy {
+    enum class Durability {
+        MaxThroughput,      // synchronous=OFF：掉电可能丢失最近的事务（数据库不损坏）
+        Balanced,           // synchronous=NORMAL：WAL下掉电只丢失最近的检查点之后的提交
+        CrashSafe           // synchronous=FULL：每次提交都同步到磁盘
+    };
+
+    enum class VibrationStorage {
+        Blob,               // 编码后的振动数据写入vibration_blocks.data_blob
+        Segments            // 写入按轮次追加的段文件，vibration_blocks只保存(段, 偏移, 长度)
+    };
+
+    enum class ScalarStorage {
+        Blocks,             // 每窗口/传感器类型/通道打包为一行scalar_blocks
+        Rows                // 旧布局：每样本一行scalar_samples，按批多行INSERT（与旧版读取工具兼容）
+    };
+
+    Durability durability = Durability::Balanced;
+    int checkpointIntervalMs = 1000;    // 后台检查点周期，0 = 关闭后台检查点（恢复SQLite自动检查点）
+    qint64 walTruncateBytes = 64LL * 1024 * 1024;  // WAL超过该大小且已全部回写时截断
+    VibrationStorage vibrationStorage = VibrationStorage::Blob;
+    qint64 segmentBytes = 256LL * 1024 * 1024;     // 段文件超过该大小时换新段
+    ScalarStorage scalarStorage = ScalarStorage::Blocks;
+    bool migrateScalarSamples = true;   // 旧库的scalar_samples行是否在后台转换为scalar_blocks
+
+    /**
+     * @brief 从JSON解析：{"durability": "balanced", "checkpoint_interval_ms": 1000, "wal_truncate_mb": 64,
+     *                      "vibration_storage": "sqlite", "segment_mb": 256, "scalar_storage": "blocks",
+     *                      "migrate_scalar_samples": true}
+     */
+    static bool fromJson(const QJsonObject &json, DbStoragePolicy &policy, QString *errorMessage = nullptr);
+    static QString durabilityName(Durability durability);
+    static QString vibrationStorageName(VibrationStorage storage);
+    static QString scalarStorageName(ScalarStorage storage);
+
+    bool backgroundCheckpoint() const { return checkpointIntervalMs > 0; }
+    bool vibrationSegments() const { return vibrationStorage == VibrationStorage::Segments; }
+    bool scalarBlocks() const { return scalarStorage == ScalarStorage::Blocks; }
+
+    /**
+     * @brief 打开连接后依次执行的PRAGMA语句
+     */
+    QStringList pragmas() const;
+
+    QString describe() const;
+};
+
+#endif // DBSTORAGEPOLICY_H
@@ -5,19 +5,41 @@
 #include <QQueue>
 #include <QMutex>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QMap>
+#include <QHash>
 #include "dataACQ/DataTypes.h"
+#include "dataACQ/SpscRing.h"
+#include "dataACQ/CreditGate.h"
+#include "dataACQ/PipelineLatency.h"
+#include "database/DbStoragePolicy.h"
+#include "database/VibrationPyramid.h"
+#include "database/VibrationSegments.h"
+
+class QThread;
+class WalCheckpointer;
 
 /**
  * @brief 数据库异步写入类
  * 
  * 功能：
- * 1. 接收所有Worker发送的DataBlock
+ * 1. 接收所有Worker发送的DataBlock（无锁环形队列 + 信号队列）
  * 2. 使用队列缓冲
  * 3. 批量事务写入SQLite
  * 4. 流控：队列满时警告或降采样
+ * 5. 振动子块（亚秒级流式块）按通道/时间窗口合并为一行BLOB，避免行数膨胀
+ * 6. 管线延迟：记录块的出队/提交时刻，按传感器类型汇总分段延迟，轮次结束时写入pipeline_latency表
+ * 7. 热路径SQL（标量/振动插入、窗口查找/创建/状态更新）使用长期持有的预编译语句，每次打开数据库时创建
+ * 8. 标量行（MDB/电机/振动摘要）按批收集为列缓冲，提交前以多行VALUES分块插入
+ * 9. 时间窗口的has_vibration/has_mdb/has_motor标志在内存中跟踪，每批提交前每个窗口只写一次新增标志
+ * 10. 每次打开数据库按持久性档位执行PRAGMA，WAL检查点由后台线程（WalCheckpointer）执行，提交不再内联检查点
+ * 11. 振动BLOB按ADC分辨率量化 + 差分 + 位打包编码（VibrationCodec），DataQuerier透明解码
+ * 12. 标量按(窗口, 传感器类型, 通道)合并为scalar_blocks的一行打包数组，打开旧库时把scalar_samples迁移为块
+ * 13. 可选段文件存储（vibration_storage = segments）：振动BLOB追加到按轮次的段文件，
+ *     vibration_blocks只保存位置和统计值，段文件在事务提交前flush
+ * 14. 每通道维护振动降采样金字塔（10ms/100ms/1s/10s桶的min/max/mean/RMS），写入vibration_pyramid表
  * 
  * 重要：此类必须运行在独立线程，保证SQLite线程安全
  */
@@ -33,6 +55,74 @@ public:
     int queueSize() const;
     int maxQueueSize() const { return m_maxQueueSize; }
     qint64 totalBlocksWritten() const { return m_totalBlocksWritten; }
+
+#ifdef DRILLCONTROL_BENCH
+    /**
+     * @brief 单一语句模式的写入基准结果
+     */
+    enum class BenchmarkMode {
+        PerCallPrepare,             // 每块重新prepare，逐行插入标量
+        CachedStatements,           // 预编译语句缓存，逐行插入标量
+        BulkScalar,                 // 预编译语句缓存，标量按批多行插入（scalar_samples）
+        ScalarBlocks,               // 标量按窗口/通道打包写入scalar_blocks
+        Segments                    // 同ScalarBlocks，振动BLOB写入段文件
+    };
+
+    struct BenchmarkResult {
+        BenchmarkMode mode;
+        int blocks;                 // 写入的块数
+        qint64 scalarRows;          // 写入的标量样本数
+        qint64 scalarTableRows;     // 标量表插入行数（块布局下为块数）
+        qint64 windowFlagUpdates;   // time_windows标志UPDATE次数
+        double vibrationCompression;    // 振动BLOB压缩比（原始float / 编码后）
+        qint64 prepares;            // SQL解析（prepare）次数
+        double elapsedMs;
+        double blocksPerSecond;
+        double scalarRowsPerSecond;
+    };
+
+    static QString benchmarkModeName(BenchmarkMode mode);
+
+    /**
+     * @brief 写入基准：同一段合成轮次（3通道5kHz振动流式块 + 4路MDB + 电机快照）按各BenchmarkMode
+     *        写入临时数据库，在调用线程中同步执行
+     * @param seconds 合成轮次时长（秒）
+     * @param includeVibration false时只写标量流（测量标量行吞吐）
+     */
+    static QVector<BenchmarkResult> runBenchmark(int seconds = 60, bool includeVibration = true);
+
+    /**
+     * @brief 运行写入基准（混合轮次 + 纯标量轮次）并输出到日志（命令行 --bench-db）
+     */
+    static void logBenchmark(int seconds = 60);
+#endif
+
+    /**
+     * @brief 注册Worker的无锁输出通道，由批量定时器直接排空（不经过事件循环）
+     * @param name 通道名称（用于统计输出）
+     * @param ring 环形队列（不拥有，调用方保证生命周期）
+     * @param credits 该通道的信用额度（可选，不拥有）：块所在事务提交后归还额度
+     */
+    void attachRing(const QString &name, DataBlockRing *ring, CreditGate *credits = nullptr);
+
+    /**
+     * @brief 注销所有环形队列（销毁环形队列前调用）
+     */
+    void detachRings();
+
+    /**
+     * @brief 设置管线延迟统计（不拥有，可为nullptr；在initialize之前调用）
+     *
+     * 每批事务提交后记录各块的排队/提交延迟，约每秒通过latencyMetricsUpdated输出摘要，
+     * 轮次结束时按传感器类型×分段写入pipeline_latency表并清零。
+     */
+    void setPipelineLatency(PipelineLatency *latency) { m_latency = latency; }
+
+    /**
+     * @brief 设置持久性档位和检查点策略（在initialize之前调用，下次打开数据库时生效）
+     */
+    void setStoragePolicy(const DbStoragePolicy &policy) { m_storagePolicy = policy; }
+    DbStoragePolicy storagePolicy() const { return m_storagePolicy; }
     
 public slots:
     /**
@@ -130,29 +220,182 @@ signals:
      */
     void statisticsUpdated(qint64 totalBlocks, int queueSize);
 
+    /**
+     * @brief 环形队列统计（约每秒一次）
+     * @param name 通道名称
+     * @param occupancy 当前占用
+     * @param highWaterMark 上次报告以来的高水位
+     * @param capacity 容量
+     * @param dropped 累计丢弃块数
+     */
+    void ringMetricsUpdated(const QString &name, int occupancy, int highWaterMark,
+                            int capacity, qint64 dropped);
+
+    /**
+     * @brief 管线延迟摘要（约每秒一次，本轮次累计）
+     */
+    void latencyMetricsUpdated(const QString &summary);
+
+    /**
+     * @brief WAL大小和检查点耗时摘要（后台检查点每次执行后，来自检查点线程）
+     */
+    void walMetricsUpdated(const QString &summary);
+
 private slots:
     /**
-     * @brief 定时批量写入
+     * @brief 批量定时器：排空环形队列和信号队列
+     */
+    void onBatchTimer();
+
+    /**
+     * @brief 迁移定时器：转换一段旧的scalar_samples行，全部完成后更新schema版本
+     */
+    void onMigrationTimer();
+
+    /**
+     * @brief 批量写入一批数据
+     * @return 本批写入的块数
      */
-    void processBatch();
+    int processBatch();
 
 private:
+    static constexpr int BULK_SCALAR_LEVELS = 8;    // 多行标量插入分块：1, 2, 4, ... 128行
+    static constexpr double SAMPLE_RATE_TOLERANCE = 0.002;  // 振动子块合并时视为同一采样率的相对偏差（采样时钟估计值）
+
+    // 数据库schema版本（PRAGMA user_version）：1 = scalar_samples已全部转换为scalar_blocks
+    static constexpr int SCHEMA_VERSION = 1;
+    static constexpr int MIGRATION_CHUNK_WINDOWS = 20;     // 每段迁移的时间窗口数（一个事务）
+    static constexpr int MIGRATION_INTERVAL_MS = 50;       // 段间隔，批量写入在段之间照常进行
+
+    // 热路径预编译语句（下标 = Statement）
+    enum Statement {
+        StmtInsertScalar = 0,
+        StmtInsertVibration,
+        StmtSelectWindow,
+        StmtInsertWindow,
+        StmtUpdateWindowFlags,
+        StmtInsertScalarBlock,
+        StmtInsertSegment,
+        StmtReplacePyramid,
+        StmtInsertScalarBulk,           // 2^k行的多行插入为 StmtInsertScalarBulk + k
+        StatementCount = StmtInsertScalarBulk + BULK_SCALAR_LEVELS
+    };
+
+    // 本批待插入的标量行（列式缓冲，processBatch提交前统一写出）
+    struct ScalarRows {
+        QVector<int> roundIds;
+        QVector<int> windowIds;
+        QVector<int> sensorTypes;
+        QVector<int> channelIds;
+        QVector<qint64> timestamps;
+        QVector<double> values;
+
+        int size() const { return values.size(); }
+        void append(int roundId, int windowId, int sensorType, int channelId,
+                    qint64 timestampUs, double value);
+        void clear();
+    };
+
+#ifdef DRILLCONTROL_BENCH
+    static void logBenchmarkResults(const QVector<BenchmarkResult> &results);
+#endif
+    static QString connectionName();
+    static QString statementSql(Statement id);
+    bool prepareStatements();
+    void releaseStatements();
+    QSqlQuery &statement(Statement id);
+    bool addScalarRow(int roundId, int windowId, int sensorType, int channelId,
+                      qint64 timestampUs, double value);
+    bool flushScalarRows();
+
+    // 标量块合并缓冲（每传感器类型/通道一个，同一时间窗口内的样本写入scalar_blocks的一行）
+    struct ScalarAccumulator {
+        int roundId = 0;
+        int windowId = -1;
+        QVector<qint64> timestamps;
+        QVector<double> values;
+        bool ordered = true;            // 时间戳是否按追加顺序递增
+        qint64 lastAppendMs = 0;        // 最后追加时刻（超时落盘用）
+    };
+    static quint64 scalarKey(int sensorType, int channelId);
+    bool writeScalarBlock(int sensorType, int channelId, ScalarAccumulator &acc);
+
+    // 旧库标量迁移：schema版本低于SCHEMA_VERSION且scalar_samples非空时，在DbThread上按窗口分段转换，
+    // 每段在一个事务中写入scalar_blocks、把原始行移入scalar_samples_legacy，行数核对一致才提交
+    int schemaVersion();
+    bool setSchemaVersion(int version);
+    bool startScalarMigration();
+    void stopScalarMigration();
+    int migrateScalarChunk();           // 返回本段迁移的行数，0 = 已全部完成，-1 = 失败（已回滚）
+
     bool initializeDatabase();
+    bool applyStoragePolicy();
+    void startCheckpointer();
+    void stopCheckpointer();
     bool createTables();
-    bool createTablesManually();
     bool writeScalarData(const DataBlock &block);
+    bool writeMotorSnapshot(const DataBlock &block);
+    bool writeVibrationSummary(const DataBlock &block);
     bool writeVibrationData(const DataBlock &block);
+    bool appendVibrationChannel(int roundId, int channelId, qint64 startTimestampUs,
+                                double sampleRate, const float *data, int n, float quantStep,
+                                int decimation);
+    bool writeVibrationRow(int roundId, int channelId, qint64 startTimestampUs,
+                           double sampleRate, int numSamples, const QByteArray &samples,
+                           float quantStep, int decimation);
+    bool flushAccumulators(bool force);
+    bool addToPyramid(int roundId, int channelId, qint64 startTimestampUs,
+                      double sampleRate, const float *data, int n);
+    bool writePyramidRows(int roundId, int channelId, const QVector<VibrationPyramid::Row> &rows);
+    bool appendVibrationSegment(int roundId, const QByteArray &blob, qint64 *segmentId, qint64 *offset);
+    bool flushSegments();
+    QStringList segmentFiles(const QString &roundCondition, int roundId);
+    void removeSegmentFiles(const QStringList &fileNames);
     qint64 getCurrentTimestampUs();
-    void updateWindowStatus(int windowId, const QString &dataType);
+    void markWindow(int windowId, quint8 flag);
+    bool flushWindowFlags();
     void clearWindowCache();
     void markAbnormalRounds();  // 标记异常中断的轮次
+    int drainRings(QVector<DataBlock> &batch, int maxBlocks);
+    void reportRingMetrics();
+    void grantCredits();
+    void writeLatencyReport(int roundId);
 
 private:
     QString m_dbPath;                   // 数据库路径
     QSqlDatabase m_db;                  // 数据库连接
+    DbStoragePolicy m_storagePolicy;    // 持久性档位（每次打开时应用）
+    QThread *m_checkpointThread;        // WAL后台检查点线程
+    WalCheckpointer *m_checkpointer;    // 运行在m_checkpointThread中
+    QVector<QSqlQuery> m_statements;    // 预编译语句（打开数据库后创建，关闭前释放）
+    bool m_cacheStatements;             // false时每次调用重新prepare（仅基准对照用）
+    qint64 m_statementPrepares;         // 累计prepare次数
+    bool m_bulkScalarInserts;           // 行布局下false时标量逐行插入（仅基准对照用）
+    ScalarRows m_scalarRows;            // 本批待插入的标量行
+    qint64 m_scalarRowsWritten;         // 累计写入的标量样本数
+    qint64 m_scalarTableRows;           // 累计插入的标量表行数（行或块）
+    QHash<quint64, ScalarAccumulator> m_scalarAccumulators;    // key = scalarKey(sensorType, channelId)
+    qint64 m_vibrationRawBytes;         // 累计振动样本原始字节数（float）
+    qint64 m_vibrationBlobBytes;        // 累计振动BLOB编码后字节数
+    VibrationSegmentWriter m_segmentWriter;     // 当前段文件（vibration_storage = segments）
     QQueue<DataBlock> m_queue;          // 数据队列
     mutable QMutex m_queueMutex;        // 队列互斥锁
     QTimer *m_batchTimer;               // 批量写入定时器
+    QTimer *m_migrationTimer;           // 标量迁移定时器（迁移进行中才存在）
+    qint64 m_migratedRows;              // 本次打开已迁移的scalar_samples行数
+    QElapsedTimer m_migrationClock;
+
+    // Worker无锁输出通道（m_queueMutex保护列表本身，排空不加锁）
+    struct RingSource {
+        QString name;
+        DataBlockRing *ring;
+        CreditGate *credits;            // 可为nullptr
+        int pendingCredits;             // 已取出、待本批事务提交后归还的额度
+    };
+    QVector<RingSource> m_rings;
+    int m_ringCursor;                   // 轮询起点，保证各通道公平
+    int m_ringReportTicks;              // 距上次统计输出的定时器次数
+    PipelineLatency *m_latency;         // 管线延迟统计（不拥有）
 
     int m_currentRoundId;               // 当前轮次ID
     int m_maxQueueSize;                 // 最大队列长度（默认10000）
@@ -162,8 +405,45 @@ private:
     qint64 m_totalBlocksWritten;        // 已写入总块数
     bool m_isInitialized;               // 是否已初始化
 
+    // 振动子块合并缓冲（每通道一个，同一时间窗口内的子块拼接后写入一行）
+    struct VibrationAccumulator {
+        int roundId = 0;
+        qint64 windowStartUs = -1;
+        qint64 startTimestampUs = 0;    // 首个子块的起始时间戳
+        double sampleRate = 0.0;
+        float quantStep = 0.0f;         // 量化步长（0 = 按峰值量化）
+        int decimation = 1;             // 包络抽取因子（1 = 原始波形）
+        int numSamples = 0;
+        QByteArray data;                // 拼接后的float数组
+        qint64 lastAppendMs = 0;        // 最后追加时刻（超时落盘用）
+    };
+    QMap<int, VibrationAccumulator> m_vibrationAccumulators;   // key = channelId
+    int m_accumulatorFlushTimeoutMs;    // 振动子块/标量样本停止到达多久后强制落盘（默认1500ms）
+
+    // 振动降采样金字塔（每通道一个，未满的行在超时/强制落盘时写出当前内容）
+    struct PyramidState {
+        int roundId = 0;
+        VibrationPyramid pyramid;
+        qint64 lastAppendMs = 0;
+    };
+    QMap<int, PyramidState> m_pyramids;     // key = channelId
+
     // 时间窗口管理
     QMap<QPair<int, qint64>, int> m_windowCache;    // 窗口缓存：key=(round_id, window_start_us)
+
+    // 窗口数据标志（与time_windows.has_*对应），内存中跟踪，新增的标志在批提交前写出
+    enum WindowFlag : quint8 {
+        WindowHasVibration = 0x1,
+        WindowHasMdb = 0x2,
+        WindowHasMotor = 0x4
+    };
+    struct WindowState {
+        int roundId = 0;
+        quint8 flags = 0;               // 已知已设置（含待写出）的标志
+        quint8 pendingFlags = 0;        // 待写出的新增标志
+    };
+    QHash<int, WindowState> m_windowStates;         // key = window_id，随窗口缓存淘汰
+    qint64 m_windowFlagUpdates;         // 累计标志UPDATE次数
     int m_maxCacheSize;                 // 缓存大小限制（默认100）
 };
 
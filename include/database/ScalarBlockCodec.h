@@ -0,0 +1,27 @@
+#ifndef SCALARBLOCKCODEC_H
+#define SCALARBLOCKCODEC_H
+
+#include <QByteArray>
+#include <QVector>
+
+/**
+ * @brief scalar_blocks行的时间戳/数值数组打包（小端）
+ *
+ * - ts_blob：int32数组，每个样本相对start_ts_us的偏移（微秒，块不跨窗口，偏移 < 2^31）
+ * - value_blob：float64数组
+ */
+class ScalarBlockCodec
+{
+public:
+    static QByteArray packTimestamps(const QVector<qint64> &timestamps, qint64 startUs);
+    static QByteArray packValues(const QVector<double> &values);
+
+    /**
+     * @brief 解包n个样本并追加到timestamps/values末尾（timestamps可为nullptr）
+     * @return BLOB长度与n一致时返回true（失败时输出不变）
+     */
+    static bool unpack(const QByteArray &timestampBlob, const QByteArray &valueBlob,
+                       qint64 startUs, int n, QVector<qint64> *timestamps, QVector<double> &values);
+};
+
+#endif // SCALARBLOCKCODEC_H
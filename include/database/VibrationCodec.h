@@ -0,0 +1,105 @@
+#ifndef VIBRATIONCODEC_H
+#define VIBRATIONCODEC_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "dataACQ/VibrationKernels.h"
+
+/**
+ * @brief 振动BLOB编解码（vibration_blocks.data_blob）
+ *
+ * BLOB格式（小端）：
+ *   0   3  魔数 "VBC"
+ *   3   1  编码：0 = Float32（原始float数组），1 = QuantDelta
+ *   4   4  样本数
+ *   8   4  量化步长（float，QuantDelta）
+ *   12  4  首样本量化值（int32，QuantDelta）
+ *   16  ... 载荷
+ *
+ * QuantDelta：样本按步长量化为整数（不超过24位），相邻差值zigzag后每128个一组位打包：
+ *   每组1字节位宽 + ceil(组内个数 × 位宽 / 8)字节，末尾8字节零填充（解码时整字读取不越界）。
+ * 还原误差不超过步长的一半；步长取ADC 1 LSB（换算到输出单位）时与VK701 24位原始分辨率一致。
+ *
+ * 没有魔数的BLOB按旧格式（原始float数组）读取，旧数据库无需迁移。
+ */
+class VibrationCodec
+{
+public:
+    enum Codec : quint8 {
+        Float32 = 0,
+        QuantDelta = 1
+    };
+
+    static constexpr int HEADER_SIZE = 16;
+    static constexpr int GROUP_SIZE = 128;
+    static constexpr int MAX_CODE = (1 << 23) - 1;     // 24位有符号量化范围
+
+    /**
+     * @brief 编码一段样本
+     * @param quantStep 量化步长（ADC 1 LSB对应的输出单位）；0表示未知，按本段峰值的24位分辨率量化。
+     *                  信号超出步长×2^23时同样放大到峰值的24位分辨率。含NaN/Inf时退回Float32。
+     */
+    static QByteArray encode(const float *data, int n, float quantStep);
+
+    /**
+     * @brief BLOB中的样本数（新旧格式均可），格式错误返回-1
+     */
+    static int sampleCount(const QByteArray &blob);
+
+    /**
+     * @brief BLOB使用的编码（旧格式返回Float32）
+     */
+    static Codec codecOf(const QByteArray &blob);
+
+    /**
+     * @brief BLOB的量化步长（Float32和旧格式返回0）
+     */
+    static float quantStepOf(const QByteArray &blob);
+
+    /**
+     * @brief 解码到out（自动选择当前CPU支持的最快实现）
+     * @param capacity out的容量（样本数），不足sampleCount时失败
+     * @return 解码的样本数，失败返回-1
+     */
+    static int decode(const QByteArray &blob, float *out, int capacity);
+
+    /**
+     * @brief 解码并追加到out末尾
+     * @return 追加的样本数，失败返回-1（out不变）
+     */
+    static int decodeAppend(const QByteArray &blob, QVector<float> &out);
+
+    /**
+     * @brief 指定实现版本（用于基准测试和结果校验，AVX2与SSE2共用同一实现）
+     */
+    static int decode(VibrationKernels::Isa isa, const QByteArray &blob, float *out, int capacity);
+
+#ifdef DRILLCONTROL_BENCH
+    /**
+     * @brief 基准测试结果（单个信号）
+     */
+    struct BenchmarkResult {
+        QString signal;             // 信号描述
+        int samples;                // 每段样本数
+        double compressionRatio;    // 原始float字节数 / BLOB字节数
+        double encodeMBps;          // 编码吞吐（按原始float字节计）
+        double decodeScalarMBps;    // 标量解码吞吐
+        double decodeSimdMBps;      // SIMD解码吞吐（不支持时为0）
+        float maxAbsError;          // 最大还原误差
+        float step;                 // 实际量化步长
+    };
+
+    /**
+     * @brief 微基准：1秒5kHz的典型信号，测量压缩比和编解码吞吐
+     */
+    static QVector<BenchmarkResult> runBenchmark(int minDurationMs = 200);
+
+    /**
+     * @brief 运行基准测试并输出到日志（命令行 --bench-codec）
+     */
+    static void logBenchmark();
+#endif
+};
+
+#endif // VIBRATIONCODEC_H
@@ -0,0 +1,94 @@
+#ifndef VIBRATIONPYRAMID_H
+#define VIBRATIONPYRAMID_H
+
+#include <QByteArray>
+#include <QVector>
+
+/**
+ * @brief 单通道振动降采样金字塔（写入时计算，vibration_pyramid表）
+ *
+ * 4个层级：10ms / 100ms / 1s / 10s桶，每桶min、max、mean、RMS。
+ * 桶按绝对时间对齐（桶起点 = 时间戳向下取整到桶宽），各层级的桶互相嵌套。
+ * 每层每100个桶打包为一行（BLOB：每桶4个float32小端，无样本的桶为NaN），
+ * 行跨度分别为1s / 10s / 100s / 1000s。
+ *
+ * 样本需按时间顺序追加；未满的行可随时取出写入（INSERT OR REPLACE），状态保留继续累积。
+ */
+class VibrationPyramid
+{
+public:
+    static constexpr int LEVEL_COUNT = 4;
+    static constexpr int BUCKETS_PER_ROW = 100;
+    static constexpr int BUCKET_BYTES = 4 * sizeof(float);
+
+    /**
+     * @brief 层级的桶宽（微秒）：10ms × 10^level
+     */
+    static qint64 levelUs(int level);
+
+    /**
+     * @brief 桶宽不超过bucketUs的最粗层级（bucketUs小于10ms时返回0）
+     */
+    static int coarsestLevel(qint64 bucketUs);
+
+    struct Bucket {
+        float minValue;
+        float maxValue;
+        float meanValue;
+        float rmsValue;
+    };
+
+    /**
+     * @brief 待写入的一行
+     */
+    struct Row {
+        int level;
+        qint64 startUs;                 // 行起点（对齐到levelUs × BUCKETS_PER_ROW）
+        QByteArray blob;                // BUCKETS_PER_ROW个桶
+    };
+
+    VibrationPyramid();
+
+    /**
+     * @brief 追加一段等间隔样本（第i个样本时刻 = startTimestampUs + i × 1e6 / sampleRate）
+     * @param completed 追加过程中写满（后续样本已进入下一行）的行
+     */
+    void add(qint64 startTimestampUs, double sampleRate, const float *data, int n,
+             QVector<Row> &completed);
+
+    /**
+     * @brief 取出上次取出/写满之后有新样本的未满行（状态保留）
+     */
+    void takePending(QVector<Row> &rows);
+    bool hasPending() const;
+    void clear();
+
+    /**
+     * @brief 解包一行
+     * @return 桶数，BLOB长度不是BUCKET_BYTES的整数倍或超过capacity时返回-1
+     */
+    static int unpack(const QByteArray &blob, Bucket *out, int capacity);
+
+private:
+    struct Accum {
+        float minValue;
+        float maxValue;
+        double sum;
+        double sumSq;
+        qint64 count;
+    };
+
+    struct LevelState {
+        qint64 rowStartUs = -1;
+        bool dirty = false;             // 上次取出后有新样本
+        Accum buckets[BUCKETS_PER_ROW];
+    };
+
+    void addRun(qint64 timestampUs, const Accum &run, QVector<Row> &completed);
+    static void resetRow(LevelState &state, qint64 rowStartUs);
+    static Row pack(int level, const LevelState &state);
+
+    LevelState m_levels[LEVEL_COUNT];
+};
+
+#endif // VIBRATIONPYRAMID_H
@@ -0,0 +1,102 @@
+#ifndef VIBRATIONSEGMENTS_H
+#define VIBRATIONSEGMENTS_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QString>
+
+/**
+ * @brief 振动段文件（database.vibration_storage = segments）
+ *
+ * 每个段是<数据库路径>.segments目录下的一个只追加文件：round<轮次>_<segment_id>.vseg，
+ * segment_id来自vibration_segments表（AUTOINCREMENT，删除后不复用，文件名不会指向旧数据）。
+ * 段内依次存放编码后的振动BLOB（VibrationCodec格式），每个BLOB起始偏移按16字节对齐，
+ * vibration_blocks只记录(segment_id, segment_offset, segment_length)和统计值。
+ *
+ * 段文件从不截断或覆盖：事务回滚留下的字节不被引用，删除轮次时整文件删除。
+ */
+class VibrationSegmentWriter
+{
+public:
+    static constexpr int ALIGNMENT = 16;
+
+    /**
+     * @brief 数据库对应的段目录（<数据库路径>.segments）
+     */
+    static QString directoryFor(const QString &dbPath);
+    static QString fileName(int roundId, qint64 segmentId);
+
+    VibrationSegmentWriter();
+    ~VibrationSegmentWriter();
+
+    /**
+     * @brief 打开（或创建）段文件，从文件末尾继续追加
+     */
+    bool open(const QString &directory, int roundId, qint64 segmentId, QString *errorMessage = nullptr);
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    int roundId() const { return m_roundId; }
+    qint64 segmentId() const { return m_segmentId; }
+    qint64 size() const { return m_size; }
+
+    /**
+     * @brief 追加一个BLOB（对齐填充后写入）
+     * @return 起始偏移，失败返回-1
+     */
+    qint64 append(const QByteArray &blob);
+
+    /**
+     * @brief 把已追加的数据交给操作系统；sync为true时同步到磁盘
+     *
+     * 在引用这些数据的事务提交之前调用，保证索引行可见时数据已在文件中。
+     */
+    bool flush(bool sync);
+
+private:
+    QFile m_file;
+    int m_roundId;
+    qint64 m_segmentId;
+    qint64 m_size;                      // 当前文件长度（下一次追加的起点，未对齐）
+    bool m_dirty;                       // 上次flush后有新数据
+};
+
+/**
+ * @brief 段文件只读映射（DataQuerier使用）
+ *
+ * 每个段文件映射一次，按需返回BLOB的只读视图（QByteArray::fromRawData，不拷贝）。
+ * 段文件仍在追加时，请求超出已映射长度则重新映射整个文件；旧映射保留到release()，
+ * 之前返回的视图不会失效。
+ */
+class VibrationSegmentReader
+{
+public:
+    VibrationSegmentReader();
+    ~VibrationSegmentReader();
+
+    void setDirectory(const QString &directory) { m_directory = directory; }
+
+    /**
+     * @brief 返回段文件中[offset, offset + length)的视图
+     * @return 视图在release()或对象销毁前有效；文件不存在或越界时返回空QByteArray
+     */
+    QByteArray view(const QString &fileName, qint64 offset, qint64 length);
+
+    /**
+     * @brief 解除全部映射并关闭文件（删除段文件前调用，Windows下映射中的文件无法删除）
+     */
+    void release();
+
+private:
+    struct Mapping {
+        QFile *file = nullptr;
+        const uchar *data = nullptr;
+        qint64 size = 0;
+    };
+
+    QString m_directory;
+    QHash<QString, Mapping> m_mappings;     // key = 文件名
+};
+
+#endif // VIBRATIONSEGMENTS_H
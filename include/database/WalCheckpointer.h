@@ -0,0 +1,73 @@
+#ifndef WALCHECKPOINTER_H
+#define WALCHECKPOINTER_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QTimer>
+#include "database/DbStoragePolicy.h"
+#include "dataACQ/LatencyHistogram.h"
+
+/**
+ * @brief WAL后台检查点（运行在独立线程，使用自己的数据库连接）
+ *
+ * DbWriter以wal_autocheckpoint=0打开数据库，提交不再触发内联检查点；本类定时执行：
+ * - PASSIVE：把WAL帧回写到主库，不等待、不阻塞写入连接
+ * - TRUNCATE：WAL超过阈值且上次PASSIVE已全部回写时截断WAL文件（只剩截断，持有写锁的时间很短）
+ *
+ * 每次检查点后通过metricsUpdated输出WAL大小和检查点耗时摘要。
+ */
+class WalCheckpointer : public QObject
+{
+    Q_OBJECT
+
+public:
+    WalCheckpointer(const QString &dbPath, const DbStoragePolicy &policy, QObject *parent = nullptr);
+    ~WalCheckpointer();
+
+    qint64 walBytes() const;
+
+public slots:
+    /**
+     * @brief 打开检查点连接并启动定时器（必须在检查点线程中调用）
+     */
+    void start();
+
+    /**
+     * @brief 执行最后一次TRUNCATE并关闭连接（必须在检查点线程中调用）
+     */
+    void stop();
+
+signals:
+    /**
+     * @brief 检查点统计摘要（每次检查点后）
+     */
+    void metricsUpdated(const QString &summary);
+
+    void errorOccurred(const QString &error);
+
+private slots:
+    void onTimer();
+
+private:
+    /**
+     * @brief 执行一次wal_checkpoint
+     * @param mode "PASSIVE" 或 "TRUNCATE"
+     * @return 检查点完成（非busy）且WAL帧已全部回写
+     */
+    bool checkpoint(const char *mode);
+    QString summary() const;
+
+    QString m_dbPath;
+    DbStoragePolicy m_policy;
+    QString m_connectionName;
+    QSqlDatabase m_db;
+    QTimer *m_timer;
+    bool m_fullyBackfilled;             // 上次检查点后WAL已全部回写主库
+    LatencyHistogram m_durations;       // 检查点耗时（微秒）
+    qint64 m_lastDurationUs;
+    qint64 m_lastWalBytes;              // 最近一次检查点前的WAL大小
+    qint64 m_truncations;
+    qint64 m_busyCount;                 // 因读写冲突未能完成的检查点次数
+};
+
+#endif // WALCHECKPOINTER_H
@@ -72,8 +72,14 @@ private:
     // 图表辅助元素
     QCPItemLine* m_cursorLine;  // 游标线（用于同步交互）
 
+    // 异步查询结果：窗口数据（不解码振动BLOB）+ 各振动通道的包络
+    struct QueryResult {
+        QList<DataQuerier::WindowData> windows;
+        QMap<int, DataQuerier::VibrationEnvelope> vibration;   // key=channelId
+    };
+
     // 异步查询
-    QFutureWatcher<QList<DataQuerier::WindowData>> m_queryWatcher;
+    QFutureWatcher<QueryResult> m_queryWatcher;
 
     // 当前选中轮次信息
     int m_currentRoundId;
@@ -83,6 +89,7 @@ private:
 
     // 当前查询的数据（用于筛选）
     QList<DataQuerier::WindowData> m_currentQueryData;
+    QMap<int, DataQuerier::VibrationEnvelope> m_currentVibration;
 };
 
 #endif // DATABASEPAGE_H
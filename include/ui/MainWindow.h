@@ -39,6 +39,8 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    AcquisitionManager *acquisitionManager() const { return m_acquisitionManager; }
+
 private slots:
     void onPageSelectionChanged(int currentRow);
     void onPageDoubleClicked(QListWidgetItem *item);
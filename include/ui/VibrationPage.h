@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QMap>
 #include <QVector>
+#include <QTimer>
 #include "qcustomplot.h"
 #include "dataACQ/DataTypes.h"
 
@@ -19,11 +20,14 @@ struct DataBlock;
  * @brief 振动数据实时监测页面
  *
  * 功能：
- * 1. 显示3通道振动波形（X, Y, Z轴）
+ * 1. 显示3通道振动波形（X, Y, Z轴）；多卡时通过下拉框选择显示哪张卡
  * 2. 控制采集启动/停止/暂停
  * 3. 实时刷新波形显示
  * 4. 显示采集状态和统计信息
  *
+ * 数据获取：按显示刷新节奏从各卡的UI环形队列拉取数据块（不逐块排队接收信号），
+ * 持续无数据时停止轮询，由Worker的blocksAvailable唤醒。
+ *
  * 注意：
  * - 不包含数据库查询功能（后续统一实现）
  * - 通过AcquisitionManager管理VibrationWorker
@@ -47,8 +51,11 @@ private slots:
     void onStartClicked();
     void onStopClicked();
     void onPauseClicked();
+    void onDisplayCardChanged(int cardIndex);
 
     // 数据处理槽函数
+    void onBlocksAvailable();
+    void drainUiRings();
     void onDataBlockReceived(const DataBlock &block);
 
     // 状态更新槽函数
@@ -59,18 +66,27 @@ private:
     void setupUI();
     void setupConnections();
     void initializePlots();
+    void appendChannelData(int channelId, const float *floatData, int numSamples, double sampleRate);
     void updatePlot(int channelId, const QVector<double> &timeData, const QVector<double> &valueData);
     void clearAllPlots();
+    void updateChannelTitles();
 
 private:
+    static constexpr int UI_DRAIN_INTERVAL_MS = 50;     // 拉取周期（显示刷新节奏）
+    static constexpr int UI_IDLE_TICKS = 40;            // 连续无数据的周期数（约2秒，长于最长块时长）后停止轮询
+
     Ui::VibrationPage *ui;
     AcquisitionManager *m_acquisitionManager;
-    VibrationWorker *m_vibrationWorker;  // 从AcquisitionManager获取
+    VibrationWorker *m_vibrationWorker;  // 从AcquisitionManager获取（第一张卡，驱动状态显示）
+    QList<VibrationWorker*> m_vibrationWorkers;     // 所有采集卡
+    int m_displayCard;           // 当前显示的采集卡（按配置顺序）
+    QTimer *m_drainTimer;        // UI环形队列拉取定时器
+    int m_idleDrainTicks;        // 连续无数据的拉取周期数
 
     // 图表控件（3通道）
     QCustomPlot *m_plots[3];
 
-    // 数据缓存用于显示（每个通道保留最新的一批数据用于绘图）
+    // 数据缓存用于显示（每个通道滚动保留最近1秒数据用于绘图）
     QMap<int, QVector<double>> m_channelTimeData;   // 通道ID -> 时间数据
     QMap<int, QVector<double>> m_channelValueData;  // 通道ID -> 数值数据
 
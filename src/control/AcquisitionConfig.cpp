@@ -0,0 +1,134 @@
+#include "control/AcquisitionConfig.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+AcquisitionConfig::AcquisitionConfig()
+{
+}
+
+AcquisitionConfig AcquisitionConfig::defaultConfig()
+{
+    AcquisitionConfig config;
+    config.m_vibrationCardIds = {0};
+    return config;
+}
+
+QString AcquisitionConfig::locateConfigFile()
+{
+    const QStringList candidates = {
+        QCoreApplication::applicationDirPath() + "/config/acquisition.json",     // 可执行文件目录
+        QCoreApplication::applicationDirPath() + "/../config/acquisition.json",  // 上级目录
+        "../config/acquisition.json",                                             // 相对路径
+        "config/acquisition.json"                                                 // 当前目录
+    };
+
+    for (const QString &path : candidates) {
+        if (QFileInfo::exists(path)) {
+            return path;
+        }
+    }
+    return QString();
+}
+
+bool AcquisitionConfig::loadFromFile(const QString &filePath, QString *errorMessage)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorMessage) {
+            *errorMessage = QString("无法打开采集配置文件: %1").arg(filePath);
+        }
+        return false;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    file.close();
+
+    if (parseError.error != QJsonParseError::NoError) {
+        if (errorMessage) {
+            *errorMessage = QString("JSON解析错误: %1").arg(parseError.errorString());
+        }
+        return false;
+    }
+
+    if (!doc.isObject()) {
+        if (errorMessage) {
+            *errorMessage = "采集配置文件格式错误：根节点必须是对象";
+        }
+        return false;
+    }
+
+    if (!loadFromJson(doc.object(), errorMessage)) {
+        return false;
+    }
+
+    m_sourcePath = filePath;
+    return true;
+}
+
+bool AcquisitionConfig::loadFromJson(const QJsonObject &root, QString *errorMessage)
+{
+    auto fail = [errorMessage](const QString &message) {
+        if (errorMessage) {
+            *errorMessage = message;
+        }
+        return false;
+    };
+
+    QList<int> cardIds;
+    const QJsonArray cards = root.value("vibration_cards").toArray();
+    for (const QJsonValue &value : cards) {
+        const int cardId = value.toObject().value("card_id").toInt(-1);
+        if (cardId < 0 || cardId >= MAX_VIBRATION_CARDS) {
+            return fail(QString("vibration_cards: 无效卡号 %1（应为0-%2）")
+                        .arg(cardId).arg(MAX_VIBRATION_CARDS - 1));
+        }
+        if (cardIds.contains(cardId)) {
+            return fail(QString("vibration_cards: 卡号 %1 重复").arg(cardId));
+        }
+        cardIds.append(cardId);
+    }
+    if (cardIds.isEmpty()) {
+        return fail("vibration_cards: 至少需要一张采集卡");
+    }
+
+    QMap<QString, ThreadPolicy> policies;
+    const QJsonObject threads = root.value("threads").toObject();
+    for (auto it = threads.constBegin(); it != threads.constEnd(); ++it) {
+        if (it.key().startsWith('_')) {
+            continue;   // 注释字段
+        }
+        ThreadPolicy policy;
+        QString policyError;
+        if (!ThreadPolicy::fromJson(it.value().toObject(), policy, &policyError)) {
+            return fail(QString("threads.%1: %2").arg(it.key(), policyError));
+        }
+        policies.insert(it.key(), policy);
+    }
+
+    DbStoragePolicy storagePolicy;
+    QString storageError;
+    if (!DbStoragePolicy::fromJson(root.value("database").toObject(), storagePolicy, &storageError)) {
+        return fail(QString("database: %1").arg(storageError));
+    }
+
+    m_vibrationCardIds = cardIds;
+    m_threadPolicies = policies;
+    m_storagePolicy = storagePolicy;
+    return true;
+}
+
+ThreadPolicy AcquisitionConfig::threadPolicy(const QString &role, const QString &fallbackRole) const
+{
+    if (m_threadPolicies.contains(role)) {
+        return m_threadPolicies.value(role);
+    }
+    if (!fallbackRole.isEmpty() && m_threadPolicies.contains(fallbackRole)) {
+        return m_threadPolicies.value(fallbackRole);
+    }
+    return ThreadPolicy();
+}
@@ -3,23 +3,31 @@
 #include "dataACQ/VibrationWorker.h"
 #include "dataACQ/MdbWorker.h"
 #include "dataACQ/MotorWorker.h"
+#include "dataACQ/ReplayWorker.h"
+#include "dataACQ/SyntheticWorker.h"
 #include "database/DbWriter.h"
 #include <QDebug>
 #include <QDateTime>
 
 AcquisitionManager::AcquisitionManager(QObject *parent)
     : QObject(parent)
-    , m_vibrationWorker(nullptr)
     , m_mdbWorker(nullptr)
     , m_motorWorker(nullptr)
     , m_dbWriter(nullptr)
-    , m_vibrationThread(nullptr)
+    , m_replayMdb(nullptr)
+    , m_replayMotor(nullptr)
+    , m_replayRoundId(0)
+    , m_syntheticWorker(nullptr)
+    , m_syntheticVibration(false)
+    , m_mdbRing(nullptr)
+    , m_motorRing(nullptr)
     , m_mdbThread(nullptr)
     , m_motorThread(nullptr)
     , m_dbThread(nullptr)
     , m_currentRoundId(0)
     , m_isRunning(false)
     , m_isInitialized(false)
+    , m_threadReportsPending(0)
 {
     LOG_DEBUG("AcquisitionManager", "Created");
 }
@@ -41,6 +49,9 @@ bool AcquisitionManager::initialize(const QString &dbPath)
 
     m_dbPath = dbPath;
 
+    // 读取硬件布局（振动采集卡数量）
+    loadConfig();
+
     // 创建Worker实例
     setupWorkers();
 
@@ -50,6 +61,9 @@ bool AcquisitionManager::initialize(const QString &dbPath)
     // 连接信号
     connectSignals();
 
+    // 线程名/优先级/CPU绑定（抖动测量在各线程中异步完成）
+    applyThreadPlacement();
+
     m_isInitialized = true;
     LOG_DEBUG("AcquisitionManager", "Initialization complete");
     return true;
@@ -80,12 +94,45 @@ void AcquisitionManager::setupWorkers()
     LOG_DEBUG("AcquisitionManager", "Creating workers...");
 
     // 创建Worker实例（在主线程中创建）
-    m_vibrationWorker = new VibrationWorker();
+    // 每张振动采集卡一个Worker，全局通道号按配置顺序分段，互不重叠
+    const QList<int> &cardIds = m_config.vibrationCardIds();
+    for (int i = 0; i < cardIds.size(); ++i) {
+        VibrationCard card;
+        card.worker = new VibrationWorker();
+        card.worker->setCardId(cardIds[i]);
+        card.worker->setChannelBase(i * VIBRATION_CHANNELS_PER_CARD);
+        // 振动流式模式：100ms/块，降低实时曲线延迟（DbWriter按1秒窗口合并落盘）
+        card.worker->setBlockDurationMs(VIBRATION_BLOCK_DURATION_MS);
+        card.replay = new ReplayWorker(ReplayWorker::Stream::Vibration);
+        card.replay->setVibrationChannels(i * VIBRATION_CHANNELS_PER_CARD, VIBRATION_CHANNELS_PER_CARD);
+        card.replay->setBlockDurationMs(VIBRATION_BLOCK_DURATION_MS);
+        m_vibrationCards.append(card);
+    }
     m_mdbWorker = new MdbWorker();
     m_motorWorker = new MotorWorker();
     m_dbWriter = new DbWriter(m_dbPath);
+    // 持久性档位/振动存储方式和延迟统计在initialize之前设置（initialize按此执行PRAGMA并启动检查点线程）
+    m_dbWriter->setStoragePolicy(m_config.storagePolicy());
+    m_dbWriter->setPipelineLatency(&m_pipelineLatency);
+    m_replayMdb = new ReplayWorker(ReplayWorker::Stream::Mdb);
+    m_replayMotor = new ReplayWorker(ReplayWorker::Stream::Motor);
+    m_syntheticWorker = new SyntheticWorker();
+
+    m_syntheticWorker->setBlockDurationMs(VIBRATION_BLOCK_DURATION_MS);
+
+    // 创建无锁输出通道，容量按各Worker的块速率预留约2秒余量
+    // 振动：每卡1个打包块 × 10次/秒；MDB：4块/tick @ ≤100Hz；电机：1个快照块/tick @ ≤100Hz（另加高速采集块）
+    // 振动写入额度：DbWriter落后时VibrationWorker提前降级（包络抽取/只写摘要），而不是等环形队列满后丢块
+    // 振动另有一条到UI的通道：VibrationPage按显示刷新节奏拉取，不再逐块排队发射dataBlockReady
+    for (VibrationCard &card : m_vibrationCards) {
+        card.ring = new DataBlockRing(256);
+        card.uiRing = new DataBlockRing(VIBRATION_UI_RING_CAPACITY);
+        card.credits = new CreditGate(VIBRATION_WRITE_CREDITS);
+    }
+    m_mdbRing = new DataBlockRing(1024);
+    m_motorRing = new DataBlockRing(1024);
 
-    LOG_DEBUG("AcquisitionManager", "Workers created");
+    LOG_DEBUG_STREAM("AcquisitionManager") << "Workers created, vibration cards:" << m_config.vibrationCardIds();
 }
 
 void AcquisitionManager::setupThreads()
@@ -93,25 +140,43 @@ void AcquisitionManager::setupThreads()
     LOG_DEBUG("AcquisitionManager", "Setting up threads...");
 
     // 创建线程
-    m_vibrationThread = new QThread(this);
+    for (VibrationCard &card : m_vibrationCards) {
+        card.thread = new QThread(this);
+    }
     m_mdbThread = new QThread(this);
     m_motorThread = new QThread(this);
     m_dbThread = new QThread(this);
 
     // 设置线程名称（方便调试）
-    m_vibrationThread->setObjectName("VibrationThread");
+    for (const VibrationCard &card : m_vibrationCards) {
+        card.thread->setObjectName(m_vibrationCards.size() == 1
+                                   ? QString("VibrationThread")
+                                   : QString("VibThread%1").arg(card.worker->cardId()));
+    }
     m_mdbThread->setObjectName("MdbThread");
     m_motorThread->setObjectName("MotorThread");
     m_dbThread->setObjectName("DbThread");
 
     // 将Worker移动到对应线程
-    m_vibrationWorker->moveToThread(m_vibrationThread);
+    for (const VibrationCard &card : m_vibrationCards) {
+        card.worker->moveToThread(card.thread);
+    }
     m_mdbWorker->moveToThread(m_mdbThread);
     m_motorWorker->moveToThread(m_motorThread);
     m_dbWriter->moveToThread(m_dbThread);
 
+    // 回放Worker与被替换的硬件Worker共用线程（两者不会同时运行）
+    for (const VibrationCard &card : m_vibrationCards) {
+        card.replay->moveToThread(card.thread);
+    }
+    m_replayMdb->moveToThread(m_mdbThread);
+    m_replayMotor->moveToThread(m_motorThread);
+    m_syntheticWorker->moveToThread(m_vibrationCards[0].thread);
+
     // 启动线程
-    m_vibrationThread->start();
+    for (const VibrationCard &card : m_vibrationCards) {
+        card.thread->start();
+    }
     m_mdbThread->start();
     m_motorThread->start();
     m_dbThread->start();
@@ -126,19 +191,96 @@ void AcquisitionManager::connectSignals()
 {
     LOG_DEBUG("AcquisitionManager", "Connecting signals...");
 
-    // 连接Worker的dataBlockReady信号到DbWriter
-    connect(m_vibrationWorker, &BaseWorker::dataBlockReady,
-            m_dbWriter, &DbWriter::enqueueDataBlock, Qt::QueuedConnection);
-    connect(m_mdbWorker, &BaseWorker::dataBlockReady,
-            m_dbWriter, &DbWriter::enqueueDataBlock, Qt::QueuedConnection);
-    connect(m_motorWorker, &BaseWorker::dataBlockReady,
-            m_dbWriter, &DbWriter::enqueueDataBlock, Qt::QueuedConnection);
+    // Worker → DbWriter：使用无锁环形队列代替QueuedConnection
+    // 振动Worker → VibrationPage同样走环形队列（blocksAvailable只在UI空闲时唤醒），
+    // MDB/电机的dataBlockReady信号仍然保留给UI页面和AutoDrillManager使用
+    for (const VibrationCard &card : m_vibrationCards) {
+        card.worker->setOutputRing(card.ring);
+        card.worker->setUiRing(card.uiRing);
+        card.worker->setCreditGate(card.credits);
+    }
+    m_mdbWorker->setOutputRing(m_mdbRing);
+    m_motorWorker->setOutputRing(m_motorRing);
+
+    // 回放Worker写入同一通道（任一时刻只有一个生产者在运行，满足SPSC约束），
+    // 数据转发到硬件Worker的信号，UI页面和AutoDrillManager无需重新连接
+    VibrationWorker *primaryVibration = m_vibrationCards[0].worker;
+    QList<QPair<ReplayWorker*, BaseWorker*>> replayPairs;
+    for (const VibrationCard &card : m_vibrationCards) {
+        replayPairs.append({card.replay, card.worker});
+    }
+    replayPairs.append({m_replayMdb, m_mdbWorker});
+    replayPairs.append({m_replayMotor, m_motorWorker});
+    for (const auto &pair : replayPairs) {
+        ReplayWorker *replay = pair.first;
+        BaseWorker *hardware = pair.second;
+        replay->setOutputRing(hardware->outputRing());
+        replay->setUiRing(hardware->uiRing());
+        replay->setCreditGate(hardware->creditGate());
+        connect(replay, &BaseWorker::dataBlockReady, hardware, &BaseWorker::dataBlockReady);
+        connect(replay, &BaseWorker::blocksAvailable, hardware, &BaseWorker::blocksAvailable);
+        connect(replay, &BaseWorker::statisticsUpdated, hardware, &BaseWorker::statisticsUpdated);
+        connect(replay, &BaseWorker::errorOccurred, this,
+                [this](const QString &error) {
+                    emit errorOccurred("ReplayWorker", error);
+                });
+        connect(replay, &BaseWorker::eventOccurred, this,
+                [this](const QString &eventType, const QString &description) {
+                    QMetaObject::invokeMethod(m_dbWriter, "logEvent",
+                        Qt::QueuedConnection,
+                        Q_ARG(int, m_currentRoundId),
+                        Q_ARG(QString, eventType),
+                        Q_ARG(QString, QString("[ReplayWorker] ") + description));
+                });
+    }
 
-    // 连接Worker的错误信号
-    connect(m_vibrationWorker, &BaseWorker::errorOccurred, this,
+    // 合成负载Worker同样替换（第一张卡的）振动Worker接入
+    m_syntheticWorker->setOutputRing(m_vibrationCards[0].ring);
+    m_syntheticWorker->setUiRing(m_vibrationCards[0].uiRing);
+    m_syntheticWorker->setCreditGate(m_vibrationCards[0].credits);
+    connect(m_syntheticWorker, &BaseWorker::dataBlockReady, primaryVibration, &BaseWorker::dataBlockReady);
+    connect(m_syntheticWorker, &BaseWorker::blocksAvailable, primaryVibration, &BaseWorker::blocksAvailable);
+    connect(m_syntheticWorker, &BaseWorker::statisticsUpdated, primaryVibration, &BaseWorker::statisticsUpdated);
+    connect(m_syntheticWorker, &BaseWorker::errorOccurred, this,
             [this](const QString &error) {
-                emit errorOccurred("VibrationWorker", error);
+                emit errorOccurred("SyntheticWorker", error);
+            });
+    connect(m_syntheticWorker, &BaseWorker::eventOccurred, this,
+            [this](const QString &eventType, const QString &description) {
+                QMetaObject::invokeMethod(m_dbWriter, "logEvent",
+                    Qt::QueuedConnection,
+                    Q_ARG(int, m_currentRoundId),
+                    Q_ARG(QString, eventType),
+                    Q_ARG(QString, QString("[SyntheticWorker] ") + description));
             });
+
+    for (const VibrationCard &card : m_vibrationCards) {
+        const QString name = m_vibrationCards.size() == 1
+                             ? QString("Vibration")
+                             : QString("Vibration%1").arg(card.worker->cardId());
+        m_dbWriter->attachRing(name, card.ring, card.credits);
+    }
+    m_dbWriter->attachRing("MDB", m_mdbRing);
+    m_dbWriter->attachRing("Motor", m_motorRing);
+
+    // 连接Worker的错误信号和事件信号（多卡时以卡号区分来源）
+    for (const VibrationCard &card : m_vibrationCards) {
+        const QString workerName = m_vibrationCards.size() == 1
+                                   ? QString("VibrationWorker")
+                                   : QString("VibrationWorker#%1").arg(card.worker->cardId());
+        connect(card.worker, &BaseWorker::errorOccurred, this,
+                [this, workerName](const QString &error) {
+                    emit errorOccurred(workerName, error);
+                });
+        connect(card.worker, &BaseWorker::eventOccurred, this,
+                [this, workerName](const QString &eventType, const QString &description) {
+                    QMetaObject::invokeMethod(m_dbWriter, "logEvent",
+                        Qt::QueuedConnection,
+                        Q_ARG(int, m_currentRoundId),
+                        Q_ARG(QString, eventType),
+                        Q_ARG(QString, QString("[%1] ").arg(workerName) + description));
+                });
+    }
     connect(m_mdbWorker, &BaseWorker::errorOccurred, this,
             [this](const QString &error) {
                 emit errorOccurred("MdbWorker", error);
@@ -149,14 +291,6 @@ void AcquisitionManager::connectSignals()
             });
 
     // 连接Worker的事件信号到DbWriter
-    connect(m_vibrationWorker, &BaseWorker::eventOccurred, this,
-            [this](const QString &eventType, const QString &description) {
-                QMetaObject::invokeMethod(m_dbWriter, "logEvent",
-                    Qt::QueuedConnection,
-                    Q_ARG(int, m_currentRoundId),
-                    Q_ARG(QString, eventType),
-                    Q_ARG(QString, QString("[VibrationWorker] ") + description));
-            });
     connect(m_mdbWorker, &BaseWorker::eventOccurred, this,
             [this](const QString &eventType, const QString &description) {
                 QMetaObject::invokeMethod(m_dbWriter, "logEvent",
@@ -183,14 +317,244 @@ void AcquisitionManager::connectSignals()
     // 连接DbWriter的统计信号
     connect(m_dbWriter, &DbWriter::statisticsUpdated, this,
             [this](qint64 totalBlocks, int queueSize) {
-                QString info = QString("DB: %1 blocks written, Queue: %2")
-                               .arg(totalBlocks).arg(queueSize);
-                emit statisticsUpdated(info);
+                m_dbStatsInfo = QString("DB: %1 blocks written, Queue: %2")
+                                .arg(totalBlocks).arg(queueSize);
+                emitStatistics();
+            });
+
+    // 连接环形队列统计信号
+    connect(m_dbWriter, &DbWriter::ringMetricsUpdated, this,
+            [this](const QString &name, int occupancy, int highWaterMark,
+                   int capacity, qint64 dropped) {
+                m_ringStatsInfo[name] = QString("%1 %2/%3 HWM %4 Drop %5")
+                                        .arg(name).arg(occupancy).arg(capacity)
+                                        .arg(highWaterMark).arg(dropped);
+                emitStatistics();
+            });
+
+    // 连接管线延迟摘要信号
+    connect(m_dbWriter, &DbWriter::latencyMetricsUpdated, this,
+            [this](const QString &summary) {
+                m_latencyStatsInfo = summary;
+                emitStatistics();
+            });
+
+    // 连接WAL检查点统计信号
+    connect(m_dbWriter, &DbWriter::walMetricsUpdated, this,
+            [this](const QString &summary) {
+                m_walStatsInfo = summary;
+                emitStatistics();
             });
 
     LOG_DEBUG("AcquisitionManager", "Signals connected");
 }
 
+void AcquisitionManager::applyThreadPlacement()
+{
+    struct Target {
+        QObject *context;       // 运行在目标线程中的对象
+        QString name;
+        ThreadPolicy policy;
+    };
+
+    QList<Target> targets;
+    for (const VibrationCard &card : m_vibrationCards) {
+        targets.append({card.worker, card.thread->objectName(),
+                        m_config.threadPolicy(QString("vibration%1").arg(card.worker->cardId()), "vibration")});
+    }
+    targets.append({m_mdbWorker, m_mdbThread->objectName(), m_config.threadPolicy("mdb")});
+    targets.append({m_motorWorker, m_motorThread->objectName(), m_config.threadPolicy("motor")});
+    targets.append({m_dbWriter, m_dbThread->objectName(), m_config.threadPolicy("db")});
+
+    m_threadReports.clear();
+    m_threadReportsPending = targets.size();
+
+    for (const Target &target : targets) {
+        // 调度设置只能在目标线程内对自身生效，阻塞等待结果
+        ThreadPlacementReport report;
+        const QString name = target.name;
+        const ThreadPolicy policy = target.policy;
+        QMetaObject::invokeMethod(target.context, [&report, name, policy]() {
+            report = ThreadPlacement::applyToCurrentThread(name, policy);
+        }, Qt::BlockingQueuedConnection);
+
+        // 唤醒抖动用目标线程上的精确定时器并行测量（不阻塞其事件循环），结果回到主线程汇总
+        QObject *context = target.context;
+        QMetaObject::invokeMethod(context, [this, report, context]() {
+            ThreadPlacement::startWakeJitterProbe(report, JITTER_PROBE_PERIOD_MS, JITTER_PROBE_SAMPLES, context,
+                [this](const ThreadPlacementReport &measured) {
+                    QMetaObject::invokeMethod(this, [this, measured]() {
+                        onThreadPlacementMeasured(measured);
+                    }, Qt::QueuedConnection);
+                });
+        }, Qt::QueuedConnection);
+    }
+}
+
+void AcquisitionManager::onThreadPlacementMeasured(const ThreadPlacementReport &report)
+{
+    m_threadReports.append(report);
+    if (--m_threadReportsPending > 0) {
+        return;
+    }
+
+    LOG_INFO_STREAM("AcquisitionManager") << "Thread placement report"
+                                          << (m_config.sourcePath().isEmpty() ? QString("(built-in default)")
+                                                                              : "(" + m_config.sourcePath() + ")")
+                                          << ":";
+    for (const QString &line : threadPlacementReport()) {
+        LOG_INFO_STREAM("AcquisitionManager") << "  " << line;
+    }
+}
+
+QStringList AcquisitionManager::threadPlacementReport() const
+{
+    QStringList lines;
+    for (const ThreadPlacementReport &report : m_threadReports) {
+        lines << report.summary();
+    }
+    return lines;
+}
+
+void AcquisitionManager::setReplaySource(int roundId, double speed, const QString &dbPath)
+{
+    if (m_isRunning) {
+        LOG_WARNING("AcquisitionManager", "Cannot change replay source while acquisition is running");
+        return;
+    }
+    if (!m_isInitialized) {
+        LOG_WARNING("AcquisitionManager", "Not initialized");
+        return;
+    }
+
+    m_replayRoundId = qMax(0, roundId);
+    const QString sourcePath = dbPath.isEmpty() ? m_dbPath : dbPath;
+    QList<ReplayWorker*> replays = {m_replayMdb, m_replayMotor};
+    for (const VibrationCard &card : m_vibrationCards) {
+        replays.append(card.replay);
+    }
+    for (ReplayWorker *replay : replays) {
+        replay->setSource(sourcePath, m_replayRoundId);
+        replay->setSpeed(speed);
+    }
+
+    if (isReplayMode()) {
+        LOG_INFO_STREAM("AcquisitionManager") << "Replay mode: round" << m_replayRoundId << "from" << sourcePath
+                                              << "speed" << (speed > 0 ? QString("%1x").arg(speed) : QString("max"));
+    } else {
+        LOG_INFO("AcquisitionManager", "Replay mode off, using hardware workers");
+    }
+}
+
+void AcquisitionManager::setSyntheticVibration(bool enabled)
+{
+    if (m_isRunning) {
+        LOG_WARNING("AcquisitionManager", "Cannot change vibration source while acquisition is running");
+        return;
+    }
+    if (!m_isInitialized) {
+        LOG_WARNING("AcquisitionManager", "Not initialized");
+        return;
+    }
+
+    m_syntheticVibration = enabled;
+    if (enabled) {
+        LOG_INFO_STREAM("AcquisitionManager") << "Synthetic vibration load:" << m_syntheticWorker->sampleRate()
+                                              << "Hz x" << m_syntheticWorker->channelCount() << "channels";
+    } else {
+        LOG_INFO("AcquisitionManager", "Synthetic vibration load off");
+    }
+}
+
+void AcquisitionManager::loadConfig()
+{
+    const QString path = AcquisitionConfig::locateConfigFile();
+
+    if (path.isEmpty()) {
+        m_config = AcquisitionConfig::defaultConfig();
+        LOG_DEBUG("AcquisitionManager", "Acquisition config not found, using built-in default (1 VK701 card)");
+        return;
+    }
+
+    AcquisitionConfig config;
+    QString errorMessage;
+    if (config.loadFromFile(path, &errorMessage)) {
+        m_config = config;
+        LOG_DEBUG_STREAM("AcquisitionManager") << "Acquisition config loaded from" << path;
+    } else {
+        m_config = AcquisitionConfig::defaultConfig();
+        LOG_WARNING_STREAM("AcquisitionManager") << "Failed to load acquisition config" << path << ":" << errorMessage
+                                                 << "- using built-in default (1 VK701 card)";
+    }
+}
+
+VibrationWorker *AcquisitionManager::vibrationWorker(int cardIndex) const
+{
+    if (cardIndex < 0 || cardIndex >= m_vibrationCards.size()) {
+        return nullptr;
+    }
+    return m_vibrationCards[cardIndex].worker;
+}
+
+QList<VibrationWorker*> AcquisitionManager::vibrationWorkers() const
+{
+    QList<VibrationWorker*> workers;
+    for (const VibrationCard &card : m_vibrationCards) {
+        workers.append(card.worker);
+    }
+    return workers;
+}
+
+QList<BaseWorker*> AcquisitionManager::vibrationSources() const
+{
+    // 合成负载只替换第一张卡，其余卡的硬件在该模式下不启动；回放按卡替换
+    if (m_syntheticVibration) {
+        return { m_syntheticWorker };
+    }
+    QList<BaseWorker*> sources;
+    for (const VibrationCard &card : m_vibrationCards) {
+        sources.append(isReplayMode() ? static_cast<BaseWorker*>(card.replay) : card.worker);
+    }
+    return sources;
+}
+
+BaseWorker *AcquisitionManager::mdbSource() const
+{
+    return isReplayMode() ? static_cast<BaseWorker*>(m_replayMdb) : m_mdbWorker;
+}
+
+BaseWorker *AcquisitionManager::motorSource() const
+{
+    return isReplayMode() ? static_cast<BaseWorker*>(m_replayMotor) : m_motorWorker;
+}
+
+QList<BaseWorker*> AcquisitionManager::allWorkers() const
+{
+    QList<BaseWorker*> workers;
+    for (const VibrationCard &card : m_vibrationCards) {
+        workers << card.worker << card.replay;
+    }
+    workers << m_mdbWorker << m_motorWorker
+            << m_replayMdb << m_replayMotor << m_syntheticWorker;
+    return workers;
+}
+
+void AcquisitionManager::emitStatistics()
+{
+    QString info = m_dbStatsInfo;
+    if (!m_ringStatsInfo.isEmpty()) {
+        QStringList rings = m_ringStatsInfo.values();
+        info += QString(" | Ring: %1").arg(rings.join(", "));
+    }
+    if (!m_latencyStatsInfo.isEmpty()) {
+        info += QString(" | Latency: %1").arg(m_latencyStatsInfo);
+    }
+    if (!m_walStatsInfo.isEmpty()) {
+        info += QString(" | WAL: %1").arg(m_walStatsInfo);
+    }
+    emit statisticsUpdated(info);
+}
+
 void AcquisitionManager::cleanupThreads()
 {
     LOG_DEBUG("AcquisitionManager", "Cleaning up threads...");
@@ -212,10 +576,14 @@ void AcquisitionManager::cleanupThreads()
         }
     };
 
-    // 先停止Worker线程
-    stopThread(m_vibrationThread, m_vibrationWorker, "Vibration");
-    stopThread(m_mdbThread, m_mdbWorker, "MDB");
-    stopThread(m_motorThread, m_motorWorker, "Motor");
+    // 先停止Worker线程（合成负载运行在第一张卡的线程中，回放Worker运行在各自卡的线程中）
+    const QList<BaseWorker*> vibrationRunning = vibrationSources();
+    for (int i = 0; i < m_vibrationCards.size(); ++i) {
+        BaseWorker *worker = (i < vibrationRunning.size()) ? vibrationRunning[i] : m_vibrationCards[i].worker;
+        stopThread(m_vibrationCards[i].thread, worker, m_vibrationCards[i].thread->objectName());
+    }
+    stopThread(m_mdbThread, mdbSource(), "MDB");
+    stopThread(m_motorThread, motorSource(), "Motor");
 
     // 最后停止DbWriter线程（确保所有数据写完）
     if (m_dbThread && m_dbThread->isRunning()) {
@@ -230,11 +598,33 @@ void AcquisitionManager::cleanupThreads()
         LOG_DEBUG("AcquisitionManager", "  DbWriter thread stopped");
     }
 
+    // 线程已停止，注销并销毁环形队列
+    if (m_dbWriter) {
+        m_dbWriter->detachRings();
+    }
+    for (VibrationCard &card : m_vibrationCards) {
+        delete card.ring;
+        delete card.uiRing;
+        delete card.credits;
+        card.ring = nullptr;
+        card.uiRing = nullptr;
+        card.credits = nullptr;
+    }
+    delete m_mdbRing;
+    delete m_motorRing;
+    m_mdbRing = nullptr;
+    m_motorRing = nullptr;
+
     // 删除Worker
-    if (m_vibrationWorker) {
-        m_vibrationWorker->deleteLater();
-        m_vibrationWorker = nullptr;
+    for (VibrationCard &card : m_vibrationCards) {
+        if (card.worker) {
+            card.worker->deleteLater();
+        }
+        if (card.replay) {
+            card.replay->deleteLater();
+        }
     }
+    m_vibrationCards.clear();
     if (m_mdbWorker) {
         m_mdbWorker->deleteLater();
         m_mdbWorker = nullptr;
@@ -243,6 +633,16 @@ void AcquisitionManager::cleanupThreads()
         m_motorWorker->deleteLater();
         m_motorWorker = nullptr;
     }
+    for (ReplayWorker **replay : {&m_replayMdb, &m_replayMotor}) {
+        if (*replay) {
+            (*replay)->deleteLater();
+            *replay = nullptr;
+        }
+    }
+    if (m_syntheticWorker) {
+        m_syntheticWorker->deleteLater();
+        m_syntheticWorker = nullptr;
+    }
     if (m_dbWriter) {
         m_dbWriter->deleteLater();
         m_dbWriter = nullptr;
@@ -275,10 +675,12 @@ void AcquisitionManager::startAll()
         }
     }
 
-    // 启动所有Worker
-    QMetaObject::invokeMethod(m_vibrationWorker, "start", Qt::QueuedConnection);
-    QMetaObject::invokeMethod(m_mdbWorker, "start", Qt::QueuedConnection);
-    QMetaObject::invokeMethod(m_motorWorker, "start", Qt::QueuedConnection);
+    // 启动所有Worker（回放模式下为回放Worker）
+    for (BaseWorker *worker : vibrationSources()) {
+        QMetaObject::invokeMethod(worker, "start", Qt::QueuedConnection);
+    }
+    QMetaObject::invokeMethod(mdbSource(), "start", Qt::QueuedConnection);
+    QMetaObject::invokeMethod(motorSource(), "start", Qt::QueuedConnection);
 
     m_isRunning = true;
     emit acquisitionStateChanged(true);
@@ -296,9 +698,11 @@ void AcquisitionManager::stopAll()
     }
 
     // 停止所有Worker
-    QMetaObject::invokeMethod(m_vibrationWorker, "stop", Qt::QueuedConnection);
-    QMetaObject::invokeMethod(m_mdbWorker, "stop", Qt::QueuedConnection);
-    QMetaObject::invokeMethod(m_motorWorker, "stop", Qt::QueuedConnection);
+    for (BaseWorker *worker : vibrationSources()) {
+        QMetaObject::invokeMethod(worker, "stop", Qt::QueuedConnection);
+    }
+    QMetaObject::invokeMethod(mdbSource(), "stop", Qt::QueuedConnection);
+    QMetaObject::invokeMethod(motorSource(), "stop", Qt::QueuedConnection);
 
     // 等待队列完全处理，确保所有数据都写入数据库
     QMetaObject::invokeMethod(m_dbWriter, "flushQueue", Qt::BlockingQueuedConnection);
@@ -320,38 +724,48 @@ void AcquisitionManager::stopAll()
 
 void AcquisitionManager::startVibration()
 {
-    LOG_DEBUG("AcquisitionManager", "Starting vibration worker...");
-    QMetaObject::invokeMethod(m_vibrationWorker, "start", Qt::QueuedConnection);
+    LOG_DEBUG("AcquisitionManager", "Starting vibration worker(s)...");
+    for (BaseWorker *worker : vibrationSources()) {
+        QMetaObject::invokeMethod(worker, "start", Qt::QueuedConnection);
+    }
 }
 
 void AcquisitionManager::startMdb()
 {
     LOG_DEBUG("AcquisitionManager", "Starting MDB worker...");
-    QMetaObject::invokeMethod(m_mdbWorker, "start", Qt::QueuedConnection);
+    QMetaObject::invokeMethod(mdbSource(), "start", Qt::QueuedConnection);
 }
 
 void AcquisitionManager::startMotor()
 {
     LOG_DEBUG("AcquisitionManager", "Starting motor worker...");
-    QMetaObject::invokeMethod(m_motorWorker, "start", Qt::QueuedConnection);
+    QMetaObject::invokeMethod(motorSource(), "start", Qt::QueuedConnection);
 }
 
 void AcquisitionManager::stopVibration()
 {
-    LOG_DEBUG("AcquisitionManager", "Stopping vibration worker...");
-    QMetaObject::invokeMethod(m_vibrationWorker, "stop", Qt::QueuedConnection);
+    LOG_DEBUG("AcquisitionManager", "Stopping vibration worker(s)...");
+    for (BaseWorker *worker : vibrationSources()) {
+        QMetaObject::invokeMethod(worker, "stop", Qt::QueuedConnection);
+    }
 }
 
 void AcquisitionManager::stopMdb()
 {
     LOG_DEBUG("AcquisitionManager", "Stopping MDB worker...");
-    QMetaObject::invokeMethod(m_mdbWorker, "stop", Qt::QueuedConnection);
+    QMetaObject::invokeMethod(mdbSource(), "stop", Qt::QueuedConnection);
 }
 
 void AcquisitionManager::stopMotor()
 {
     LOG_DEBUG("AcquisitionManager", "Stopping motor worker...");
-    QMetaObject::invokeMethod(m_motorWorker, "stop", Qt::QueuedConnection);
+    QMetaObject::invokeMethod(motorSource(), "stop", Qt::QueuedConnection);
+}
+
+void AcquisitionManager::startMotorCapture()
+{
+    LOG_DEBUG("AcquisitionManager", "Starting motor high-rate capture...");
+    QMetaObject::invokeMethod(m_motorWorker, "startCapture", Qt::QueuedConnection);
 }
 
 void AcquisitionManager::startNewRound(const QString &operatorName, const QString &note)
@@ -387,19 +801,17 @@ void AcquisitionManager::startNewRound(const QString &operatorName, const QStrin
 
     // 同步设置时间基准，确保所有Worker在启动前都有统一的时间基准
     const qint64 baseTimestampUs = QDateTime::currentMSecsSinceEpoch() * 1000;
-    QMetaObject::invokeMethod(m_vibrationWorker, "setTimeBase", Qt::BlockingQueuedConnection,
-                              Q_ARG(qint64, baseTimestampUs));
-    QMetaObject::invokeMethod(m_mdbWorker, "setTimeBase", Qt::BlockingQueuedConnection,
-                              Q_ARG(qint64, baseTimestampUs));
-    QMetaObject::invokeMethod(m_motorWorker, "setTimeBase", Qt::BlockingQueuedConnection,
-                              Q_ARG(qint64, baseTimestampUs));
+    for (BaseWorker *worker : allWorkers()) {
+        QMetaObject::invokeMethod(worker, "setTimeBase", Qt::BlockingQueuedConnection,
+                                  Q_ARG(qint64, baseTimestampUs));
+    }
 
     LOG_DEBUG_STREAM("AcquisitionManager") << "Time base synchronized for all workers:" << baseTimestampUs;
 
     // 通知所有Worker新的轮次ID
-    QMetaObject::invokeMethod(m_vibrationWorker, "setRoundId", Qt::QueuedConnection, Q_ARG(int, roundId));
-    QMetaObject::invokeMethod(m_mdbWorker, "setRoundId", Qt::QueuedConnection, Q_ARG(int, roundId));
-    QMetaObject::invokeMethod(m_motorWorker, "setRoundId", Qt::QueuedConnection, Q_ARG(int, roundId));
+    for (BaseWorker *worker : allWorkers()) {
+        QMetaObject::invokeMethod(worker, "setRoundId", Qt::QueuedConnection, Q_ARG(int, roundId));
+    }
 
     emit roundChanged(m_currentRoundId);
 
@@ -456,6 +456,23 @@ void AutoDrillManager::onDataBlockReceived(const DataBlock& block)
 
     // 根据传感器类型收集原始数据
     switch (block.sensorType) {
+    case SensorType::Motor_Snapshot: {
+        // 电机快照：深度/速度取进给机构电机，一个tick只评估一次
+        const int feedMotor = Mechanism::getMotorIndex(Mechanism::Fz);
+        const double depth = block.snapshotValue(MotorSnapshot::Position, feedMotor);
+        const double velocity = block.snapshotValue(MotorSnapshot::Speed, feedMotor);
+        if (qIsNaN(depth) && qIsNaN(velocity)) {
+            return;
+        }
+        if (!qIsNaN(depth)) {
+            m_lastDepthMm = depth;
+        }
+        if (!qIsNaN(velocity)) {
+            m_lastVelocityMmPerMin = velocity;
+        }
+        break;
+    }
+
     case SensorType::Torque_MDB:
         m_lastTorqueNm = latestValue;
         break;
@@ -469,10 +486,17 @@ void AutoDrillManager::onDataBlockReceived(const DataBlock& block)
         break;
 
     case SensorType::Motor_Position:
+        // 单参数电机块（如高速采集）：只取进给机构电机
+        if (block.channelId != Mechanism::getMotorIndex(Mechanism::Fz)) {
+            return;
+        }
         m_lastDepthMm = latestValue;
         break;
 
     case SensorType::Motor_Speed:
+        if (block.channelId != Mechanism::getMotorIndex(Mechanism::Fz)) {
+            return;
+        }
         m_lastVelocityMmPerMin = latestValue;
         break;
 
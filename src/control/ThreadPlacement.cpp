@@ -0,0 +1,281 @@
+#include "control/ThreadPlacement.h"
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QStringList>
+#include <QTimer>
+#include <memory>
+
+#if defined(Q_OS_LINUX)
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#endif
+
+// ==================================================
+// ThreadPolicy
+// ==================================================
+
+bool ThreadPolicy::fromJson(const QJsonObject &json, ThreadPolicy &policy, QString *errorMessage)
+{
+    auto fail = [errorMessage](const QString &message) {
+        if (errorMessage) {
+            *errorMessage = message;
+        }
+        return false;
+    };
+
+    policy = ThreadPolicy();
+
+    const QString priority = json.value("priority").toString("inherit").toLower();
+    if (priority == "inherit") {
+        policy.priority = Priority::Inherit;
+    } else if (priority == "normal") {
+        policy.priority = Priority::Normal;
+    } else if (priority == "high") {
+        policy.priority = Priority::High;
+    } else if (priority == "realtime") {
+        policy.priority = Priority::RealTime;
+    } else {
+        return fail(QString("未知的线程优先级: %1（inherit | normal | high | realtime）").arg(priority));
+    }
+
+    policy.realtimePriority = json.value("rt_priority").toInt(50);
+    if (policy.realtimePriority < 1 || policy.realtimePriority > 99) {
+        return fail(QString("rt_priority超出范围: %1（1-99）").arg(policy.realtimePriority));
+    }
+
+    for (const QJsonValue &value : json.value("cpus").toArray()) {
+        const int cpu = value.toInt(-1);
+        if (cpu < 0 || cpu >= 64) {
+            return fail(QString("无效CPU编号: %1（0-63）").arg(value.toVariant().toString()));
+        }
+        if (!policy.cpus.contains(cpu)) {
+            policy.cpus.append(cpu);
+        }
+    }
+    return true;
+}
+
+QString ThreadPolicy::priorityName(Priority priority)
+{
+    switch (priority) {
+    case Priority::Inherit: return "inherit";
+    case Priority::Normal: return "normal";
+    case Priority::High: return "high";
+    case Priority::RealTime: return "realtime";
+    }
+    return "unknown";
+}
+
+QString ThreadPolicy::describe() const
+{
+    QString text = priorityName(priority);
+    if (priority == Priority::RealTime) {
+        text += QString("(%1)").arg(realtimePriority);
+    }
+    if (!cpus.isEmpty()) {
+        QStringList list;
+        for (int cpu : cpus) {
+            list << QString::number(cpu);
+        }
+        text += " cpu " + list.join(",");
+    }
+    return text;
+}
+
+// ==================================================
+// ThreadPlacementReport
+// ==================================================
+
+QString ThreadPlacementReport::summary() const
+{
+    QString text = QString("%1: requested [%2], priority [%3], affinity [%4], os name %5")
+                   .arg(threadName, -16)
+                   .arg(requested)
+                   .arg(priorityApplied)
+                   .arg(affinityApplied)
+                   .arg(nameApplied ? "ok" : "failed");
+    if (wakeJitter.count() > 0) {
+        text += QString(", wake jitter @%1ms: p50 %2us p99 %3us max %4us")
+                .arg(probePeriodMs)
+                .arg(wakeJitter.percentileUs(50))
+                .arg(wakeJitter.percentileUs(99))
+                .arg(wakeJitter.maxUs());
+    }
+    return text;
+}
+
+// ==================================================
+// ThreadPlacement
+// ==================================================
+
+ThreadPlacementReport ThreadPlacement::applyToCurrentThread(const QString &name, const ThreadPolicy &policy)
+{
+    ThreadPlacementReport report;
+    report.threadName = name;
+    report.requested = policy.describe();
+    report.nameApplied = setCurrentThreadName(name);
+    report.priorityApplied = setCurrentThreadPriority(policy);
+    report.affinityApplied = setCurrentThreadAffinity(policy.cpus);
+    return report;
+}
+
+void ThreadPlacement::startWakeJitterProbe(const ThreadPlacementReport &report, int periodMs, int iterations,
+                                           QObject *parent, std::function<void(const ThreadPlacementReport &)> done)
+{
+    struct ProbeState {
+        ThreadPlacementReport report;
+        QElapsedTimer clock;
+        qint64 lastNs = 0;
+        int remaining = 0;
+    };
+
+    auto state = std::make_shared<ProbeState>();
+    state->report = report;
+    state->report.probePeriodMs = periodMs;
+    state->report.wakeJitter.reset();
+    state->remaining = iterations;
+    if (iterations <= 0) {
+        done(state->report);
+        return;
+    }
+
+    QTimer *timer = new QTimer(parent);
+    timer->setTimerType(Qt::PreciseTimer);
+    timer->setInterval(periodMs);
+    const qint64 periodUs = static_cast<qint64>(periodMs) * 1000;
+    QObject::connect(timer, &QTimer::timeout, timer, [timer, state, periodUs, done]() {
+        // 相邻两次触发的间隔偏离周期的量（提前和推迟都计为抖动）
+        const qint64 nowNs = state->clock.nsecsElapsed();
+        state->report.wakeJitter.record(qAbs((nowNs - state->lastNs) / 1000 - periodUs));
+        state->lastNs = nowNs;
+        if (--state->remaining > 0) {
+            return;
+        }
+        timer->stop();
+        timer->deleteLater();
+        done(state->report);
+    });
+    state->clock.start();
+    timer->start();
+}
+
+bool ThreadPlacement::setCurrentThreadName(const QString &name)
+{
+    const QString osName = name.left(OS_NAME_MAX_LENGTH);
+#if defined(Q_OS_LINUX)
+    return pthread_setname_np(pthread_self(), osName.toUtf8().constData()) == 0;
+#elif defined(Q_OS_WIN)
+    // SetThreadDescription需要Windows 10 1607+，动态解析以兼容旧系统
+    typedef HRESULT (WINAPI *FnSetThreadDescription)(HANDLE, PCWSTR);
+    static const FnSetThreadDescription fnSetThreadDescription = reinterpret_cast<FnSetThreadDescription>(
+        reinterpret_cast<void*>(GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription")));
+    if (!fnSetThreadDescription) {
+        return false;
+    }
+    return SUCCEEDED(fnSetThreadDescription(GetCurrentThread(), reinterpret_cast<PCWSTR>(osName.utf16())));
+#else
+    Q_UNUSED(osName);
+    return false;
+#endif
+}
+
+QString ThreadPlacement::setCurrentThreadPriority(const ThreadPolicy &policy)
+{
+    if (policy.priority == ThreadPolicy::Priority::Inherit) {
+        return "unchanged";
+    }
+
+#if defined(Q_OS_LINUX)
+    // 普通调度下用nice调整（线程级：以线程ID调用setpriority）
+    auto applyNice = [](int nice) -> QString {
+        const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), nice) == 0) {
+            return QString("SCHED_OTHER nice %1").arg(nice);
+        }
+        return QString("nice %1 denied (%2), unchanged").arg(nice).arg(qt_error_string(errno));
+    };
+
+    if (policy.priority == ThreadPolicy::Priority::RealTime) {
+        sched_param param;
+        param.sched_priority = qBound(sched_get_priority_min(SCHED_FIFO), policy.realtimePriority,
+                                      sched_get_priority_max(SCHED_FIFO));
+        const int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc == 0) {
+            return QString("SCHED_FIFO %1").arg(param.sched_priority);
+        }
+        // 无CAP_SYS_NICE / RLIMIT_RTPRIO时退回高优先级普通调度
+        return QString("SCHED_FIFO denied (%1), fallback %2").arg(qt_error_string(rc), applyNice(-10));
+    }
+
+    sched_param param;
+    param.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+    return applyNice(policy.priority == ThreadPolicy::Priority::High ? -10 : 0);
+#elif defined(Q_OS_WIN)
+    auto applyWin = [](int priority, const char *name) -> QString {
+        if (SetThreadPriority(GetCurrentThread(), priority)) {
+            return QString(name);
+        }
+        return QString("%1 denied (%2), unchanged").arg(name).arg(qt_error_string(static_cast<int>(GetLastError())));
+    };
+
+    switch (policy.priority) {
+    case ThreadPolicy::Priority::RealTime: {
+        const QString applied = applyWin(THREAD_PRIORITY_TIME_CRITICAL, "TIME_CRITICAL");
+        return applied == "TIME_CRITICAL" ? applied
+                                          : applied + ", fallback " + applyWin(THREAD_PRIORITY_HIGHEST, "HIGHEST");
+    }
+    case ThreadPolicy::Priority::High:
+        return applyWin(THREAD_PRIORITY_HIGHEST, "HIGHEST");
+    default:
+        return applyWin(THREAD_PRIORITY_NORMAL, "NORMAL");
+    }
+#else
+    return "unsupported on this platform";
+#endif
+}
+
+QString ThreadPlacement::setCurrentThreadAffinity(const QList<int> &cpus)
+{
+    if (cpus.isEmpty()) {
+        return "any";
+    }
+
+    QStringList list;
+    for (int cpu : cpus) {
+        list << QString::number(cpu);
+    }
+    const QString cpuText = "cpu " + list.join(",");
+
+#if defined(Q_OS_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc == 0) {
+        return cpuText;
+    }
+    return QString("%1 denied (%2), any").arg(cpuText, qt_error_string(rc));
+#elif defined(Q_OS_WIN)
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            mask |= static_cast<DWORD_PTR>(1) << cpu;
+        }
+    }
+    if (SetThreadAffinityMask(GetCurrentThread(), mask) != 0) {
+        return cpuText;
+    }
+    return QString("%1 denied (%2), any").arg(cpuText, qt_error_string(static_cast<int>(GetLastError())));
+#else
+    return cpuText + " unsupported on this platform, any";
+#endif
+}
@@ -11,6 +11,13 @@ BaseWorker::BaseWorker(QObject *parent)
     , m_stopRequested(false)
     , m_timeBaseUs(0)
     , m_hasTimeBase(false)
+    , m_outputRing(nullptr)
+    , m_ringDropReported(0)
+    , m_uiRing(nullptr)
+    , m_publishSignalCount(0)
+    , m_creditGate(nullptr)
+    , m_creditDeniedReported(0)
+    , m_hardwareReadUs(0)
     , m_consecutiveFails(0)
     , m_connectionLostReported(false)
 {
@@ -58,6 +65,8 @@ void BaseWorker::start()
         return;
     }
 
+    resetSampleClock();
+
     setState(WorkerState::Running);
 
     // 启动采集循环（子类实现）
@@ -87,6 +96,8 @@ void BaseWorker::stop()
     // 关闭硬件
     shutdownHardware();
 
+    logClockStatistics("stop");
+
     setState(WorkerState::Stopped);
 
     qDebug() << "Worker stopped, total samples collected:" << m_samplesCollected;
@@ -126,6 +137,9 @@ void BaseWorker::resume()
 
 void BaseWorker::setRoundId(int roundId)
 {
+    // 上一轮次的时钟统计（模型保持锁定，不影响时间戳连续性）
+    logClockStatistics("round change");
+
     QMutexLocker locker(&m_mutex);
     m_currentRoundId = roundId;
     qDebug() << "Worker round ID set to:" << roundId;
@@ -150,6 +164,10 @@ void BaseWorker::setTimeBase(qint64 baseTimestampUs)
     m_timeBaseUs = baseTimestampUs;
     m_elapsedTimer.restart();
     m_hasTimeBase = true;
+    locker.unlock();
+
+    // 时间基改变后到达时刻不再连续，时钟模型重新拟合
+    resetSampleClock();
 }
 
 void BaseWorker::setState(WorkerState newState)
@@ -182,3 +200,86 @@ qint64 BaseWorker::currentTimestampUs() const
     }
     return QDateTime::currentMSecsSinceEpoch() * 1000;
 }
+
+qint64 BaseWorker::sampleTimestampUs(int numSamples)
+{
+    return m_sampleClock.onBlock(currentTimestampUs(), numSamples);
+}
+
+void BaseWorker::resetSampleClock()
+{
+    // 保留上一段的统计输出，再以当前采样率重新开始
+    logClockStatistics("reset");
+    m_sampleClock.reset(sampleRate());
+}
+
+void BaseWorker::logClockStatistics(const char *reason)
+{
+    if (m_sampleClock.blockCount() == 0 && m_sampleClock.resyncCount() == 0) {
+        return;
+    }
+
+    qDebug() << metaObject()->className() << "sample clock (" << reason << ", round" << m_currentRoundId << "):"
+             << m_sampleClock.summary();
+    m_sampleClock.resetStatistics();
+}
+
+double BaseWorker::creditLevel() const
+{
+    double level = m_creditGate ? m_creditGate->level() : 1.0;
+    if (m_outputRing) {
+        level = qMin(level, 1.0 - static_cast<double>(m_outputRing->size()) / m_outputRing->capacity());
+    }
+    return level;
+}
+
+void BaseWorker::publishBlock(const DataBlock &source)
+{
+    // 拷贝只增加载荷引用计数；无硬件读取时刻的块以发布时刻为起点
+    DataBlock block = source;
+    block.trace.mark(PipelineTrace::Emitted);
+    if (!block.trace.has(PipelineTrace::HardwareRead)) {
+        block.trace.mark(PipelineTrace::HardwareRead,
+                         m_hardwareReadUs > 0 ? m_hardwareReadUs : block.trace.at(PipelineTrace::Emitted));
+    }
+
+    if (m_outputRing) {
+        const int cost = m_creditGate ? CreditGate::costOf(block) : 0;
+        if (m_creditGate && !m_creditGate->tryAcquire(cost)) {
+            // 额度耗尽：子类未能及时降级，块不进入DbWriter，限频告警（每100块一次）
+            qint64 denied = m_creditGate->deniedCount();
+            if (denied - m_creditDeniedReported >= 100 || m_creditDeniedReported == 0) {
+                m_creditDeniedReported = denied;
+                qWarning() << "Write credits exhausted, denied blocks:" << denied
+                           << "SensorType:" << sensorTypeToString(block.sensorType);
+            }
+        } else {
+            block.trace.mark(PipelineTrace::Enqueued);
+            if (!m_outputRing->tryPush(block)) {
+                // 环形队列满：DbWriter跟不上，丢弃并限频告警（每100块一次）
+                if (m_creditGate) {
+                    m_creditGate->release(cost);
+                }
+                qint64 dropped = m_outputRing->droppedCount();
+                if (dropped - m_ringDropReported >= 100 || m_ringDropReported == 0) {
+                    m_ringDropReported = dropped;
+                    qWarning() << "Output ring full, dropped blocks:" << dropped
+                               << "SensorType:" << sensorTypeToString(block.sensorType);
+                }
+            }
+        }
+    }
+
+    if (m_uiRing) {
+        // UI按显示刷新节奏拉取；队列满说明UI没有在排空，丢弃不影响落盘
+        m_uiRing->tryPush(block);
+        if (m_uiRing->takeNotifyRequest()) {
+            m_publishSignalCount++;
+            emit blocksAvailable();
+        }
+        return;
+    }
+
+    m_publishSignalCount++;
+    emit dataBlockReady(block);
+}
@@ -0,0 +1,242 @@
+#include "dataACQ/BufferPool.h"
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <utility>
+
+/**
+ * @brief 池的共享状态
+ *
+ * 被池本身和所有在外流转的缓冲区共同引用，保证池先于缓冲区销毁时仍然安全。
+ */
+struct BufferPool::State
+{
+    QMutex mutex;
+    QVector<PooledBuffer::Slot*> freeList;
+    int maxFreeBuffers;
+    bool closed;                            // 池已销毁
+    QAtomicInt refs;                        // 1（池本身）+ 现存缓冲区数（空闲和在外流转）
+    QAtomicInteger<qint64> allocations;
+    QAtomicInteger<qint64> acquires;
+
+    void deref()
+    {
+        if (!refs.deref()) {
+            delete this;
+        }
+    }
+};
+
+struct PooledBuffer::Slot
+{
+    QAtomicInt ref;
+    BufferPool::State *pool;
+    char *storage;
+    int capacity;
+    int size;
+
+    ~Slot() { delete[] storage; }
+};
+
+// ==================================================
+// PooledBuffer
+// ==================================================
+
+PooledBuffer::PooledBuffer(const PooledBuffer &other)
+    : m_slot(other.m_slot)
+{
+    if (m_slot) {
+        m_slot->ref.ref();
+    }
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer &&other) noexcept
+    : m_slot(other.m_slot)
+{
+    other.m_slot = nullptr;
+}
+
+PooledBuffer &PooledBuffer::operator=(const PooledBuffer &other)
+{
+    if (m_slot != other.m_slot) {
+        if (other.m_slot) {
+            other.m_slot->ref.ref();
+        }
+        release();
+        m_slot = other.m_slot;
+    }
+    return *this;
+}
+
+PooledBuffer &PooledBuffer::operator=(PooledBuffer &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_slot = other.m_slot;
+        other.m_slot = nullptr;
+    }
+    return *this;
+}
+
+PooledBuffer::~PooledBuffer()
+{
+    release();
+}
+
+char *PooledBuffer::data()
+{
+    return m_slot ? m_slot->storage : nullptr;
+}
+
+const char *PooledBuffer::constData() const
+{
+    return m_slot ? m_slot->storage : nullptr;
+}
+
+int PooledBuffer::size() const
+{
+    return m_slot ? m_slot->size : 0;
+}
+
+void PooledBuffer::setSize(int bytes)
+{
+    if (m_slot) {
+        m_slot->size = qBound(0, bytes, m_slot->capacity);
+    }
+}
+
+int PooledBuffer::capacity() const
+{
+    return m_slot ? m_slot->capacity : 0;
+}
+
+void PooledBuffer::release()
+{
+    if (!m_slot) {
+        return;
+    }
+
+    Slot *slot = m_slot;
+    m_slot = nullptr;
+
+    if (slot->ref.deref()) {
+        return;  // 仍有其他引用
+    }
+
+    // 最后一个引用：归还到池（池已销毁或空闲列表已满则直接删除）
+    BufferPool::State *state = slot->pool;
+    {
+        QMutexLocker locker(&state->mutex);
+        if (!state->closed && state->freeList.size() < state->maxFreeBuffers) {
+            state->freeList.append(slot);
+            return;
+        }
+    }
+
+    delete slot;
+    state->deref();
+}
+
+// ==================================================
+// BufferPool
+// ==================================================
+
+BufferPool::BufferPool(int maxFreeBuffers)
+    : m_state(new State)
+{
+    m_state->maxFreeBuffers = qMax(1, maxFreeBuffers);
+    m_state->closed = false;
+    m_state->refs.storeRelaxed(1);
+    m_state->allocations.storeRelaxed(0);
+    m_state->acquires.storeRelaxed(0);
+
+    // 预留空闲列表容量，归还时不再触发扩容
+    m_state->freeList.reserve(m_state->maxFreeBuffers);
+}
+
+BufferPool::~BufferPool()
+{
+    QVector<PooledBuffer::Slot*> freeSlots;
+    {
+        QMutexLocker locker(&m_state->mutex);
+        m_state->closed = true;
+        freeSlots.swap(m_state->freeList);
+    }
+
+    for (PooledBuffer::Slot *slot : freeSlots) {
+        delete slot;
+        m_state->deref();
+    }
+
+    m_state->deref();
+}
+
+PooledBuffer BufferPool::acquire(int bytes)
+{
+    bytes = qMax(0, bytes);
+    m_state->acquires.fetchAndAddRelaxed(1);
+
+    PooledBuffer::Slot *slot = nullptr;
+    {
+        QMutexLocker locker(&m_state->mutex);
+        if (!m_state->freeList.isEmpty()) {
+            slot = m_state->freeList.takeLast();
+        }
+    }
+
+    if (!slot) {
+        slot = new PooledBuffer::Slot;
+        slot->pool = m_state;
+        slot->storage = nullptr;
+        slot->capacity = 0;
+        m_state->refs.ref();
+        m_state->allocations.fetchAndAddRelaxed(1);
+    }
+
+    if (slot->capacity < bytes) {
+        // 容量不足才重新分配（采样率提高后的首次扩容）
+        delete[] slot->storage;
+        slot->storage = new char[bytes];
+        slot->capacity = bytes;
+        m_state->allocations.fetchAndAddRelaxed(1);
+    }
+
+    slot->size = bytes;
+    slot->ref.storeRelaxed(1);
+    return PooledBuffer(slot);
+}
+
+void BufferPool::reserve(int count, int bytes)
+{
+    QVector<PooledBuffer> warmup;
+    warmup.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        warmup.append(acquire(bytes));
+    }
+    // warmup析构时全部归还到空闲列表
+}
+
+qint64 BufferPool::allocationCount() const
+{
+    return m_state->allocations.loadRelaxed();
+}
+
+qint64 BufferPool::acquireCount() const
+{
+    return m_state->acquires.loadRelaxed();
+}
+
+int BufferPool::freeCount() const
+{
+    QMutexLocker locker(&m_state->mutex);
+    return m_state->freeList.size();
+}
+
+int BufferPool::outstandingCount() const
+{
+    QMutexLocker locker(&m_state->mutex);
+    // refs = 1（池本身）+ 空闲 + 在外流转
+    return m_state->refs.loadRelaxed() - 1 - m_state->freeList.size();
+}
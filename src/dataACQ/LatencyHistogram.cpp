@@ -0,0 +1,98 @@
+#include "dataACQ/LatencyHistogram.h"
+#include <QtAlgorithms>
+
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(BUCKET_COUNT, 0)
+    , m_count(0)
+    , m_sum(0)
+    , m_min(0)
+    , m_max(0)
+{
+}
+
+void LatencyHistogram::record(qint64 latencyUs)
+{
+    if (latencyUs < 0) {
+        latencyUs = 0;
+    }
+
+    m_buckets[bucketIndex(static_cast<quint64>(latencyUs))]++;
+    if (m_count == 0 || latencyUs < m_min) {
+        m_min = latencyUs;
+    }
+    if (latencyUs > m_max) {
+        m_max = latencyUs;
+    }
+    m_sum += latencyUs;
+    m_count++;
+}
+
+void LatencyHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_sum = 0;
+    m_min = 0;
+    m_max = 0;
+}
+
+qint64 LatencyHistogram::percentileUs(double percentile) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    // 第rank个样本（1起）所在的桶，结果限制在[min, max]内
+    const double p = qBound(0.0, percentile, 100.0);
+    qint64 rank = static_cast<qint64>(p / 100.0 * m_count + 0.5);
+    rank = qBound<qint64>(1, rank, m_count);
+
+    qint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return qBound(m_min, static_cast<qint64>(bucketUpperBound(i)), m_max);
+        }
+    }
+    return m_max;
+}
+
+QString LatencyHistogram::summary() const
+{
+    if (m_count == 0) {
+        return QString("n=0");
+    }
+
+    return QString("n=%1 min=%2 p50=%3 p95=%4 p99=%5 max=%6 ms")
+        .arg(m_count)
+        .arg(m_min / 1000.0, 0, 'f', 2)
+        .arg(percentileUs(50) / 1000.0, 0, 'f', 2)
+        .arg(percentileUs(95) / 1000.0, 0, 'f', 2)
+        .arg(percentileUs(99) / 1000.0, 0, 'f', 2)
+        .arg(m_max / 1000.0, 0, 'f', 2);
+}
+
+int LatencyHistogram::bucketIndex(quint64 value)
+{
+    if (value < static_cast<quint64>(SUB_BUCKETS)) {
+        return static_cast<int>(value);
+    }
+
+    // 最高位决定区间，其后SUB_BUCKET_BITS位决定子桶
+    const int msb = 63 - static_cast<int>(qCountLeadingZeroBits(value));
+    const int sub = static_cast<int>((value >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+quint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < SUB_BUCKETS) {
+        return static_cast<quint64>(index);
+    }
+
+    const int msb = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    const int sub = index % SUB_BUCKETS;
+    const int shift = msb - SUB_BUCKET_BITS;
+    const quint64 lower = static_cast<quint64>(SUB_BUCKETS + sub) << shift;
+    return lower + (static_cast<quint64>(1) << shift) - 1;
+}
@@ -0,0 +1,215 @@
+#include "dataACQ/MdbSensorMap.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QDebug>
+#include <algorithm>
+
+bool MdbSensorDef::fromJson(const QJsonObject &json, MdbSensorDef &def, QString *errorMessage)
+{
+    auto fail = [errorMessage](const QString &message) {
+        if (errorMessage) {
+            *errorMessage = message;
+        }
+        return false;
+    };
+
+    def = MdbSensorDef();
+    def.name = json.value("name").toString();
+    def.sensorType = static_cast<SensorType>(json.value("sensor_type").toInt(static_cast<int>(SensorType::Unknown)));
+    def.channelId = json.value("channel").toInt(0);
+    def.deviceIndex = json.value("device_index").toInt(-1);
+    def.unitId = json.value("unit_id").toInt(1);
+    def.registerAddr = json.value("register").toInt(-1);
+    def.numRegisters = json.value("registers").toInt(2);
+    def.highWordFirst = json.value("word_order").toString("high_first") != "low_first";
+    def.negativeWrap = json.value("negative_wrap").toDouble(0.0);
+    def.scale = json.value("scale").toDouble(1.0);
+    def.offset = json.value("offset").toDouble(0.0);
+
+    const QString decode = json.value("decode").toString("int32");
+    if (decode == "int32_twos_complement") {
+        def.decode = Decode::Int32TwosComplement;
+    } else if (decode == "int32") {
+        def.decode = Decode::Int32;
+    } else {
+        return fail(QString("传感器'%1'：未知解码方式 '%2'").arg(def.name, decode));
+    }
+
+    if (def.name.isEmpty()) {
+        return fail("传感器缺少name字段");
+    }
+    if (sensorTypeToString(def.sensorType) == "Unknown") {
+        return fail(QString("传感器'%1'：无效的sensor_type").arg(def.name));
+    }
+    if (def.deviceIndex < 0 || def.deviceIndex >= MdbSensorMap::MAX_DEVICES) {
+        return fail(QString("传感器'%1'：device_index必须在0-%2之间").arg(def.name).arg(MdbSensorMap::MAX_DEVICES - 1));
+    }
+    if (def.registerAddr < 0 || def.registerAddr > 0xFFFF) {
+        return fail(QString("传感器'%1'：无效的寄存器地址").arg(def.name));
+    }
+    if (def.numRegisters != 2) {
+        return fail(QString("传感器'%1'：当前解码方式只支持2个寄存器").arg(def.name));
+    }
+
+    return true;
+}
+
+MdbSensorMap::MdbSensorMap()
+    : m_maxRegisterGap(0)
+{
+}
+
+MdbSensorMap MdbSensorMap::defaultMap()
+{
+    MdbSensorMap map;
+
+    auto add = [&map](const QString &name, SensorType type, int deviceIndex, int unitId, int reg,
+                      MdbSensorDef::Decode decode, double scale, double negativeWrap) {
+        MdbSensorDef def;
+        def.name = name;
+        def.sensorType = type;
+        def.deviceIndex = deviceIndex;
+        def.unitId = unitId;
+        def.registerAddr = reg;
+        def.decode = decode;
+        def.scale = scale;
+        def.negativeWrap = negativeWrap;
+        map.m_sensors.append(def);
+    };
+
+    add("上压力", SensorType::Force_Upper, 3, 1, 450, MdbSensorDef::Decode::Int32TwosComplement, 0.00981, 0.0);
+    add("下压力", SensorType::Force_Lower, 3, 1, 452, MdbSensorDef::Decode::Int32TwosComplement, 0.00981, 0.0);
+    add("扭矩", SensorType::Torque_MDB, 2, 1, 0x00, MdbSensorDef::Decode::Int32, 0.01, 0.0);
+    add("位置", SensorType::Position_MDB, 1, 2, 0x00, MdbSensorDef::Decode::Int32, 150.0 / 4096.0, 2 * 32767.0);
+
+    map.buildReadGroups();
+    return map;
+}
+
+QString MdbSensorMap::locateConfigFile()
+{
+    const QStringList candidates = {
+        QCoreApplication::applicationDirPath() + "/config/mdb_sensors.json",     // 可执行文件目录
+        QCoreApplication::applicationDirPath() + "/../config/mdb_sensors.json",  // 上级目录
+        "../config/mdb_sensors.json",                                             // 相对路径
+        "config/mdb_sensors.json"                                                 // 当前目录
+    };
+
+    for (const QString &path : candidates) {
+        if (QFileInfo::exists(path)) {
+            return path;
+        }
+    }
+    return QString();
+}
+
+bool MdbSensorMap::loadFromFile(const QString &filePath, QString *errorMessage)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorMessage) {
+            *errorMessage = QString("无法打开传感器映射文件: %1").arg(filePath);
+        }
+        return false;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    file.close();
+
+    if (parseError.error != QJsonParseError::NoError) {
+        if (errorMessage) {
+            *errorMessage = QString("JSON解析错误: %1").arg(parseError.errorString());
+        }
+        return false;
+    }
+
+    if (!doc.isObject()) {
+        if (errorMessage) {
+            *errorMessage = "传感器映射文件格式错误：根节点必须是对象";
+        }
+        return false;
+    }
+
+    if (!loadFromJson(doc.object(), errorMessage)) {
+        return false;
+    }
+
+    m_sourcePath = filePath;
+    return true;
+}
+
+bool MdbSensorMap::loadFromJson(const QJsonObject &root, QString *errorMessage)
+{
+    const QJsonArray array = root.value("sensors").toArray();
+    if (array.isEmpty()) {
+        if (errorMessage) {
+            *errorMessage = "传感器映射为空（缺少sensors数组）";
+        }
+        return false;
+    }
+
+    QVector<MdbSensorDef> sensors;
+    sensors.reserve(array.size());
+    for (const QJsonValue &value : array) {
+        MdbSensorDef def;
+        if (!MdbSensorDef::fromJson(value.toObject(), def, errorMessage)) {
+            return false;
+        }
+        sensors.append(def);
+    }
+
+    m_sensors = sensors;
+    m_maxRegisterGap = qMax(0, root.value("max_register_gap").toInt(0));
+    m_sourcePath.clear();
+    buildReadGroups();
+    return true;
+}
+
+void MdbSensorMap::buildReadGroups()
+{
+    m_readGroups.clear();
+
+    // 按 (设备, 单元ID, 寄存器) 排序后顺序合并
+    QVector<int> order(m_sensors.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        const MdbSensorDef &x = m_sensors[a];
+        const MdbSensorDef &y = m_sensors[b];
+        if (x.deviceIndex != y.deviceIndex) return x.deviceIndex < y.deviceIndex;
+        if (x.unitId != y.unitId) return x.unitId < y.unitId;
+        return x.registerAddr < y.registerAddr;
+    });
+
+    for (int index : order) {
+        const MdbSensorDef &def = m_sensors[index];
+        const int end = def.registerAddr + def.numRegisters;
+
+        if (!m_readGroups.isEmpty()) {
+            MdbReadGroup &group = m_readGroups.last();
+            const int groupEnd = group.startRegister + group.numRegisters;
+            if (group.deviceIndex == def.deviceIndex &&
+                group.unitId == def.unitId &&
+                def.registerAddr <= groupEnd + m_maxRegisterGap &&
+                qMax(groupEnd, end) - group.startRegister <= MAX_REGISTERS_PER_READ) {
+                group.numRegisters = qMax(groupEnd, end) - group.startRegister;
+                group.sensorIndexes.append(index);
+                continue;
+            }
+        }
+
+        MdbReadGroup group;
+        group.deviceIndex = def.deviceIndex;
+        group.unitId = def.unitId;
+        group.startRegister = def.registerAddr;
+        group.numRegisters = def.numRegisters;
+        group.sensorIndexes.append(index);
+        m_readGroups.append(group);
+    }
+}
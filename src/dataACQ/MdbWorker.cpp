@@ -6,13 +6,13 @@
 #include <QDateTime>
 
 /*
- * Modbus TCP 设备映射说明（4个独立网关）：
+ * Modbus TCP 设备映射说明（4个独立网关，默认映射，见config/mdb_sensors.json）：
  *
  * 设备索引 | IP地址          | 传感器类型     | 寄存器地址 | 设备ID | 数据解析
  * ---------|----------------|---------------|-----------|--------|----------
  * index 1  | 192.168.1.201  | 位置传感器     | 0x00      | 2      | 长字节拼接
  * index 2  | 192.168.1.202  | 扭矩传感器     | 0x00      | 1      | 长字节拼接
- * index 3  | 192.168.1.203  | 上/下压力传感器 | 450/452   | 1      | 补码转换
+ * index 3  | 192.168.1.203  | 上/下压力传感器 | 450-453   | 1      | 补码转换（一次读取4个寄存器）
  *
  * 注意：设备索引从0开始，但实际设备编号从200开始（200+i）
  */
@@ -22,26 +22,25 @@ MdbWorker::MdbWorker(QObject *parent)
     , m_serverAddress("192.168.1.200")
     , m_serverPort(502)
     , m_readTimer(nullptr)
-    , m_forceUpperZero(0.0)
-    , m_forceLowerZero(0.0)
-    , m_torqueZero(0.0)
-    , m_positionZero(0.0)
-    , m_lastForceUpper(0.0)
-    , m_lastForceLower(0.0)
-    , m_lastTorque(0.0)
-    , m_lastPosition(0.0)
+    , m_sensorMap(MdbSensorMap::defaultMap())
     , m_isConnected(false)
     , m_sampleCount(0)
+    , m_tickOpen(false)
+    , m_tickId(0)
+    , m_tickTimestampUs(0)
+    , m_tickSuccessCount(0)
+    , m_deadlineTimer(nullptr)
+    , m_lateReplies(0)
 {
     // 初始化4个Modbus设备为nullptr
     for (int i = 0; i < 4; i++) {
         m_modbusDevices[i] = nullptr;
-        m_sensorFailCount[i] = 0;
-        m_sensorDisconnected[i] = false;
     }
+    resetPollingState();
 
     m_sampleRate = 10.0;  // 默认10Hz
-    LOG_DEBUG("MdbWorker", "Created. Default: 10Hz, 4 sensors, 4 devices");
+    LOG_DEBUG_STREAM("MdbWorker") << "Created. Default: 10Hz," << m_sensorMap.sensors().size()
+                                  << "sensors," << m_sensorMap.readGroups().size() << "reads per tick, 4 devices";
 }
 
 MdbWorker::~MdbWorker()
@@ -57,18 +56,32 @@ bool MdbWorker::initializeHardware()
     LOG_DEBUG_STREAM("MdbWorker") << "  Server:" << m_serverAddress << ":" << m_serverPort;
     LOG_DEBUG_STREAM("MdbWorker") << "  Sample Rate:" << m_sampleRate << "Hz";
 
+    reloadSensorMap();
+
     // 连接到Modbus TCP服务器
     if (!connectToServer()) {
         return false;
     }
 
-    // 创建定时器
+    // 创建定时器（50-100Hz时需要精确定时）
     m_readTimer = new QTimer(this);
-    int intervalMs = static_cast<int>(1000.0 / m_sampleRate);
+    int intervalMs = qMax(1, static_cast<int>(1000.0 / m_sampleRate));
+    m_readTimer->setTimerType(Qt::PreciseTimer);
     m_readTimer->setInterval(intervalMs);
     connect(m_readTimer, &QTimer::timeout, this, &MdbWorker::readSensors);
 
-    LOG_DEBUG_STREAM("MdbWorker") << "Hardware initialized, read interval:" << intervalMs << "ms";
+    // tick截止定时器：留出20%余量，保证下一个tick前完成本tick
+    m_deadlineTimer = new QTimer(this);
+    m_deadlineTimer->setSingleShot(true);
+    m_deadlineTimer->setTimerType(Qt::PreciseTimer);
+    m_deadlineTimer->setInterval(qMax(1, intervalMs * 8 / 10));
+    connect(m_deadlineTimer, &QTimer::timeout, this, &MdbWorker::finalizeTick);
+
+    m_latencyClock.start();
+    resetPollingState();
+
+    LOG_DEBUG_STREAM("MdbWorker") << "Hardware initialized, read interval:" << intervalMs
+                                  << "ms, tick deadline:" << m_deadlineTimer->interval() << "ms";
     return true;
 }
 
@@ -83,12 +96,82 @@ void MdbWorker::shutdownHardware()
         m_readTimer = nullptr;
     }
 
+    if (m_deadlineTimer) {
+        m_deadlineTimer->stop();
+        delete m_deadlineTimer;
+        m_deadlineTimer = nullptr;
+    }
+
+    // 放弃所有在途请求
+    for (int i = 0; i < m_pending.size(); i++) {
+        if (m_pending[i].reply) {
+            QObject::disconnect(m_pending[i].reply, nullptr, this, nullptr);
+            m_pending[i].reply->deleteLater();
+        }
+        m_pending[i].reply = nullptr;
+        m_tickDone[i] = true;
+    }
+    m_tickOpen = false;
+
+    LOG_DEBUG_STREAM("MdbWorker") << "Request latency:\n" << latencySummary();
+
     // 断开连接
     disconnectFromServer();
 
     LOG_DEBUG_STREAM("MdbWorker") << "Shutdown complete. Total samples:" << m_sampleCount;
 }
 
+void MdbWorker::reloadSensorMap()
+{
+    const QString path = m_sensorMapPath.isEmpty() ? MdbSensorMap::locateConfigFile() : m_sensorMapPath;
+
+    if (path.isEmpty()) {
+        m_sensorMap = MdbSensorMap::defaultMap();
+        LOG_DEBUG("MdbWorker", "Sensor map config not found, using built-in default map");
+    } else {
+        MdbSensorMap map;
+        QString errorMessage;
+        if (map.loadFromFile(path, &errorMessage)) {
+            m_sensorMap = map;
+            LOG_DEBUG_STREAM("MdbWorker") << "Sensor map loaded from" << path;
+        } else {
+            m_sensorMap = MdbSensorMap::defaultMap();
+            LOG_WARNING_STREAM("MdbWorker") << "Failed to load sensor map" << path << ":" << errorMessage
+                                            << "- using built-in default map";
+        }
+    }
+
+    const QVector<MdbSensorDef> &sensors = m_sensorMap.sensors();
+    const QVector<MdbReadGroup> &groups = m_sensorMap.readGroups();
+    LOG_DEBUG_STREAM("MdbWorker") << "  Sensors:" << sensors.size() << ", reads per tick:" << groups.size();
+    for (const MdbReadGroup &group : groups) {
+        QStringList names;
+        for (int index : group.sensorIndexes) {
+            names << sensors[index].name;
+        }
+        LOG_DEBUG_STREAM("MdbWorker") << "    device" << group.deviceIndex << "unit" << group.unitId
+                                      << "registers" << group.startRegister << "+" << group.numRegisters
+                                      << ":" << names.join(",");
+    }
+
+    resetPollingState();
+}
+
+void MdbWorker::resetPollingState()
+{
+    const int groupCount = m_sensorMap.readGroups().size();
+    const int sensorCount = m_sensorMap.sensors().size();
+
+    // 调用时不应有在途请求（构造/initializeHardware/shutdownHardware之后）
+    m_pending.fill(PendingRead(), groupCount);
+    m_tickDone.fill(true, groupCount);
+    m_latency.fill(LatencyHistogram(), groupCount);
+    m_sensorFailCount.fill(0, sensorCount);
+    m_sensorDisconnected.fill(false, sensorCount);
+    m_tickOpen = false;
+    m_lateReplies = 0;
+}
+
 void MdbWorker::runAcquisition()
 {
     LOG_DEBUG("MdbWorker", "Starting acquisition timer...");
@@ -110,79 +193,184 @@ void MdbWorker::readSensors()
         return;
     }
 
-    // 诊断：记录开始时间
-    qint64 startTimeUs = QDateTime::currentMSecsSinceEpoch() * 1000;
+    // 上一个tick未截止（定时器抖动）：先结束它
+    if (m_tickOpen) {
+        finalizeTick();
+    }
 
-    QVector<quint16> values;
-    int successCount = 0;
+    m_tickId++;
+    m_tickOpen = true;
+    m_tickSuccessCount = 0;
+    m_tickTimestampUs = currentTimestampUs();
 
-    // 1. 读取上压力传感器 - 设备4 (index 3), 寄存器450, ID=1
-    if (readFromDevice(3, 1, 450, 2, values) && values.size() >= 2) {
-        int64_t rawValue = concatenateShortsToLong(values[1], values[0]);
-        double forceUpper = static_cast<double>(rawValue) * 0.00981;
-        m_lastForceUpper = forceUpper - m_forceUpperZero;
-        sendDataBlock(SensorType::Force_Upper, m_lastForceUpper);
-        successCount++;
-        updateSensorStatus(0, true);
-
-        if (m_sampleCount == 0) {
-            LOG_DEBUG_STREAM("MdbWorker") << "First sample - Force Upper raw:" << rawValue << "converted:" << m_lastForceUpper << "N";
+    const int groupCount = m_sensorMap.readGroups().size();
+    for (int i = 0; i < groupCount; i++) {
+        m_tickDone[i] = false;
+    }
+
+    // 同时发出所有请求，应答在onGroupReadFinished中异步收集
+    int outstanding = 0;
+    for (int i = 0; i < groupCount; i++) {
+        if (issueGroupRead(i)) {
+            if (!m_tickDone[i]) {
+                outstanding++;
+            }
+        } else {
+            completeGroup(i, QVector<quint16>());
         }
-    } else {
-        updateSensorStatus(0, false);
     }
 
-    // 2. 读取下压力传感器 - 设备4 (index 3), 寄存器452, ID=1
-    if (readFromDevice(3, 1, 452, 2, values) && values.size() >= 2) {
-        int64_t rawValue = concatenateShortsToLong(values[1], values[0]);
-        double forceLower = static_cast<double>(rawValue) * 0.00981;
-        m_lastForceLower = forceLower - m_forceLowerZero;
-        sendDataBlock(SensorType::Force_Lower, m_lastForceLower);
-        successCount++;
-        updateSensorStatus(1, true);
-    } else {
-        updateSensorStatus(1, false);
+    if (outstanding == 0) {
+        finalizeTick();
+    } else if (m_deadlineTimer) {
+        m_deadlineTimer->start();
+    }
+}
+
+bool MdbWorker::issueGroupRead(int groupIndex)
+{
+    const MdbReadGroup &group = m_sensorMap.readGroups()[groupIndex];
+    PendingRead &pending = m_pending[groupIndex];
+
+    // 上一次请求仍未应答（设备慢或离线）：不叠加新请求，本tick记为失败
+    if (pending.reply) {
+        return false;
+    }
+
+    QModbusTcpClient *device = m_modbusDevices[group.deviceIndex];
+    if (!device || device->state() != QModbusDevice::ConnectedState) {
+        return false;
+    }
+
+    QModbusDataUnit readUnit(QModbusDataUnit::HoldingRegisters, group.startRegister, group.numRegisters);
+    QModbusReply *reply = device->sendReadRequest(readUnit, group.unitId);
+    if (!reply) {
+        LOG_WARNING_STREAM("MdbWorker") << "Failed to send read request to device" << group.deviceIndex;
+        return false;
     }
 
-    // 3. 读取扭矩传感器 - 设备3 (index 2), 寄存器0x00, ID=1
-    if (readFromDevice(2, 1, 0x00, 2, values) && values.size() >= 2) {
-        long rawValue = shortsToLong(values[1], values[0]);
-        double torque = static_cast<double>(rawValue) * 0.01;
-        m_lastTorque = torque - m_torqueZero;
-        sendDataBlock(SensorType::Torque_MDB, m_lastTorque);
-        successCount++;
-        updateSensorStatus(2, true);
+    pending.reply = reply;
+    pending.sentNs = m_latencyClock.nsecsElapsed();
+
+    const quint64 tickId = m_tickId;
+    if (reply->isFinished()) {
+        onGroupReadFinished(groupIndex, tickId);
     } else {
-        updateSensorStatus(2, false);
+        connect(reply, &QModbusReply::finished, this, [this, groupIndex, tickId]() {
+            onGroupReadFinished(groupIndex, tickId);
+        });
     }
+    return true;
+}
 
-    // 4. 读取位置传感器 - 设备2 (index 1), 寄存器0x00, ID=2
-    if (readFromDevice(1, 2, 0x00, 2, values) && values.size() >= 2) {
-        long rawValue = shortsToLong(values[1], values[0]);
-        double positionRaw;
-        if (rawValue < 0) {
-            positionRaw = 2 * 32767 + rawValue;
-        } else {
-            positionRaw = static_cast<double>(rawValue);
+void MdbWorker::onGroupReadFinished(int groupIndex, quint64 tickId)
+{
+    PendingRead &pending = m_pending[groupIndex];
+    QModbusReply *reply = pending.reply;
+    if (!reply) {
+        return;
+    }
+
+    pending.reply = nullptr;
+    markHardwareRead();
+    m_latency[groupIndex].record((m_latencyClock.nsecsElapsed() - pending.sentNs) / 1000);
+
+    // 截止后才到达的应答：只计入延迟统计，数值丢弃（该tick已记为失败）
+    const bool onTime = m_tickOpen && tickId == m_tickId && !m_tickDone[groupIndex];
+    if (!onTime) {
+        m_lateReplies++;
+        reply->deleteLater();
+        return;
+    }
+
+    const MdbReadGroup &group = m_sensorMap.readGroups()[groupIndex];
+    QVector<quint16> registers;
+    if (reply->error() == QModbusDevice::NoError) {
+        const QModbusDataUnit result = reply->result();
+        if (static_cast<int>(result.valueCount()) >= group.numRegisters) {
+            registers.reserve(group.numRegisters);
+            for (int i = 0; i < group.numRegisters; i++) {
+                registers.append(result.value(i));
+            }
         }
-        double position = positionRaw * 150.0 / 4096.0;
-        m_lastPosition = position - m_positionZero;
-        sendDataBlock(SensorType::Position_MDB, m_lastPosition);
-        successCount++;
-        updateSensorStatus(3, true);
     } else {
-        updateSensorStatus(3, false);
+        // 忽略连接关闭导致的错误（正常shutdown时会发生）
+        QString errorStr = reply->errorString();
+        if (!errorStr.contains("connection closure", Qt::CaseInsensitive) &&
+            !errorStr.contains("aborted", Qt::CaseInsensitive)) {
+            LOG_WARNING_STREAM("MdbWorker") << "Read error from device" << group.deviceIndex << ":" << errorStr;
+        }
+    }
+    reply->deleteLater();
+
+    m_tickSuccessCount += completeGroup(groupIndex, registers);
+
+    // 全部应答到齐，提前结束本tick
+    for (int i = 0; i < m_tickDone.size(); i++) {
+        if (!m_tickDone[i]) {
+            return;
+        }
+    }
+    finalizeTick();
+}
+
+int MdbWorker::completeGroup(int groupIndex, const QVector<quint16> &registers)
+{
+    // registers为空表示本次读取失败：组内全部传感器记为失败
+    const MdbReadGroup &group = m_sensorMap.readGroups()[groupIndex];
+    const QVector<MdbSensorDef> &sensors = m_sensorMap.sensors();
+
+    int successCount = 0;
+    for (int sensorIndex : group.sensorIndexes) {
+        double physical = 0.0;
+        const int offset = sensors[sensorIndex].registerAddr - group.startRegister;
+        const bool success = !registers.isEmpty() &&
+                             decodeSensorValue(sensorIndex, registers, offset, physical);
+        if (success) {
+            applySensorValue(sensorIndex, physical, m_tickTimestampUs);
+            successCount++;
+        }
+        updateSensorStatus(sensorIndex, success);
+    }
+
+    m_tickDone[groupIndex] = true;
+    return successCount;
+}
+
+void MdbWorker::finalizeTick()
+{
+    if (!m_tickOpen) {
+        return;
+    }
+    m_tickOpen = false;
+
+    if (m_deadlineTimer) {
+        m_deadlineTimer->stop();
+    }
+
+    // 截止时仍未应答的传感器只损失本次样本，请求保持在途直到应答或超时
+    for (int i = 0; i < m_tickDone.size(); i++) {
+        if (!m_tickDone[i]) {
+            completeGroup(i, QVector<quint16>());
+        }
     }
 
     m_sampleCount++;
-    m_samplesCollected += successCount;
+    m_samplesCollected += m_tickSuccessCount;
+
+    // 诊断：约每秒输出一次本tick耗时
+    const int ticksPerSecond = qMax(1, static_cast<int>(m_sampleRate));
+    if (m_sampleCount % ticksPerSecond == 0) {
+        qint64 elapsedMs = (currentTimestampUs() - m_tickTimestampUs) / 1000;
+        LOG_DEBUG_STREAM("MdbWorker") << "Tick #" << m_sampleCount
+                                      << " took" << elapsedMs << "ms (success:" << m_tickSuccessCount
+                                      << "/" << m_sensorMap.sensors().size() << ")"
+                                      << ", late replies:" << m_lateReplies;
+    }
 
-    // 诊断：计算并记录执行时间
-    qint64 endTimeUs = QDateTime::currentMSecsSinceEpoch() * 1000;
-    qint64 elapsedMs = (endTimeUs - startTimeUs) / 1000;
-    if (m_sampleCount % 10 == 0) {  // 每10个样本输出一次
-        LOG_DEBUG_STREAM("MdbWorker") << "readSensors() #" << m_sampleCount
-                                      << " took" << elapsedMs << "ms (success:" << successCount << "/4)";
+    // 约每10秒输出一次延迟直方图
+    if (m_sampleCount % (ticksPerSecond * 10) == 0) {
+        LOG_DEBUG_STREAM("MdbWorker") << "Request latency:\n" << latencySummary();
     }
 
     if (m_sampleCount > 0 && m_sampleCount % 100 == 0) {
@@ -190,29 +378,89 @@ void MdbWorker::readSensors()
     }
 }
 
+bool MdbWorker::decodeSensorValue(int sensorIndex, const QVector<quint16> &registers, int offset, double &physical)
+{
+    const MdbSensorDef &def = m_sensorMap.sensors()[sensorIndex];
+    if (offset < 0 || offset + def.numRegisters > registers.size()) {
+        return false;
+    }
+
+    const quint16 high = def.highWordFirst ? registers[offset] : registers[offset + 1];
+    const quint16 low = def.highWordFirst ? registers[offset + 1] : registers[offset];
+
+    double raw = 0.0;
+    switch (def.decode) {
+    case MdbSensorDef::Decode::Int32TwosComplement:
+        raw = static_cast<double>(concatenateShortsToLong(low, high));
+        break;
+    case MdbSensorDef::Decode::Int32:
+        raw = static_cast<double>(shortsToLong(low, high));
+        break;
+    }
+
+    if (raw < 0 && def.negativeWrap != 0.0) {
+        raw += def.negativeWrap;
+    }
+
+    physical = raw * def.scale + def.offset;
+    return true;
+}
+
+void MdbWorker::applySensorValue(int sensorIndex, double physical, qint64 timestampUs)
+{
+    const MdbSensorDef &def = m_sensorMap.sensors()[sensorIndex];
+    const double value = physical - m_zeroOffsets.value(sensorKey(def.sensorType, def.channelId), 0.0);
+    sendDataBlock(def.sensorType, def.channelId, value, timestampUs);
+
+    if (m_sampleCount == 0) {
+        LOG_DEBUG_STREAM("MdbWorker") << "First sample -" << def.name << "converted:" << value;
+    }
+}
+
+QString MdbWorker::latencySummary() const
+{
+    const QVector<MdbSensorDef> &sensors = m_sensorMap.sensors();
+    const QVector<MdbReadGroup> &groups = m_sensorMap.readGroups();
+
+    QStringList lines;
+    for (int i = 0; i < groups.size() && i < m_latency.size(); i++) {
+        QStringList names;
+        for (int index : groups[i].sensorIndexes) {
+            names << sensors[index].name;
+        }
+        lines << QString("  %1 (device %2): %3")
+                     .arg(names.join("/"))
+                     .arg(groups[i].deviceIndex)
+                     .arg(m_latency[i].summary());
+    }
+    return lines.join("\n");
+}
+
 void MdbWorker::updateSensorStatus(int sensorIndex, bool success)
 {
-    static const char* sensorNames[4] = {"上压力", "下压力", "扭矩", "位置"};
+    if (sensorIndex < 0 || sensorIndex >= m_sensorFailCount.size()) return;
 
-    if (sensorIndex < 0 || sensorIndex >= 4) return;
+    const QString &sensorName = m_sensorMap.sensors()[sensorIndex].name;
 
     if (success) {
         if (m_sensorDisconnected[sensorIndex]) {
             // 传感器恢复连接
             m_sensorDisconnected[sensorIndex] = false;
-            LOG_DEBUG_STREAM("MdbWorker") << sensorNames[sensorIndex] << "传感器恢复连接";
+            LOG_DEBUG_STREAM("MdbWorker") << sensorName << "传感器恢复连接";
             emit eventOccurred("MdbSensorReconnected",
-                QString("%1传感器恢复连接").arg(sensorNames[sensorIndex]));
+                QString("%1传感器恢复连接").arg(sensorName));
         }
         m_sensorFailCount[sensorIndex] = 0;
     } else {
+        // 掉线判定至少覆盖3秒，高采样率下不因短暂抖动误报
+        const int threshold = qMax(SENSOR_DISCONNECT_THRESHOLD, static_cast<int>(3 * m_sampleRate));
         m_sensorFailCount[sensorIndex]++;
-        if (m_sensorFailCount[sensorIndex] >= SENSOR_DISCONNECT_THRESHOLD && !m_sensorDisconnected[sensorIndex]) {
+        if (m_sensorFailCount[sensorIndex] >= threshold && !m_sensorDisconnected[sensorIndex]) {
             // 传感器掉线
             m_sensorDisconnected[sensorIndex] = true;
-            LOG_WARNING_STREAM("MdbWorker") << sensorNames[sensorIndex] << "传感器掉线（连续" << SENSOR_DISCONNECT_THRESHOLD << "次失败）";
+            LOG_WARNING_STREAM("MdbWorker") << sensorName << "传感器掉线（连续" << threshold << "次失败）";
             emit eventOccurred("MdbSensorDisconnected",
-                QString("%1传感器掉线").arg(sensorNames[sensorIndex]));
+                QString("%1传感器掉线").arg(sensorName));
         }
     }
 }
@@ -221,40 +469,29 @@ void MdbWorker::performZeroCalibration()
 {
     LOG_DEBUG("MdbWorker", "Performing zero calibration...");
 
+    const QVector<MdbSensorDef> &sensors = m_sensorMap.sensors();
     QVector<quint16> values;
 
-    // 读取当前值作为零点（使用相同的换算公式和字节顺序）
-    if (readFromDevice(3, 1, 450, 2, values) && values.size() >= 2) {
-        int64_t rawValue = concatenateShortsToLong(values[1], values[0]);
-        m_forceUpperZero = static_cast<double>(rawValue) * 0.00981;
-    }
-
-    if (readFromDevice(3, 1, 452, 2, values) && values.size() >= 2) {
-        int64_t rawValue = concatenateShortsToLong(values[1], values[0]);
-        m_forceLowerZero = static_cast<double>(rawValue) * 0.00981;
-    }
-
-    if (readFromDevice(2, 1, 0x00, 2, values) && values.size() >= 2) {
-        long rawValue = shortsToLong(values[1], values[0]);
-        m_torqueZero = static_cast<double>(rawValue) * 0.01;
-    }
+    // 读取当前值作为零点（按合并后的读取组，使用与采集相同的换算公式和字节顺序）
+    for (const MdbReadGroup &group : m_sensorMap.readGroups()) {
+        if (!readFromDevice(group.deviceIndex, group.unitId, group.startRegister, group.numRegisters, values)) {
+            continue;
+        }
 
-    if (readFromDevice(1, 2, 0x00, 2, values) && values.size() >= 2) {
-        long rawValue = shortsToLong(values[1], values[0]);
-        double positionRaw;
-        if (rawValue < 0) {
-            positionRaw = 2 * 32767 + rawValue;
-        } else {
-            positionRaw = static_cast<double>(rawValue);
+        for (int sensorIndex : group.sensorIndexes) {
+            const MdbSensorDef &def = sensors[sensorIndex];
+            double physical = 0.0;
+            if (decodeSensorValue(sensorIndex, values, def.registerAddr - group.startRegister, physical)) {
+                setSensorZero(def.sensorType, physical, def.channelId);
+            }
         }
-        m_positionZero = positionRaw * 150.0 / 4096.0;
     }
 
     LOG_DEBUG("MdbWorker", "Zero calibration done:");
-    LOG_DEBUG_STREAM("MdbWorker") << "  Force Upper:" << m_forceUpperZero << "N";
-    LOG_DEBUG_STREAM("MdbWorker") << "  Force Lower:" << m_forceLowerZero << "N";
-    LOG_DEBUG_STREAM("MdbWorker") << "  Torque:" << m_torqueZero << "N·m";
-    LOG_DEBUG_STREAM("MdbWorker") << "  Position:" << m_positionZero << "mm";
+    for (const MdbSensorDef &def : sensors) {
+        LOG_DEBUG_STREAM("MdbWorker") << "  " << def.name << ":"
+                                      << m_zeroOffsets.value(sensorKey(def.sensorType, def.channelId), 0.0);
+    }
 }
 
 bool MdbWorker::testConnection()
@@ -313,8 +550,10 @@ bool MdbWorker::connectToServer()
         // 设置连接参数
         m_modbusDevices[i]->setConnectionParameter(QModbusDevice::NetworkPortParameter, m_serverPort);
         m_modbusDevices[i]->setConnectionParameter(QModbusDevice::NetworkAddressParameter, deviceIp);
-        m_modbusDevices[i]->setTimeout(5000);
-        m_modbusDevices[i]->setNumberOfRetries(3);
+        // 轮询按tick截止收集应答，超时后的重发没有意义：缩短超时、不重发，
+        // 避免离线设备的在途请求长期占住该传感器的请求槽
+        m_modbusDevices[i]->setTimeout(1000);
+        m_modbusDevices[i]->setNumberOfRetries(0);
 
         // 连接设备
         if (!m_modbusDevices[i]->connectDevice()) {
@@ -473,18 +712,18 @@ bool MdbWorker::readFromDevice(int deviceIndex, int deviceId, int registerAddr,
     return success;
 }
 
-void MdbWorker::sendDataBlock(SensorType type, double value)
+void MdbWorker::sendDataBlock(SensorType type, int channelId, double value, qint64 timestampUs)
 {
     DataBlock block;
     block.roundId = m_currentRoundId;
     block.sensorType = type;
-    block.channelId = 0;  // MDB传感器不分通道
-    block.startTimestampUs = currentTimestampUs();
+    block.channelId = channelId;  // 默认映射中MDB传感器不分通道（0）
+    block.startTimestampUs = timestampUs;  // 同一tick的传感器共用请求发出时刻
     block.sampleRate = m_sampleRate;
     block.numSamples = 1;
     block.values.append(value);
 
-    emit dataBlockReady(block);
+    publishBlock(block);
 }
 
 // 数据解析辅助函数
@@ -6,6 +6,19 @@
 #include <QDebug>
 #include <QThread>
 #include <QMutexLocker>
+#include <QElapsedTimer>
+
+namespace {
+
+// 批量读取使用的BASIC参数名（与逐轴读取的ZAux接口对应）
+const char* const PARAM_NAMES[4] = {
+    "MPOS",             // ZAux_Direct_GetMpos
+    "MSPEED",           // ZAux_Direct_GetMspeed
+    "DRIVE_TORQUE",     // ZAux_Direct_GetParam("DRIVE_TORQUE")
+    "DAC"               // ZAux_Direct_GetDAC
+};
+
+} // namespace
 
 MotorWorker::MotorWorker(QObject *parent)
     : BaseWorker(parent)
@@ -15,11 +28,19 @@ MotorWorker::MotorWorker(QObject *parent)
     , m_readSpeed(true)
     , m_readTorque(false)    // 扭矩=电流，不重复采集
     , m_readCurrent(true)
+    , m_readMode(ReadMode::Batched)
+    , m_batchUnsupported(false)
+    , m_tickTimestampUs(0)
+    , m_captureTimer(nullptr)
+    , m_captureActive(false)
+    , m_captureDepth(0)
+    , m_captureSampleRate(0.0)
+    , m_captureStartUs(0)
     , m_sampleCount(0)
 {
     m_sampleRate = 10.0;  // 默认10Hz（电机参数刷新无需太快）
     m_motorIds = {0, 1, 2, 3, 4, 5, 6, 7};  // 默认8个电机
-    LOG_DEBUG("MotorWorker", "Created. Default: 10Hz, 8 motors, 3 params (pos/speed/current)");
+    LOG_DEBUG("MotorWorker", "Created. Default: 10Hz, 8 motors, 3 params (pos/speed/current), batched reads");
 }
 
 MotorWorker::~MotorWorker()
@@ -49,11 +70,22 @@ bool MotorWorker::isConnected() const
     return g_handle != nullptr;
 }
 
+const char* MotorWorker::readModeName(ReadMode mode)
+{
+    switch (mode) {
+    case ReadMode::PerAxis: return "per-axis";
+    case ReadMode::Batched: return "batched";
+    }
+    return "unknown";
+}
+
 bool MotorWorker::initializeHardware()
 {
     LOG_DEBUG("MotorWorker", "Initializing (using global g_handle)...");
     LOG_DEBUG_STREAM("MotorWorker") << "  Sample Rate:" << m_sampleRate << "Hz";
     LOG_DEBUG_STREAM("MotorWorker") << "  Motor IDs:" << m_motorIds;
+    LOG_DEBUG_STREAM("MotorWorker") << "  Read mode:" << readModeName(m_readMode)
+                                    << "(" << transactionsPerTick(m_readMode) << "transactions/tick)";
 
     // 检查全局句柄是否已连接
     if (!isConnected()) {
@@ -63,10 +95,14 @@ bool MotorWorker::initializeHardware()
 
     // 创建定时器
     m_readTimer = new QTimer(this);
-    int intervalMs = static_cast<int>(1000.0 / m_sampleRate);
+    int intervalMs = qMax(1, static_cast<int>(1000.0 / m_sampleRate));
+    m_readTimer->setTimerType(Qt::PreciseTimer);
     m_readTimer->setInterval(intervalMs);
     connect(m_readTimer, &QTimer::timeout, this, &MotorWorker::readMotorParameters);
 
+    prepareTelemetryBuffers();
+    m_tickLatency.reset();
+
     LOG_DEBUG_STREAM("MotorWorker") << "Hardware initialized, read interval:" << intervalMs << "ms";
     return true;
 }
@@ -82,8 +118,14 @@ void MotorWorker::shutdownHardware()
         m_readTimer = nullptr;
     }
 
+    if (m_captureActive) {
+        stopCapture();
+    }
+
     // 不断开连接，连接由 ZMotionDriver 统一管理
 
+    LOG_DEBUG_STREAM("MotorWorker") << "Tick latency (" << readModeName(m_readMode) << "):"
+                                    << m_tickLatency.summary();
     LOG_DEBUG_STREAM("MotorWorker") << "Shutdown complete. Total samples:" << m_sampleCount;
 }
 
@@ -113,49 +155,367 @@ void MotorWorker::readMotorParameters()
         return;  // 静默跳过，不输出警告（避免日志刷屏）
     }
 
-    // 遍历所有电机
+    const ReadMode mode = m_batchUnsupported ? ReadMode::PerAxis : m_readMode;
+    bool ok = readTelemetry(mode);
+
+    // 批量读取失败而逐轴读取成功：控制器固件不支持批量接口，之后固定使用逐轴模式
+    if (!ok && mode == ReadMode::Batched) {
+        ok = readTelemetry(ReadMode::PerAxis);
+        if (ok) {
+            m_batchUnsupported = true;
+            LOG_WARNING("MotorWorker", "Batched axis read failed, falling back to per-axis reads");
+        }
+    }
+
+    if (!ok) {
+        return;
+    }
+    markHardwareRead();
+
+    const int published = sendSnapshotBlock();
+
+    m_sampleCount++;
+    m_samplesCollected += published;
+
+    // 约每10秒输出一次tick耗时分布
+    const int ticksPerSecond = qMax(1, static_cast<int>(m_sampleRate));
+    if (m_sampleCount % (ticksPerSecond * 10) == 0) {
+        LOG_DEBUG_STREAM("MotorWorker") << "Tick latency (" << readModeName(mode) << "):"
+                                        << m_tickLatency.summary();
+    }
+
+    if (m_sampleCount > 0 && m_sampleCount % 1000 == 0) {
+        emit statisticsUpdated(m_samplesCollected, m_sampleRate);
+    }
+}
+
+bool MotorWorker::isParamEnabled(int param) const
+{
+    switch (param) {
+    case ParamPosition: return m_readPosition;
+    case ParamSpeed: return m_readSpeed;
+    case ParamTorque: return m_readTorque;
+    case ParamCurrent: return m_readCurrent;
+    default: return false;
+    }
+}
+
+int MotorWorker::transactionsPerTick(ReadMode mode) const
+{
+    int params = 0;
+    for (int p = 0; p < ParamCount; p++) {
+        if (isParamEnabled(p)) {
+            params++;
+        }
+    }
+    return mode == ReadMode::Batched ? params : params * m_motorIds.size();
+}
+
+void MotorWorker::prepareTelemetryBuffers()
+{
+    const int motorCount = m_motorIds.size();
+    for (int p = 0; p < ParamCount; p++) {
+        m_values[p].fill(0.0, motorCount);
+        m_valid[p].fill(false, motorCount);
+    }
+
+    // 批量接口按轴号0..N-1返回，缓冲区覆盖到最大的映射轴号
+    int axisCount = 0;
     for (int motorId : m_motorIds) {
-        // 读取位置
-        if (m_readPosition) {
-            double position;
-            if (readMotorPosition(motorId, position)) {
-                sendDataBlock(motorId, SensorType::Motor_Position, position);
-            }
+        axisCount = qMax(axisCount, MotorMap[motorId] + 1);
+    }
+    m_axisBuffer.fill(0.0f, axisCount);
+}
+
+bool MotorWorker::readTelemetry(ReadMode mode)
+{
+    if (m_values[0].size() != m_motorIds.size()) {
+        prepareTelemetryBuffers();
+    }
+    for (int p = 0; p < ParamCount; p++) {
+        m_valid[p].fill(false);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    m_tickTimestampUs = currentTimestampUs();
+
+    const bool ok = (mode == ReadMode::Batched) ? readTelemetryBatched() : readTelemetryPerAxis();
+
+    m_tickLatency.record(timer.nsecsElapsed() / 1000);
+    return ok;
+}
+
+bool MotorWorker::readTelemetryBatched()
+{
+    // 整个tick只加锁一次，每个参数一次往返读取全部轴
+    QMutexLocker locker(&g_mutex);
+    if (!g_handle) return false;
+
+    const int axisCount = m_axisBuffer.size();
+    for (int p = 0; p < ParamCount; p++) {
+        if (!isParamEnabled(p)) {
+            continue;
         }
 
-        // 读取速度
-        if (m_readSpeed) {
-            double speed;
-            if (readMotorSpeed(motorId, speed)) {
-                sendDataBlock(motorId, SensorType::Motor_Speed, speed);
-            }
+        int32 ret = ZAux_Direct_GetAllAxisPara(g_handle, PARAM_NAMES[p], axisCount, m_axisBuffer.data());
+        if (ret != ERR_OK) {
+            return false;
         }
 
-        // 读取扭矩
-        if (m_readTorque) {
-            double torque;
-            if (readMotorTorque(motorId, torque)) {
-                sendDataBlock(motorId, SensorType::Motor_Torque, torque);
-            }
+        for (int i = 0; i < m_motorIds.size(); i++) {
+            m_values[p][i] = static_cast<double>(m_axisBuffer[MotorMap[m_motorIds[i]]]);
+            m_valid[p][i] = true;
+        }
+    }
+    return true;
+}
+
+bool MotorWorker::readTelemetryPerAxis()
+{
+    // 逐轴读取：每次调用单独加锁，锁之间可插入控制命令
+    bool any = false;
+    for (int i = 0; i < m_motorIds.size(); i++) {
+        const int motorId = m_motorIds[i];
+        double value = 0.0;
+
+        if (m_readPosition && readMotorPosition(motorId, value)) {
+            m_values[ParamPosition][i] = value;
+            m_valid[ParamPosition][i] = true;
+            any = true;
+        }
+        if (m_readSpeed && readMotorSpeed(motorId, value)) {
+            m_values[ParamSpeed][i] = value;
+            m_valid[ParamSpeed][i] = true;
+            any = true;
         }
+        if (m_readTorque && readMotorTorque(motorId, value)) {
+            m_values[ParamTorque][i] = value;
+            m_valid[ParamTorque][i] = true;
+            any = true;
+        }
+        if (m_readCurrent && readMotorCurrent(motorId, value)) {
+            m_values[ParamCurrent][i] = value;
+            m_valid[ParamCurrent][i] = true;
+            any = true;
+        }
+    }
+    return any;
+}
 
-        // 读取电流
-        if (m_readCurrent) {
-            double current;
-            if (readMotorCurrent(motorId, current)) {
-                sendDataBlock(motorId, SensorType::Motor_Current, current);
+bool MotorWorker::startCapture()
+{
+    if (m_captureActive) {
+        LOG_WARNING("MotorWorker", "Capture already in progress");
+        return false;
+    }
+
+    const QVector<int> motors = m_captureConfig.motorIds.isEmpty() ? m_motorIds : m_captureConfig.motorIds;
+
+    // 通道布局：每个电机依次 MPOS、DAC
+    QStringList params;
+    m_captureMotors.clear();
+    m_captureTypes.clear();
+    for (int motorId : motors) {
+        const int axis = MotorMap[motorId];
+        if (m_captureConfig.position) {
+            params << QString("MPOS(%1)").arg(axis);
+            m_captureMotors.append(motorId);
+            m_captureTypes.append(SensorType::Motor_Position);
+        }
+        if (m_captureConfig.current) {
+            params << QString("DAC(%1)").arg(axis);
+            m_captureMotors.append(motorId);
+            m_captureTypes.append(SensorType::Motor_Current);
+        }
+    }
+
+    if (params.isEmpty() || params.size() > MAX_SCOPE_CHANNELS) {
+        emitError(QString("Invalid capture channel count: %1 (max %2)").arg(params.size()).arg(MAX_SCOPE_CHANNELS));
+        return false;
+    }
+
+    QMutexLocker locker(&g_mutex);
+    if (!g_handle) {
+        LOG_WARNING("MotorWorker", "Capture skipped: controller not connected");
+        return false;
+    }
+
+    // 采样周期 = 伺服周期（微秒）× 间隔
+    double servoPeriodUs = 0.0;
+    if (!queryControllerValue("SERVO_PERIOD", servoPeriodUs) || servoPeriodUs <= 0) {
+        emitError("Failed to read SERVO_PERIOD for capture");
+        return false;
+    }
+
+    const int cycles = qMax(1, m_captureConfig.servoCyclesPerSample);
+    const double samplePeriodUs = servoPeriodUs * cycles;
+    m_captureSampleRate = 1e6 / samplePeriodUs;
+    m_captureDepth = qMax(1, static_cast<int>(m_captureConfig.durationMs * 1000.0 / samplePeriodUs));
+
+    // SCOPE把TABLE区间按参数个数等分，每个参数连续存放depth个样本
+    const int tableStart = m_captureConfig.tableStart;
+    const int tableEnd = tableStart + params.size() * m_captureDepth - 1;
+    const QString scopeCommand = QString("SCOPE(ON,%1,%2,%3,%4)")
+                                     .arg(cycles).arg(tableStart).arg(tableEnd).arg(params.join(","));
+    if (!executeCommand(scopeCommand)) {
+        emitError(QString("Failed to configure capture: %1").arg(scopeCommand));
+        return false;
+    }
+
+    // TRIGGER后控制器在下一个伺服周期开始记录：以调用往返的中点作为第一个样本时刻
+    const qint64 beforeUs = currentTimestampUs();
+    int32 ret = ZAux_Trigger(g_handle);
+    const qint64 afterUs = currentTimestampUs();
+    if (ret != ERR_OK) {
+        executeCommand("SCOPE(OFF)");
+        emitError(QString("Capture trigger failed, error code %1").arg(ret));
+        return false;
+    }
+    locker.unlock();
+
+    m_captureStartUs = beforeUs + (afterUs - beforeUs) / 2;
+    m_captureActive = true;
+    m_captureClock.start();
+
+    if (!m_captureTimer) {
+        m_captureTimer = new QTimer(this);
+        m_captureTimer->setInterval(50);
+        connect(m_captureTimer, &QTimer::timeout, this, &MotorWorker::pollCapture);
+    }
+    m_captureTimer->start();
+
+    LOG_DEBUG_STREAM("MotorWorker") << "Capture started:" << params.size() << "channels x" << m_captureDepth
+                                    << "samples @" << m_captureSampleRate << "Hz, TABLE"
+                                    << tableStart << "-" << tableEnd;
+    return true;
+}
+
+void MotorWorker::stopCapture()
+{
+    if (m_captureTimer) {
+        m_captureTimer->stop();
+    }
+    if (!m_captureActive) {
+        return;
+    }
+    m_captureActive = false;
+
+    QMutexLocker locker(&g_mutex);
+    if (g_handle) {
+        executeCommand("SCOPE(OFF)");
+    }
+    locker.unlock();
+
+    LOG_DEBUG("MotorWorker", "Capture stopped");
+    emit captureFinished(false, 0);
+}
+
+void MotorWorker::pollCapture()
+{
+    if (!m_captureActive) {
+        return;
+    }
+
+    // 未到采集时长不查询，减少网络往返
+    const qint64 elapsedMs = m_captureClock.elapsed();
+    if (elapsedMs < m_captureConfig.durationMs) {
+        return;
+    }
+
+    // SCOPE_POS：当前写入位置（相对各参数区段起点的偏移 + tablestart）
+    double scopePos = 0.0;
+    {
+        QMutexLocker locker(&g_mutex);
+        if (!g_handle || !queryControllerValue("SCOPE_POS", scopePos)) {
+            scopePos = m_captureConfig.tableStart;
+        }
+    }
+
+    const int captured = qBound(0, static_cast<int>(scopePos) - m_captureConfig.tableStart, m_captureDepth);
+    const bool timedOut = elapsedMs > m_captureConfig.durationMs + 1000;
+
+    if (captured >= m_captureDepth || timedOut) {
+        if (timedOut && captured < m_captureDepth) {
+            LOG_WARNING_STREAM("MotorWorker") << "Capture timed out with" << captured << "/" << m_captureDepth << "samples";
+        }
+        finishCapture(captured);
+    }
+}
+
+void MotorWorker::finishCapture(int samplesPerChannel)
+{
+    m_captureTimer->stop();
+    m_captureActive = false;
+
+    if (samplesPerChannel <= 0) {
+        emit captureFinished(false, 0);
+        return;
+    }
+
+    // 分段读取TABLE：每段单独加锁，读回期间控制命令仍可插入
+    QVector<float> chunk(TABLE_READ_CHUNK);
+    bool ok = true;
+    for (int ch = 0; ch < m_captureMotors.size() && ok; ch++) {
+        DataBlock block;
+        block.roundId = m_currentRoundId;
+        block.sensorType = m_captureTypes[ch];
+        block.channelId = m_captureMotors[ch];
+        block.startTimestampUs = m_captureStartUs;
+        block.sampleRate = m_captureSampleRate;
+        block.numSamples = samplesPerChannel;
+        block.values.reserve(samplesPerChannel);
+
+        const int channelStart = m_captureConfig.tableStart + ch * m_captureDepth;
+        for (int offset = 0; offset < samplesPerChannel; offset += TABLE_READ_CHUNK) {
+            const int count = qMin(TABLE_READ_CHUNK, samplesPerChannel - offset);
+
+            QMutexLocker locker(&g_mutex);
+            if (!g_handle ||
+                ZAux_Direct_GetTable(g_handle, channelStart + offset, count, chunk.data()) != ERR_OK) {
+                ok = false;
+                break;
             }
+            locker.unlock();
+
+            for (int i = 0; i < count; i++) {
+                block.values.append(static_cast<double>(chunk[i]));
+            }
+        }
+
+        if (ok) {
+            markHardwareRead();
+            publishBlock(block);
         }
     }
 
-    m_sampleCount++;
-    int paramsPerMotor = (m_readPosition ? 1 : 0) + (m_readSpeed ? 1 : 0) +
-                         (m_readTorque ? 1 : 0) + (m_readCurrent ? 1 : 0);
-    m_samplesCollected += m_motorIds.size() * paramsPerMotor;
+    if (!ok) {
+        LOG_WARNING("MotorWorker", "Failed to read capture TABLE");
+    } else {
+        LOG_DEBUG_STREAM("MotorWorker") << "Capture finished:" << m_captureMotors.size() << "channels x"
+                                        << samplesPerChannel << "samples";
+    }
+    emit captureFinished(ok, ok ? samplesPerChannel : 0);
+}
 
-    if (m_sampleCount > 0 && m_sampleCount % 1000 == 0) {
-        emit statisticsUpdated(m_samplesCollected, m_sampleRate);
+bool MotorWorker::queryControllerValue(const char *expression, double &value)
+{
+    char response[64] = {0};
+    const QByteArray command = QByteArray("?") + expression;
+    if (ZAux_Execute(g_handle, command.constData(), response, sizeof(response)) != ERR_OK) {
+        return false;
     }
+
+    bool ok = false;
+    value = QString::fromLatin1(response).trimmed().toDouble(&ok);
+    return ok;
+}
+
+bool MotorWorker::executeCommand(const QString &command)
+{
+    char response[256] = {0};
+    const QByteArray bytes = command.toLatin1();
+    return ZAux_Execute(g_handle, bytes.constData(), response, sizeof(response)) == ERR_OK;
 }
 
 bool MotorWorker::readMotorPosition(int motorId, double &position)
@@ -230,16 +590,39 @@ bool MotorWorker::readMotorCurrent(int motorId, double &current)
     return false;
 }
 
-void MotorWorker::sendDataBlock(int motorId, SensorType type, double value)
+int MotorWorker::sendSnapshotBlock()
 {
+    // 一个tick只发送一个快照块：values[param * channelCount + motorId]，未读到的槽位为NaN
+    int slots = 0;
+    for (int motorId : m_motorIds) {
+        slots = qMax(slots, motorId + 1);
+    }
+
     DataBlock block;
     block.roundId = m_currentRoundId;
-    block.sensorType = type;
-    block.channelId = motorId;  // 通道ID = 电机ID
-    block.startTimestampUs = currentTimestampUs();
+    block.sensorType = SensorType::Motor_Snapshot;
+    block.channelId = 0;
+    block.channelCount = slots;
+    block.startTimestampUs = m_tickTimestampUs;  // 同一tick的参数共用读取开始时刻
     block.sampleRate = m_sampleRate;
     block.numSamples = 1;
-    block.values.append(value);
+    block.values.fill(std::numeric_limits<double>::quiet_NaN(), MotorSnapshot::ParamCount * slots);
 
-    emit dataBlockReady(block);
+    int valid = 0;
+    for (int p = 0; p < ParamCount; p++) {
+        if (!isParamEnabled(p)) {
+            continue;
+        }
+        for (int i = 0; i < m_motorIds.size(); i++) {
+            if (m_valid[p][i]) {
+                block.values[p * slots + m_motorIds[i]] = m_values[p][i];
+                valid++;
+            }
+        }
+    }
+
+    if (valid > 0) {
+        publishBlock(block);
+    }
+    return valid;
 }
@@ -0,0 +1,81 @@
+// MotorWorker读取方式基准（--bench-motor），仅在 qmake CONFIG+=bench 时编入
+#include "dataACQ/MotorWorker.h"
+#include "Logger.h"
+#include "control/ZMotionDriver.h"
+#include <QElapsedTimer>
+
+QVector<MotorWorker::BenchmarkResult> MotorWorker::runBenchmark(const QVector<int> &motorIds, int ticksPerMode)
+{
+    QVector<BenchmarkResult> results;
+
+    MotorWorker worker;
+    worker.setMotorIds(motorIds);
+    worker.prepareTelemetryBuffers();
+
+    const ReadMode modes[2] = {ReadMode::PerAxis, ReadMode::Batched};
+    for (ReadMode mode : modes) {
+        // 预热：建立连接缓存，排除首次调用开销
+        for (int i = 0; i < 5; i++) {
+            worker.readTelemetry(mode);
+        }
+
+        LatencyHistogram histogram;
+        int failures = 0;
+        for (int i = 0; i < ticksPerMode; i++) {
+            QElapsedTimer timer;
+            timer.start();
+            const bool ok = worker.readTelemetry(mode);
+            const qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+            if (ok) {
+                histogram.record(elapsedUs);
+            } else {
+                failures++;
+            }
+        }
+
+        BenchmarkResult result;
+        result.mode = mode;
+        result.ticks = static_cast<int>(histogram.count());
+        result.failures = failures;
+        result.transactionsPerTick = worker.transactionsPerTick(mode);
+        result.meanTickUs = histogram.meanUs();
+        result.p99TickUs = histogram.percentileUs(99.0);
+        result.maxSampleRateHz = result.meanTickUs > 0 ? 1e6 / result.meanTickUs : 0.0;
+        results.append(result);
+    }
+
+    return results;
+}
+
+void MotorWorker::logBenchmark(const QString &controllerAddress)
+{
+    ZMotionDriver driver;
+    if (!driver.connect(controllerAddress)) {
+        LOG_WARNING_STREAM("MotorWorker") << "Benchmark skipped: cannot connect to" << controllerAddress;
+        return;
+    }
+
+    const QVector<int> motorIds = {0, 1, 2, 3, 4, 5, 6, 7};
+    LOG_INFO_STREAM("MotorWorker") << "Motor telemetry benchmark," << motorIds.size()
+                                   << "motors, pos/speed/current, controller" << controllerAddress;
+
+    const QVector<BenchmarkResult> results = runBenchmark(motorIds);
+    for (const BenchmarkResult &r : results) {
+        LOG_INFO_STREAM("MotorWorker")
+            << QString("%1  %2 calls/tick  mean %3 ms  p99 %4 ms  max %5 Hz  (ok %6, failed %7)")
+                   .arg(readModeName(r.mode), -9)
+                   .arg(r.transactionsPerTick, 3)
+                   .arg(r.meanTickUs / 1000.0, 7, 'f', 2)
+                   .arg(r.p99TickUs / 1000.0, 7, 'f', 2)
+                   .arg(r.maxSampleRateHz, 7, 'f', 1)
+                   .arg(r.ticks)
+                   .arg(r.failures);
+    }
+
+    if (results.size() == 2 && results[1].meanTickUs > 0) {
+        LOG_INFO_STREAM("MotorWorker") << "Batched speedup:"
+                                       << QString::number(results[0].meanTickUs / results[1].meanTickUs, 'f', 1) << "x";
+    }
+
+    driver.disconnect();
+}
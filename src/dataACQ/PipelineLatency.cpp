@@ -0,0 +1,121 @@
+#include "dataACQ/PipelineLatency.h"
+#include <QMutexLocker>
+
+namespace {
+QString formatMs(qint64 us)
+{
+    return QString::number(us / 1000.0, 'f', 1);
+}
+} // namespace
+
+QString PipelineLatency::segmentName(Segment segment)
+{
+    switch (segment) {
+    case Acquire: return "acquire";
+    case Queue: return "queue";
+    case Commit: return "commit";
+    case Storage: return "storage";
+    case Render: return "render";
+    default: return "unknown";
+    }
+}
+
+void PipelineLatency::recordCommitted(const QVector<DataBlock> &blocks)
+{
+    QMutexLocker locker(&m_mutex);
+    for (const DataBlock &block : blocks) {
+        const PipelineTrace &trace = block.trace;
+        recordLocked(block.sensorType, Acquire, trace.elapsedUs(PipelineTrace::HardwareRead, PipelineTrace::Emitted));
+        recordLocked(block.sensorType, Queue, trace.elapsedUs(PipelineTrace::Enqueued, PipelineTrace::Dequeued));
+        recordLocked(block.sensorType, Commit, trace.elapsedUs(PipelineTrace::Dequeued, PipelineTrace::Committed));
+        recordLocked(block.sensorType, Storage, trace.elapsedUs(PipelineTrace::HardwareRead, PipelineTrace::Committed));
+    }
+}
+
+void PipelineLatency::recordRendered(const DataBlock &block)
+{
+    if (!block.trace.has(PipelineTrace::Emitted)) {
+        return;
+    }
+
+    const qint64 latencyUs = PipelineTrace::nowUs() - block.trace.at(PipelineTrace::Emitted);
+    QMutexLocker locker(&m_mutex);
+    recordLocked(block.sensorType, Render, latencyUs);
+}
+
+void PipelineLatency::recordLocked(SensorType type, Segment segment, qint64 latencyUs)
+{
+    if (latencyUs < 0) {
+        return;     // 阶段未记录（如回放块没有硬件读取时刻）
+    }
+
+    auto it = m_histograms.find(type);
+    if (it == m_histograms.end()) {
+        it = m_histograms.insert(type, QVector<LatencyHistogram>(SegmentCount));
+    }
+    (*it)[segment].record(latencyUs);
+}
+
+QVector<PipelineLatency::Row> PipelineLatency::snapshot() const
+{
+    QMutexLocker locker(&m_mutex);
+    QVector<Row> rows;
+    for (auto it = m_histograms.constBegin(); it != m_histograms.constEnd(); ++it) {
+        for (int segment = 0; segment < SegmentCount; ++segment) {
+            const LatencyHistogram &histogram = it.value()[segment];
+            if (histogram.count() == 0) {
+                continue;
+            }
+            rows.append({it.key(), static_cast<Segment>(segment), histogram.count(),
+                         histogram.percentileUs(50), histogram.percentileUs(99),
+                         histogram.maxUs(), histogram.meanUs()});
+        }
+    }
+    return rows;
+}
+
+QString PipelineLatency::summary() const
+{
+    QMutexLocker locker(&m_mutex);
+    QStringList parts;
+    for (auto it = m_histograms.constBegin(); it != m_histograms.constEnd(); ++it) {
+        const QVector<LatencyHistogram> &h = it.value();
+        QString text = sensorTypeToString(it.key());
+        if (h[Queue].count() > 0) {
+            text += " q99 " + formatMs(h[Queue].percentileUs(99));
+        }
+        if (h[Commit].count() > 0) {
+            text += " sql99 " + formatMs(h[Commit].percentileUs(99));
+        }
+        if (h[Render].count() > 0) {
+            text += " ui99 " + formatMs(h[Render].percentileUs(99));
+        }
+        if (h[Storage].count() > 0) {
+            text += QString(" e2e %1/%2/%3").arg(formatMs(h[Storage].percentileUs(50)),
+                                                 formatMs(h[Storage].percentileUs(99)),
+                                                 formatMs(h[Storage].maxUs()));
+        }
+        parts << text + " ms";
+    }
+    return parts.join(", ");
+}
+
+QStringList PipelineLatency::report() const
+{
+    QStringList lines;
+    for (const Row &row : snapshot()) {
+        lines << QString("%1 %2: n=%3 p50=%4 p99=%5 max=%6 mean=%7 ms")
+                 .arg(sensorTypeToString(row.sensorType), -18)
+                 .arg(segmentName(row.segment), -8)
+                 .arg(row.count)
+                 .arg(formatMs(row.p50Us), formatMs(row.p99Us), formatMs(row.maxUs))
+                 .arg(row.meanUs / 1000.0, 0, 'f', 1);
+    }
+    return lines;
+}
+
+void PipelineLatency::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_histograms.clear();
+}
@@ -0,0 +1,317 @@
+#include "dataACQ/ReplayWorker.h"
+#include "database/DataQuerier.h"
+#include "Logger.h"
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QThread>
+#include <cstring>
+#include <limits>
+
+ReplayWorker::ReplayWorker(Stream stream, QObject *parent)
+    : BaseWorker(parent)
+    , m_stream(stream)
+    , m_sourceRoundId(0)
+    , m_speed(1.0)
+    , m_blockDurationMs(100)
+    , m_firstChannel(0)
+    , m_channelCount(3)
+    , m_querier(nullptr)
+    , m_nextWindow(0)
+    , m_pendingIndex(0)
+    , m_sourceOriginUs(0)
+    , m_replayOriginUs(0)
+    , m_lastSourceUs(0)
+    , m_blocksReplayed(0)
+    , m_finished(false)
+{
+    LOG_DEBUG_STREAM("ReplayWorker") << "Created for stream" << streamName(stream);
+}
+
+ReplayWorker::~ReplayWorker()
+{
+    delete m_querier;
+}
+
+QString ReplayWorker::streamName(Stream stream)
+{
+    switch (stream) {
+    case Stream::Vibration: return "Vibration";
+    case Stream::Mdb: return "MDB";
+    case Stream::Motor: return "Motor";
+    }
+    return "Unknown";
+}
+
+void ReplayWorker::setSource(const QString &dbPath, int roundId)
+{
+    m_dbPath = dbPath;
+    m_sourceRoundId = roundId;
+}
+
+void ReplayWorker::setVibrationChannels(int firstChannel, int channelCount)
+{
+    m_firstChannel = qMax(0, firstChannel);
+    m_channelCount = qMax(1, channelCount);
+}
+
+bool ReplayWorker::initializeHardware()
+{
+    if (m_dbPath.isEmpty() || m_sourceRoundId <= 0) {
+        emitError("Replay source not configured");
+        return false;
+    }
+
+    // 查询连接在Worker线程中创建，不与DbWriter共用
+    delete m_querier;
+    m_querier = new DataQuerier(m_dbPath);
+    if (!m_querier->initialize()) {
+        emitError("Failed to open replay database: " + m_dbPath);
+        return false;
+    }
+
+    m_sourceOriginUs = -1;
+    for (const DataQuerier::RoundInfo &round : m_querier->getAllRounds()) {
+        if (round.roundId == m_sourceRoundId) {
+            m_sourceOriginUs = round.startTimeUs;
+            break;
+        }
+    }
+    m_windows = m_querier->getWindowTimestamps(m_sourceRoundId);
+    if (m_sourceOriginUs < 0 || m_windows.isEmpty()) {
+        emitError(QString("Replay round %1 not found or empty").arg(m_sourceRoundId));
+        return false;
+    }
+    // 轮次开始时刻晚于首个窗口（异常轮次）时以首个窗口为零点
+    m_sourceOriginUs = qMin(m_sourceOriginUs, m_windows.first());
+
+    m_nextWindow = 0;
+    m_pending.clear();
+    m_pendingIndex = 0;
+    m_lastSourceUs = m_sourceOriginUs;
+    m_blocksReplayed = 0;
+    m_finished = false;
+
+    LOG_INFO_STREAM("ReplayWorker") << streamName(m_stream) << "replay of round" << m_sourceRoundId
+                                    << ":" << m_windows.size() << "windows, speed"
+                                    << (m_speed > 0 ? QString("%1x").arg(m_speed) : QString("max"));
+    return true;
+}
+
+void ReplayWorker::shutdownHardware()
+{
+    if (m_querier) {
+        m_querier->close();
+        delete m_querier;
+        m_querier = nullptr;
+    }
+    m_pending.clear();
+    m_windows.clear();
+}
+
+void ReplayWorker::runAcquisition()
+{
+    m_replayOriginUs = currentTimestampUs();
+    m_wallTimer.start();
+
+    while (shouldContinue() && !m_finished) {
+        if (m_pendingIndex >= m_pending.size() && !loadNextWindow()) {
+            finishReplay();
+            break;
+        }
+        if (m_pendingIndex >= m_pending.size()) {
+            continue;   // 空窗口
+        }
+
+        DataBlock block = m_pending[m_pendingIndex++];
+        if (!waitUntil(block.startTimestampUs)) {
+            break;
+        }
+
+        // 平移到当前时间基，归入当前轮次
+        m_lastSourceUs = block.startTimestampUs;
+        block.startTimestampUs = m_replayOriginUs + (block.startTimestampUs - m_sourceOriginUs);
+        block.roundId = m_currentRoundId;
+        publishBlock(block);
+
+        m_blocksReplayed++;
+        m_samplesCollected += static_cast<qint64>(block.numSamples) * qMax(1, block.channelCount);
+        if (m_blocksReplayed % 100 == 0) {
+            const double elapsedSec = m_wallTimer.nsecsElapsed() / 1e9;
+            emit statisticsUpdated(m_samplesCollected, elapsedSec > 0 ? m_samplesCollected / elapsedSec : 0.0);
+        }
+    }
+
+    LOG_DEBUG_STREAM("ReplayWorker") << streamName(m_stream) << "replay loop ended, blocks:" << m_blocksReplayed;
+}
+
+bool ReplayWorker::waitUntil(qint64 sourceTimestampUs)
+{
+    if (m_speed > 0) {
+        const qint64 dueNs = static_cast<qint64>((sourceTimestampUs - m_sourceOriginUs) * 1000.0 / m_speed);
+        while (shouldContinue()) {
+            const qint64 remainingMs = (dueNs - m_wallTimer.nsecsElapsed()) / 1000000;
+            if (remainingMs <= 0) {
+                break;
+            }
+            QThread::msleep(static_cast<unsigned long>(qMin<qint64>(remainingMs, 10)));
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+        }
+    } else if (m_blocksReplayed % 64 == 0) {
+        // 尽快模式：定期让出事件循环处理stop/pause
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+
+    // 回放是可控负载：写入方跟不上时等待额度而不是丢块，尽快模式下即测得管线的最大吞吐
+    while (shouldContinue() && creditLevel() < MIN_CREDIT_LEVEL) {
+        QThread::msleep(1);
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+    return shouldContinue();
+}
+
+bool ReplayWorker::loadNextWindow()
+{
+    if (!m_querier || m_nextWindow >= m_windows.size()) {
+        return false;
+    }
+
+    m_pending.clear();
+    m_pendingIndex = 0;
+
+    const qint64 windowStartUs = m_windows[m_nextWindow++];
+    if (m_stream == Stream::Vibration) {
+        loadVibrationWindow(windowStartUs);
+    } else {
+        loadScalarWindow(windowStartUs);
+    }
+    return true;
+}
+
+void ReplayWorker::loadVibrationWindow(qint64 windowStartUs)
+{
+    const QList<DataQuerier::VibrationFrame> frames =
+        m_querier->getVibrationFrames(m_sourceRoundId, windowStartUs, windowStartUs + 1000000,
+                                      m_channelCount, m_firstChannel);
+
+    for (const DataQuerier::VibrationFrame &frame : frames) {
+        if (frame.numSamples <= 0 || frame.sampleRate <= 0) {
+            continue;
+        }
+
+        // 按块时长切分为打包子块，还原流式采集的块节奏（包络抽取帧按(min, max)对切分）
+        int chunk = qBound(1, static_cast<int>(frame.sampleRate * m_blockDurationMs / 1000.0), frame.numSamples);
+        if (frame.decimation > 1) {
+            chunk = qMin(frame.numSamples, qMax(2, chunk & ~1));
+        }
+        for (int offset = 0; offset < frame.numSamples; offset += chunk) {
+            const int n = qMin(chunk, frame.numSamples - offset);
+
+            DataBlock block;
+            block.sensorType = SensorType::Vibration_Packed;
+            block.channelId = m_firstChannel;
+            block.startTimestampUs = frame.startTimestampUs + static_cast<qint64>(offset * 1e6 / frame.sampleRate);
+            block.sampleRate = frame.sampleRate;
+            block.numSamples = n;
+            block.channelCount = frame.channelCount;
+            block.decimation = frame.decimation;
+            block.blobData.resize(frame.channelCount * n * static_cast<int>(sizeof(float)));
+
+            float *out = reinterpret_cast<float*>(block.blobData.data());
+            for (int ch = 0; ch < frame.channelCount; ++ch) {
+                memcpy(out + ch * n, frame.channel(ch) + offset, n * sizeof(float));
+            }
+            m_pending.append(block);
+        }
+    }
+}
+
+void ReplayWorker::loadScalarWindow(qint64 windowStartUs)
+{
+    const bool motor = (m_stream == Stream::Motor);
+    const SensorType firstType = motor ? SensorType::Motor_Position : SensorType::Force_Upper;
+    const SensorType lastType = motor ? SensorType::Motor_Current : SensorType::Position_MDB;
+
+    // 两种存储布局（scalar_samples / scalar_blocks）合并，按时间戳、类型、通道排序
+    const QVector<DataQuerier::ScalarSample> samples =
+        m_querier->getScalarSamples(m_sourceRoundId, windowStartUs, windowStartUs + 1000000,
+                                    firstType, lastType);
+
+    // 电机：同一时刻的各电机参数组装为一个快照块（与MotorWorker输出一致）
+    struct MotorSample { int param; int motorId; double value; };
+    QVector<MotorSample> tick;
+    qint64 tickTimestampUs = -1;
+
+    auto flushTick = [&]() {
+        if (tick.isEmpty()) {
+            return;
+        }
+        int channelCount = 0;
+        for (const MotorSample &sample : tick) {
+            channelCount = qMax(channelCount, sample.motorId + 1);
+        }
+
+        DataBlock block;
+        block.sensorType = SensorType::Motor_Snapshot;
+        block.channelId = 0;
+        block.startTimestampUs = tickTimestampUs;
+        block.sampleRate = m_sampleRate;
+        block.numSamples = 1;
+        block.channelCount = channelCount;
+        block.values.fill(std::numeric_limits<double>::quiet_NaN(),
+                          MotorSnapshot::ParamCount * channelCount);
+        for (const MotorSample &sample : tick) {
+            block.values[sample.param * channelCount + sample.motorId] = sample.value;
+        }
+        m_pending.append(block);
+        tick.clear();
+    };
+
+    for (const DataQuerier::ScalarSample &sample : samples) {
+        const int type = sample.sensorType;
+        const int channelId = sample.channelId;
+        const qint64 timestampUs = sample.timestampUs;
+        const double value = sample.value;
+
+        if (motor) {
+            if (channelId < 0 || channelId >= 64) {
+                continue;
+            }
+            if (timestampUs != tickTimestampUs) {
+                flushTick();
+                tickTimestampUs = timestampUs;
+            }
+            tick.append({type - static_cast<int>(SensorType::Motor_Position), channelId, value});
+        } else {
+            DataBlock block;
+            block.sensorType = static_cast<SensorType>(type);
+            block.channelId = channelId;
+            block.startTimestampUs = timestampUs;
+            block.sampleRate = m_sampleRate;
+            block.numSamples = 1;
+            block.values.append(value);
+            m_pending.append(block);
+        }
+    }
+    flushTick();
+}
+
+void ReplayWorker::finishReplay()
+{
+    m_finished = true;
+
+    const double wallSec = m_wallTimer.nsecsElapsed() / 1e9;
+    const double sourceSec = (m_lastSourceUs - m_sourceOriginUs) / 1e6;
+    const double achievedSpeed = wallSec > 0 ? sourceSec / wallSec : 0.0;
+
+    const QString summary = QString("%1回放结束：源轮次%2，%3个块，源时长%4秒，耗时%5秒，实际倍速%6x")
+                            .arg(streamName(m_stream))
+                            .arg(m_sourceRoundId)
+                            .arg(m_blocksReplayed)
+                            .arg(sourceSec, 0, 'f', 1)
+                            .arg(wallSec, 0, 'f', 1)
+                            .arg(achievedSpeed, 0, 'f', 2);
+    LOG_INFO_STREAM("ReplayWorker") << summary;
+    emit eventOccurred("ReplayFinished", summary);
+    emit statisticsUpdated(m_samplesCollected, wallSec > 0 ? m_samplesCollected / wallSec : 0.0);
+    emit replayFinished(m_blocksReplayed, achievedSpeed);
+}
@@ -0,0 +1,126 @@
+#include "dataACQ/SampleClock.h"
+#include <QtMath>
+
+SampleClock::SampleClock()
+{
+    reset(0.0);
+}
+
+void SampleClock::reset(double nominalRateHz)
+{
+    m_nominalRate = nominalRateHz;
+    m_sampleIndex = 0;
+    clearFit();
+    resetStatistics();
+    m_resyncs = 0;
+}
+
+void SampleClock::resetStatistics()
+{
+    m_statBlocks = 0;
+    m_residualSq = 0.0;
+    m_maxResidual = 0.0;
+}
+
+void SampleClock::clearFit()
+{
+    m_originIndex = 0;
+    m_originUs = 0;
+    m_sw = m_sx = m_sy = m_sxx = m_sxy = 0.0;
+    m_fitBlocks = 0;
+    m_periodUs = m_nominalRate > 0 ? 1e6 / m_nominalRate : 0.0;
+    m_interceptUs = 0.0;
+}
+
+qint64 SampleClock::onBlock(qint64 arrivalUs, int numSamples)
+{
+    if (numSamples <= 0 || m_nominalRate <= 0) {
+        return arrivalUs;
+    }
+
+    const qint64 firstIndex = m_sampleIndex;
+    const qint64 lastIndex = m_sampleIndex + numSamples - 1;
+    m_sampleIndex += numSamples;
+
+    if (m_fitBlocks == 0) {
+        m_originIndex = lastIndex;
+        m_originUs = arrivalUs;
+    }
+
+    // 新块在当前坐标系下的位置
+    double x = static_cast<double>(lastIndex - m_originIndex);
+    double y = static_cast<double>(arrivalUs - m_originUs);
+
+    // 先用旧模型预测，残差用于抖动统计和丢样检测
+    if (isLocked()) {
+        const double residual = y - (m_interceptUs + m_periodUs * x);
+        if (qAbs(residual) > RESYNC_THRESHOLD_US) {
+            clearFit();
+            m_originIndex = lastIndex;
+            m_originUs = arrivalUs;
+            x = y = 0.0;
+            m_resyncs++;
+        } else {
+            m_statBlocks++;
+            m_residualSq += residual * residual;
+            m_maxResidual = qMax(m_maxResidual, qAbs(residual));
+        }
+    }
+
+    // 平移坐标原点到新块，使加权和保持在小数值范围
+    m_sxy = m_sxy - x * m_sy - y * m_sx + x * y * m_sw;
+    m_sxx = m_sxx - 2.0 * x * m_sx + x * x * m_sw;
+    m_sx -= x * m_sw;
+    m_sy -= y * m_sw;
+    m_originIndex = lastIndex;
+    m_originUs = arrivalUs;
+
+    // 遗忘因子按块时长折算，使时间常数与块大小无关
+    const double decay = qExp(-numSamples / (m_nominalRate * TIME_CONSTANT_S));
+    m_sw = m_sw * decay + 1.0;
+    m_sx *= decay;
+    m_sy *= decay;
+    m_sxx *= decay;
+    m_sxy *= decay;
+    m_fitBlocks++;
+
+    // 加权最小二乘：y = intercept + period * x
+    const double nominalPeriod = 1e6 / m_nominalRate;
+    double period = nominalPeriod;
+    const double denom = m_sw * m_sxx - m_sx * m_sx;
+    if (isLocked() && denom > 0.0) {
+        period = (m_sw * m_sxy - m_sx * m_sy) / denom;
+    }
+    const double maxDeviation = nominalPeriod * MAX_DRIFT_PPM * 1e-6;
+    m_periodUs = qBound(nominalPeriod - maxDeviation, period, nominalPeriod + maxDeviation);
+    m_interceptUs = (m_sy - m_periodUs * m_sx) / m_sw;
+
+    // 首样本时刻 = 原点处模型时刻 - (块内样本数-1) × 周期
+    const double firstUs = m_interceptUs + m_periodUs * static_cast<double>(firstIndex - m_originIndex);
+    return m_originUs + qRound64(firstUs);
+}
+
+double SampleClock::driftPpm() const
+{
+    if (m_nominalRate <= 0 || m_periodUs <= 0) {
+        return 0.0;
+    }
+    return (estimatedRateHz() - m_nominalRate) / m_nominalRate * 1e6;
+}
+
+double SampleClock::jitterRmsUs() const
+{
+    return m_statBlocks > 0 ? qSqrt(m_residualSq / m_statBlocks) : 0.0;
+}
+
+QString SampleClock::summary() const
+{
+    return QString("nominal=%1Hz est=%2Hz drift=%3ppm jitter rms=%4ms max=%5ms blocks=%6 resync=%7")
+        .arg(m_nominalRate, 0, 'f', 1)
+        .arg(estimatedRateHz(), 0, 'f', 3)
+        .arg(driftPpm(), 0, 'f', 1)
+        .arg(jitterRmsUs() / 1000.0, 0, 'f', 2)
+        .arg(m_maxResidual / 1000.0, 0, 'f', 2)
+        .arg(m_statBlocks)
+        .arg(m_resyncs);
+}
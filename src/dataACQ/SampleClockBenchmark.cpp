@@ -0,0 +1,73 @@
+// SampleClock漂移校验（--bench-clock），仅在 qmake CONFIG+=bench 时编入
+#include "dataACQ/SampleClock.h"
+#include "Logger.h"
+#include <QtMath>
+
+QVector<SampleClock::DriftCheckResult> SampleClock::runDriftCheck(const QVector<double> &driftsPpm,
+                                                                  double nominalRateHz, int blockSamples, int seconds)
+{
+    const double transferDelayUs = 3000.0;      // 读回的固定延迟（由截距吸收）
+    const double jitterUs = 2000.0;             // 到达时刻的调度抖动（±）
+    const int windowSamples = static_cast<int>(nominalRateHz);
+    const int blocks = static_cast<int>(seconds * nominalRateHz / blockSamples);
+    const int warmupBlocks = static_cast<int>(10.0 * nominalRateHz / blockSamples);    // 前10秒不计（模型收敛）
+
+    QVector<DriftCheckResult> results;
+    for (double drift : driftsPpm) {
+        const double truePeriodUs = 1e6 / (nominalRateHz * (1.0 + drift * 1e-6));
+        const double nominalPeriodUs = 1e6 / nominalRateHz;
+
+        SampleClock clock;
+        clock.reset(nominalRateHz);
+        quint32 seed = 12345;
+
+        DriftCheckResult result;
+        result.driftPpm = drift;
+        result.nominalErrorUs = 0.0;
+        result.correctedErrorUs = 0.0;
+
+        for (int k = 0; k < blocks; ++k) {
+            // 块末样本的真实采样时刻 + 传输延迟 + 抖动 = 主机看到的到达时刻
+            seed = seed * 1664525u + 1013904223u;
+            const double jitter = ((seed >> 8) / 16777216.0 - 0.5) * 2.0 * jitterUs;
+            const qint64 lastIndex = static_cast<qint64>(k + 1) * blockSamples - 1;
+            const qint64 arrivalUs = qRound64(lastIndex * truePeriodUs + transferDelayUs + jitter);
+            clock.onBlock(arrivalUs, blockSamples);
+
+            if (k < warmupBlocks) {
+                continue;
+            }
+
+            // 下游按 起始时间戳 + i / sampleRate 递推：检查1秒窗口末样本相对首样本的偏移
+            const double trueSpanUs = (windowSamples - 1) * truePeriodUs;
+            const double correctedSpanUs = (windowSamples - 1) * 1e6 / clock.estimatedRateHz();
+            const double nominalSpanUs = (windowSamples - 1) * nominalPeriodUs;
+            result.correctedErrorUs = qMax(result.correctedErrorUs, qAbs(correctedSpanUs - trueSpanUs));
+            result.nominalErrorUs = qMax(result.nominalErrorUs, qAbs(nominalSpanUs - trueSpanUs));
+        }
+        result.estimatedPpm = clock.driftPpm();
+        results.append(result);
+    }
+    return results;
+}
+
+bool SampleClock::logDriftCheck()
+{
+    const double rate = 5000.0;
+    const double halfPeriodUs = 0.5e6 / rate;
+
+    LOG_INFO_STREAM("SampleClock") << "Drift check," << rate << "Hz, 100 ms blocks, per-sample time error over a 1 s window";
+    bool passed = true;
+    for (const DriftCheckResult &r : runDriftCheck({0.0, 50.0, 200.0, -500.0, 1000.0}, rate)) {
+        const bool ok = r.correctedErrorUs < halfPeriodUs;
+        passed = passed && ok;
+        LOG_INFO_STREAM("SampleClock")
+            << QString("drift %1 ppm  estimated %2 ppm  nominal rate err %3 us  estimated rate err %4 us  %5")
+                   .arg(r.driftPpm, 7, 'f', 1)
+                   .arg(r.estimatedPpm, 7, 'f', 1)
+                   .arg(r.nominalErrorUs, 7, 'f', 1)
+                   .arg(r.correctedErrorUs, 7, 'f', 2)
+                   .arg(ok ? "ok" : "FAILED");
+    }
+    return passed;
+}
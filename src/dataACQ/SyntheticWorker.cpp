@@ -0,0 +1,236 @@
+#include "dataACQ/SyntheticWorker.h"
+#include "Logger.h"
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QThread>
+#include <QtMath>
+
+SyntheticWorker::SyntheticWorker(QObject *parent)
+    : BaseWorker(parent)
+    , m_channelCount(3)
+    , m_blockDurationMs(100)
+    , m_rate(0.0)
+    , m_rngState(0x9E3779B97F4A7C15ULL)
+    , m_bufferPool(256)
+    , m_originUs(0)
+    , m_sampleIndex(0)
+    , m_reportSamples(0)
+    , m_reportNs(0)
+    , m_reportDenied(0)
+    , m_startDenied(0)
+    , m_startDropped(0)
+    , m_achievedRate(0.0)
+    , m_minAchievedRate(0.0)
+{
+    m_sampleRate = 5000.0;
+    setChannelCount(3);
+    LOG_DEBUG("SyntheticWorker", "Created. Default: 5000Hz, 3 channels");
+}
+
+SyntheticWorker::~SyntheticWorker()
+{
+}
+
+void SyntheticWorker::setChannelCount(int count)
+{
+    m_channelCount = qBound(1, count, MAX_CHANNELS);
+    while (m_signals.size() < m_channelCount) {
+        // 各通道错开频率，便于在波形页区分
+        ChannelSignal signal;
+        signal.sineFrequency = 50.0 * (m_signals.size() + 1);
+        m_signals.append(signal);
+    }
+}
+
+void SyntheticWorker::setChannelSignal(int channel, const ChannelSignal &signal)
+{
+    if (channel < 0 || channel >= MAX_CHANNELS) {
+        return;
+    }
+    if (channel >= m_signals.size()) {
+        setChannelCount(qMax(m_channelCount, channel + 1));
+    }
+    m_signals[channel] = signal;
+}
+
+bool SyntheticWorker::initializeHardware()
+{
+    m_rate = qBound(1.0, sampleRate(), MAX_SAMPLE_RATE);
+
+    // 相量步进、冲击衰减与触发概率按采样率预先计算
+    m_states.resize(m_channelCount);
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        const ChannelSignal &signal = m_signals[ch];
+        ChannelState &state = m_states[ch];
+        const double omega = 2.0 * M_PI * signal.sineFrequency / m_rate;
+        state = ChannelState();
+        state.stepRe = qCos(omega);
+        state.stepIm = qSin(omega);
+        state.impulseDecay = static_cast<float>(qExp(-1000.0 / (m_rate * qMax(0.01, signal.impulseDecayMs))));
+        state.impulseProbability = qMax(0.0, signal.impulseRate) / m_rate;
+    }
+
+    const int blockSize = qMax(1, static_cast<int>(m_rate * m_blockDurationMs / 1000.0));
+    m_bufferPool.reserve(8, m_channelCount * blockSize * static_cast<int>(sizeof(float)));
+
+    m_sampleIndex = 0;
+    m_reportSamples = 0;
+    m_reportNs = 0;
+    m_startDenied = creditGate() ? creditGate()->deniedCount() : 0;
+    m_startDropped = outputRing() ? outputRing()->droppedCount() : 0;
+    m_reportDenied = m_startDenied;
+    m_achievedRate = 0.0;
+    m_minAchievedRate = m_rate;
+
+    LOG_INFO_STREAM("SyntheticWorker") << "Generating" << m_channelCount << "channels @" << m_rate
+                                       << "Hz, block" << blockSize << "samples";
+    return true;
+}
+
+void SyntheticWorker::shutdownHardware()
+{
+    if (m_wallTimer.isValid()) {
+        reportRate(true);
+        m_wallTimer.invalidate();
+    }
+}
+
+void SyntheticWorker::runAcquisition()
+{
+    const int blockSize = qMax(1, static_cast<int>(m_rate * m_blockDurationMs / 1000.0));
+    const int bytes = m_channelCount * blockSize * static_cast<int>(sizeof(float));
+
+    m_originUs = currentTimestampUs();
+    m_wallTimer.start();
+
+    while (shouldContinue()) {
+        // 按墙钟计算应生成的样本数；落后时不休眠，连续生成追赶
+        const qint64 elapsedNs = m_wallTimer.nsecsElapsed();
+        const qint64 dueSamples = static_cast<qint64>(elapsedNs * m_rate / 1e9);
+
+        if (m_sampleIndex + blockSize <= dueSamples) {
+            PooledBuffer packed = m_bufferPool.acquire(bytes);
+            generateBlock(packed.dataAs<float>(), blockSize);
+
+            DataBlock block;
+            block.roundId = m_currentRoundId;
+            block.sensorType = SensorType::Vibration_Packed;
+            block.channelId = 0;
+            block.startTimestampUs = m_originUs + static_cast<qint64>(m_sampleIndex * 1e6 / m_rate);
+            block.sampleRate = m_rate;
+            block.numSamples = blockSize;
+            block.channelCount = m_channelCount;
+            block.pooledData = packed;
+            publishBlock(block);
+
+            m_sampleIndex += blockSize;
+            m_samplesCollected += static_cast<qint64>(blockSize) * m_channelCount;
+        } else {
+            QThread::msleep(1);
+        }
+
+        if (elapsedNs - m_reportNs >= 1000000000LL) {
+            reportRate(false);
+        }
+
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+    }
+}
+
+double SyntheticWorker::nextUniform()
+{
+    // xorshift64*，取高53位映射到[0, 1)
+    m_rngState ^= m_rngState >> 12;
+    m_rngState ^= m_rngState << 25;
+    m_rngState ^= m_rngState >> 27;
+    return static_cast<double>((m_rngState * 0x2545F4914F6CDD1DULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void SyntheticWorker::generateBlock(float *base, int numSamples)
+{
+    // Irwin-Hall近似高斯：4个均匀分布之和的标准差为1/√3
+    static const double NOISE_SCALE = qSqrt(3.0);
+
+    for (int ch = 0; ch < m_channelCount; ++ch) {
+        const ChannelSignal &signal = m_signals[ch];
+        ChannelState &state = m_states[ch];
+        float *out = base + ch * numSamples;
+        const double noiseScale = signal.noiseRms * NOISE_SCALE;
+
+        for (int i = 0; i < numSamples; ++i) {
+            double value = signal.sineAmplitude * state.im;
+            const double re = state.re * state.stepRe - state.im * state.stepIm;
+            state.im = state.re * state.stepIm + state.im * state.stepRe;
+            state.re = re;
+
+            if (noiseScale > 0.0) {
+                value += (nextUniform() + nextUniform() + nextUniform() + nextUniform() - 2.0) * noiseScale;
+            }
+
+            if (state.impulseProbability > 0.0 && nextUniform() < state.impulseProbability) {
+                state.impulse = static_cast<float>(nextUniform() < 0.5 ? signal.impulseAmplitude
+                                                                      : -signal.impulseAmplitude);
+            }
+            value += state.impulse;
+            state.impulse *= state.impulseDecay;
+
+            out[i] = static_cast<float>(value);
+        }
+
+        // 相量归一化，抵消递推的幅值漂移
+        const double magnitude = qSqrt(state.re * state.re + state.im * state.im);
+        if (magnitude > 0.0) {
+            state.re /= magnitude;
+            state.im /= magnitude;
+        }
+    }
+}
+
+void SyntheticWorker::reportRate(bool final)
+{
+    const qint64 nowNs = m_wallTimer.nsecsElapsed();
+    const double intervalSec = (nowNs - m_reportNs) / 1e9;
+    const qint64 denied = creditGate() ? creditGate()->deniedCount() : 0;
+    const qint64 dropped = outputRing() ? outputRing()->droppedCount() : 0;
+
+    if (intervalSec > 0) {
+        m_achievedRate = (m_sampleIndex - m_reportSamples) / intervalSec;
+        if (!final) {
+            m_minAchievedRate = qMin(m_minAchievedRate, m_achievedRate);
+        }
+    }
+
+    if (!final) {
+        emit statisticsUpdated(m_samplesCollected, m_achievedRate);
+
+        // 生成跟不上（CPU不足）或管线拒绝写入时告警
+        const qint64 deniedInInterval = denied - m_reportDenied;
+        if (m_achievedRate < m_rate * 0.98 || deniedInInterval > 0) {
+            LOG_WARNING_STREAM("SyntheticWorker")
+                << "Requested" << m_rate << "Hz x" << m_channelCount << "ch, achieved"
+                << QString::number(m_achievedRate, 'f', 0) << "Hz, credit denied blocks:" << deniedInInterval
+                << ", write credit level:" << QString::number(creditLevel() * 100.0, 'f', 1) << "%";
+        }
+        m_reportSamples = m_sampleIndex;
+        m_reportNs = nowNs;
+        m_reportDenied = denied;
+        return;
+    }
+
+    // 运行结束：整体速率写入events表
+    const double totalSec = nowNs / 1e9;
+    const double overallRate = totalSec > 0 ? m_sampleIndex / totalSec : 0.0;
+    const QString summary =
+        QString("合成负载：请求%1Hz×%2通道，实际平均%3Hz（%4%），最低1秒速率%5Hz，"
+                "运行%6秒，额度拒绝%7块，环形队列丢弃%8块")
+            .arg(m_rate, 0, 'f', 0)
+            .arg(m_channelCount)
+            .arg(overallRate, 0, 'f', 0)
+            .arg(overallRate / m_rate * 100.0, 0, 'f', 1)
+            .arg(m_minAchievedRate, 0, 'f', 0)
+            .arg(totalSec, 0, 'f', 1)
+            .arg(denied - m_startDenied)
+            .arg(dropped - m_startDropped);
+    LOG_INFO_STREAM("SyntheticWorker") << summary;
+    emit eventOccurred("SyntheticLoadSummary", summary);
+}
@@ -0,0 +1,274 @@
+#include "dataACQ/VibrationKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VIBRATION_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang需要为单个函数开启指令集；MSVC可直接使用intrinsics
+#if defined(VIBRATION_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define KERNEL_TARGET(isa)
+#endif
+
+namespace {
+
+void deinterleaveScalar(const double *src, int frames, float *const out[3],
+                        const ChannelCalibration cal[3])
+{
+    float *ch0 = out[0];
+    float *ch1 = out[1];
+    float *ch2 = out[2];
+    const double g0 = cal[0].gain, o0 = cal[0].offset;
+    const double g1 = cal[1].gain, o1 = cal[1].offset;
+    const double g2 = cal[2].gain, o2 = cal[2].offset;
+
+    for (int i = 0; i < frames; ++i) {
+        const double *frame = src + i * 4;
+        ch0[i] = static_cast<float>(frame[0] * g0 + o0);
+        ch1[i] = static_cast<float>(frame[1] * g1 + o1);
+        ch2[i] = static_cast<float>(frame[2] * g2 + o2);
+        // frame[3]（第4通道）被忽略
+    }
+}
+
+#if defined(VIBRATION_KERNELS_X86)
+
+KERNEL_TARGET("sse2")
+void deinterleaveSse2(const double *src, int frames, float *const out[3],
+                      const ChannelCalibration cal[3])
+{
+    float *ch0 = out[0];
+    float *ch1 = out[1];
+    float *ch2 = out[2];
+    const __m128d g0 = _mm_set1_pd(cal[0].gain), o0 = _mm_set1_pd(cal[0].offset);
+    const __m128d g1 = _mm_set1_pd(cal[1].gain), o1 = _mm_set1_pd(cal[1].offset);
+    const __m128d g2 = _mm_set1_pd(cal[2].gain), o2 = _mm_set1_pd(cal[2].offset);
+
+    int i = 0;
+    // 每次处理4帧：两组2帧解交织后拼接成4个float
+    for (; i + 4 <= frames; i += 4) {
+        const double *p = src + i * 4;
+
+        // 帧i, i+1: [c0 c1] [c2 c3]
+        __m128d a01 = _mm_loadu_pd(p + 0);
+        __m128d a23 = _mm_loadu_pd(p + 2);
+        __m128d b01 = _mm_loadu_pd(p + 4);
+        __m128d b23 = _mm_loadu_pd(p + 6);
+        // 帧i+2, i+3
+        __m128d c01 = _mm_loadu_pd(p + 8);
+        __m128d c23 = _mm_loadu_pd(p + 10);
+        __m128d d01 = _mm_loadu_pd(p + 12);
+        __m128d d23 = _mm_loadu_pd(p + 14);
+
+        __m128d x0 = _mm_add_pd(_mm_mul_pd(_mm_unpacklo_pd(a01, b01), g0), o0);
+        __m128d y0 = _mm_add_pd(_mm_mul_pd(_mm_unpackhi_pd(a01, b01), g1), o1);
+        __m128d z0 = _mm_add_pd(_mm_mul_pd(_mm_unpacklo_pd(a23, b23), g2), o2);
+        __m128d x1 = _mm_add_pd(_mm_mul_pd(_mm_unpacklo_pd(c01, d01), g0), o0);
+        __m128d y1 = _mm_add_pd(_mm_mul_pd(_mm_unpackhi_pd(c01, d01), g1), o1);
+        __m128d z1 = _mm_add_pd(_mm_mul_pd(_mm_unpacklo_pd(c23, d23), g2), o2);
+
+        _mm_storeu_ps(ch0 + i, _mm_movelh_ps(_mm_cvtpd_ps(x0), _mm_cvtpd_ps(x1)));
+        _mm_storeu_ps(ch1 + i, _mm_movelh_ps(_mm_cvtpd_ps(y0), _mm_cvtpd_ps(y1)));
+        _mm_storeu_ps(ch2 + i, _mm_movelh_ps(_mm_cvtpd_ps(z0), _mm_cvtpd_ps(z1)));
+    }
+
+    // 尾部不足4帧用标量处理
+    if (i < frames) {
+        float *const tail[3] = {ch0 + i, ch1 + i, ch2 + i};
+        deinterleaveScalar(src + i * 4, frames - i, tail, cal);
+    }
+}
+
+KERNEL_TARGET("avx2")
+void deinterleaveAvx2(const double *src, int frames, float *const out[3],
+                      const ChannelCalibration cal[3])
+{
+    float *ch0 = out[0];
+    float *ch1 = out[1];
+    float *ch2 = out[2];
+    const __m256d g0 = _mm256_set1_pd(cal[0].gain), o0 = _mm256_set1_pd(cal[0].offset);
+    const __m256d g1 = _mm256_set1_pd(cal[1].gain), o1 = _mm256_set1_pd(cal[1].offset);
+    const __m256d g2 = _mm256_set1_pd(cal[2].gain), o2 = _mm256_set1_pd(cal[2].offset);
+
+    int i = 0;
+    // 每次处理4帧：4x4 double转置，取前3列
+    for (; i + 4 <= frames; i += 4) {
+        const double *p = src + i * 4;
+        __m256d r0 = _mm256_loadu_pd(p + 0);
+        __m256d r1 = _mm256_loadu_pd(p + 4);
+        __m256d r2 = _mm256_loadu_pd(p + 8);
+        __m256d r3 = _mm256_loadu_pd(p + 12);
+
+        __m256d t0 = _mm256_unpacklo_pd(r0, r1);  // r0c0 r1c0 r0c2 r1c2
+        __m256d t1 = _mm256_unpackhi_pd(r0, r1);  // r0c1 r1c1 r0c3 r1c3
+        __m256d t2 = _mm256_unpacklo_pd(r2, r3);  // r2c0 r3c0 r2c2 r3c2
+        __m256d t3 = _mm256_unpackhi_pd(r2, r3);  // r2c1 r3c1 r2c3 r3c3
+
+        __m256d x = _mm256_permute2f128_pd(t0, t2, 0x20);
+        __m256d y = _mm256_permute2f128_pd(t1, t3, 0x20);
+        __m256d z = _mm256_permute2f128_pd(t0, t2, 0x31);
+
+        x = _mm256_add_pd(_mm256_mul_pd(x, g0), o0);
+        y = _mm256_add_pd(_mm256_mul_pd(y, g1), o1);
+        z = _mm256_add_pd(_mm256_mul_pd(z, g2), o2);
+
+        _mm_storeu_ps(ch0 + i, _mm256_cvtpd_ps(x));
+        _mm_storeu_ps(ch1 + i, _mm256_cvtpd_ps(y));
+        _mm_storeu_ps(ch2 + i, _mm256_cvtpd_ps(z));
+    }
+
+    if (i < frames) {
+        float *const tail[3] = {ch0 + i, ch1 + i, ch2 + i};
+        deinterleaveScalar(src + i * 4, frames - i, tail, cal);
+    }
+}
+
+bool cpuHasAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) {
+        return false;
+    }
+    // 操作系统需保存YMM寄存器状态
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool cpuHasSse2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;  // x86-64基线指令集
+#elif defined(_MSC_VER)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif // VIBRATION_KERNELS_X86
+
+VibrationKernels::Isa detectIsa()
+{
+#if defined(VIBRATION_KERNELS_X86)
+    if (cpuHasAvx2()) {
+        return VibrationKernels::Isa::AVX2;
+    }
+    if (cpuHasSse2()) {
+        return VibrationKernels::Isa::SSE2;
+    }
+#endif
+    return VibrationKernels::Isa::Scalar;
+}
+
+} // namespace
+
+VibrationKernels::Isa VibrationKernels::activeIsa()
+{
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+bool VibrationKernels::isSupported(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar:
+        return true;
+    case Isa::SSE2:
+        return activeIsa() != Isa::Scalar;
+    case Isa::AVX2:
+        return activeIsa() == Isa::AVX2;
+    }
+    return false;
+}
+
+QString VibrationKernels::isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar: return "Scalar";
+    case Isa::SSE2: return "SSE2";
+    case Isa::AVX2: return "AVX2";
+    }
+    return "Unknown";
+}
+
+void VibrationKernels::fusedDeinterleave(const double *interleaved, int frames,
+                                         float *const out[3], const ChannelCalibration calibration[3])
+{
+    fusedDeinterleave(activeIsa(), interleaved, frames, out, calibration);
+}
+
+bool VibrationKernels::fusedDeinterleave(Isa isa, const double *interleaved, int frames,
+                                         float *const out[3], const ChannelCalibration calibration[3])
+{
+    if (!isSupported(isa)) {
+        return false;
+    }
+    if (!interleaved || frames <= 0) {
+        return true;
+    }
+
+    switch (isa) {
+#if defined(VIBRATION_KERNELS_X86)
+    case Isa::AVX2:
+        deinterleaveAvx2(interleaved, frames, out, calibration);
+        return true;
+    case Isa::SSE2:
+        deinterleaveSse2(interleaved, frames, out, calibration);
+        return true;
+#endif
+    default:
+        deinterleaveScalar(interleaved, frames, out, calibration);
+        return true;
+    }
+}
+
+int VibrationKernels::envelopeDecimate(const float *in, int n, int factor, float *out)
+{
+    if (!in || !out || n <= 0 || factor < 2) {
+        return 0;
+    }
+
+    // 写位置(2*bucket)始终不超过该桶的读起点(bucket*factor)，可安全原地处理
+    int written = 0;
+    for (int start = 0; start < n; start += factor) {
+        const int end = qMin(n, start + factor);
+        int minIndex = start;
+        int maxIndex = start;
+        for (int i = start + 1; i < end; ++i) {
+            if (in[i] < in[minIndex]) {
+                minIndex = i;
+            }
+            if (in[i] > in[maxIndex]) {
+                maxIndex = i;
+            }
+        }
+        const float minValue = in[minIndex];
+        const float maxValue = in[maxIndex];
+        out[written++] = minIndex <= maxIndex ? minValue : maxValue;
+        out[written++] = minIndex <= maxIndex ? maxValue : minValue;
+    }
+    return written;
+}
@@ -0,0 +1,94 @@
+// VibrationKernels融合解交织微基准（--bench-kernels），仅在 qmake CONFIG+=bench 时编入
+#include "dataACQ/VibrationKernels.h"
+#include "Logger.h"
+#include <QElapsedTimer>
+#include <cmath>
+
+QVector<VibrationKernels::BenchmarkResult> VibrationKernels::runBenchmark(const QVector<int> &sampleRates,
+                                                                          int minDurationMs)
+{
+    QVector<BenchmarkResult> results;
+    const Isa isas[] = {Isa::Scalar, Isa::SSE2, Isa::AVX2};
+
+    // 灵敏度100mV/g的默认标定
+    ChannelCalibration calibration[3];
+    for (ChannelCalibration &cal : calibration) {
+        cal.gain = 10.0f;
+        cal.offset = 0.0f;
+    }
+
+    for (int rate : sampleRates) {
+        if (rate <= 0) {
+            continue;
+        }
+
+        // 构造1秒数据块（模拟4通道正弦信号）
+        QVector<double> input(rate * 4);
+        for (int i = 0; i < rate; ++i) {
+            for (int ch = 0; ch < 4; ++ch) {
+                input[i * 4 + ch] = 0.5 * std::sin(0.01 * i + ch);
+            }
+        }
+
+        QVector<float> reference[3];
+        QVector<float> output[3];
+        for (int ch = 0; ch < 3; ++ch) {
+            reference[ch].resize(rate);
+            output[ch].resize(rate);
+        }
+        float *const refOut[3] = {reference[0].data(), reference[1].data(), reference[2].data()};
+        float *const benchOut[3] = {output[0].data(), output[1].data(), output[2].data()};
+        fusedDeinterleave(Isa::Scalar, input.constData(), rate, refOut, calibration);
+
+        for (Isa isa : isas) {
+            if (!isSupported(isa)) {
+                continue;
+            }
+
+            // 预热一次并校验结果
+            fusedDeinterleave(isa, input.constData(), rate, benchOut, calibration);
+            float maxError = 0.0f;
+            for (int ch = 0; ch < 3; ++ch) {
+                for (int i = 0; i < rate; ++i) {
+                    maxError = qMax(maxError, std::fabs(output[ch][i] - reference[ch][i]));
+                }
+            }
+
+            QElapsedTimer timer;
+            timer.start();
+            qint64 iterations = 0;
+            do {
+                fusedDeinterleave(isa, input.constData(), rate, benchOut, calibration);
+                ++iterations;
+            } while (timer.elapsed() < minDurationMs);
+            const qint64 elapsedNs = timer.nsecsElapsed();
+
+            BenchmarkResult result;
+            result.isa = isa;
+            result.sampleRate = rate;
+            result.nsPerBlock = static_cast<double>(elapsedNs) / iterations;
+            result.megaSamplesPerSec = (3.0 * rate * iterations) / (elapsedNs / 1e9) / 1e6;
+            result.maxAbsError = maxError;
+            results.append(result);
+        }
+    }
+
+    return results;
+}
+
+void VibrationKernels::logBenchmark()
+{
+    const QVector<int> rates = {5000, 10000, 20000, 50000, 100000};
+
+    LOG_INFO_STREAM("VibrationKernels") << "Fused deinterleave benchmark, active ISA:" << isaName(activeIsa());
+    const QVector<BenchmarkResult> results = runBenchmark(rates);
+    for (const BenchmarkResult &r : results) {
+        LOG_INFO_STREAM("VibrationKernels")
+            << QString("%1 Hz  %2  %3 us/block  %4 MS/s  err=%5")
+                   .arg(r.sampleRate, 6)
+                   .arg(isaName(r.isa), -6)
+                   .arg(r.nsPerBlock / 1000.0, 8, 'f', 2)
+                   .arg(r.megaSamplesPerSec, 8, 'f', 1)
+                   .arg(r.maxAbsError, 0, 'g', 3);
+    }
+}
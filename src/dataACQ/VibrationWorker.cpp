@@ -4,13 +4,27 @@
 #include <QCoreApplication>
 #include <QEventLoop>
 #include <QThread>
+#include <QtMath>
 
 VibrationWorker::VibrationWorker(QObject *parent)
     : BaseWorker(parent)
     , m_cardId(0)
     , m_channelCount(3)
-    , m_blockSize(1000)
+    , m_channelBase(0)
+    , m_blockSize(0)
+    , m_blockDurationMs(1000)
     , m_blockSequence(0)
+    , m_bufferPool(256)
+    , m_scratchAllocations(0)
+    , m_degradeMode(OutputMode::Decimate)
+    , m_outputMode(OutputMode::Full)
+    , m_decimationFactor(10)
+    , m_degradeBelow(0.25)
+    , m_recoverAbove(0.5)
+    , m_degradedSinceUs(-1)
+    , m_degradedBlocks(0)
+    , m_deepestMode(OutputMode::Full)
+    , m_summaryAllocations(0)
     , m_isCardConnected(false)
     , m_isSampling(false)
     , m_isDllLoaded(false)
@@ -23,9 +37,62 @@ VibrationWorker::VibrationWorker(QObject *parent)
     , m_fnGetFourChannel(nullptr)
 {
     m_sampleRate = 5000.0;  // 默认5000Hz
+
+    // 传感器灵敏度 100mV/g = 0.1V/g → g = V * 10
+    for (ChannelCalibration &cal : m_calibration) {
+        cal.gain = 10.0f;
+        cal.offset = 0.0f;
+    }
+
+    // 摘要缓冲按3通道预留，稳态下只改写不分配
+    for (QVector<double> &buffer : m_summaryBuffers) {
+        buffer.reserve(3 * VibrationSummary::StatCount);
+    }
     LOG_DEBUG("VibrationWorker", "Created. Default: 5000Hz, 3 channels, fixed port 8234");
 }
 
+void VibrationWorker::setChannelCalibration(int channel, float gain, float offset)
+{
+    if (channel < 0 || channel >= 3) {
+        return;
+    }
+    m_calibration[channel].gain = gain;
+    m_calibration[channel].offset = offset;
+}
+
+float VibrationWorker::quantStep() const
+{
+    // 有符号24位：满量程对应2^23个LSB
+    const double lsbVolts = VK701_REF_VOLTAGE / (1 << (VK701_ADC_BITS - 1));
+    float minGain = 0.0f;
+    for (int ch = 0; ch < qBound(1, m_channelCount, 3); ++ch) {
+        const float gain = qAbs(m_calibration[ch].gain);
+        if (gain > 0.0f && (minGain == 0.0f || gain < minGain)) {
+            minGain = gain;
+        }
+    }
+    return static_cast<float>(lsbVolts * minGain);
+}
+
+void VibrationWorker::setDegradePolicy(OutputMode mode, int decimationFactor,
+                                       double degradeBelow, double recoverAbove)
+{
+    m_degradeMode = mode;
+    m_decimationFactor = qBound(4, decimationFactor, 1000);
+    m_degradeBelow = qBound(SUMMARY_CREDIT_LEVEL, degradeBelow, 1.0);
+    m_recoverAbove = qBound(m_degradeBelow, recoverAbove, 1.0);
+}
+
+QString VibrationWorker::outputModeName(OutputMode mode)
+{
+    switch (mode) {
+    case OutputMode::Full: return "全速率波形";
+    case OutputMode::Decimate: return "包络抽取";
+    case OutputMode::SummaryOnly: return "只写摘要";
+    }
+    return "Unknown";
+}
+
 VibrationWorker::~VibrationWorker()
 {
     if (m_isSampling) {
@@ -95,7 +162,10 @@ bool VibrationWorker::initializeHardware()
     LOG_DEBUG_STREAM("VibrationWorker") << "  Card ID:" << m_cardId;
     LOG_DEBUG_STREAM("VibrationWorker") << "  TCP Port:" << VK701_TCP_PORT << "(fixed)";
     LOG_DEBUG_STREAM("VibrationWorker") << "  Sample Rate:" << m_sampleRate << "Hz";
-    LOG_DEBUG_STREAM("VibrationWorker") << "  Channels:" << m_channelCount;
+    LOG_DEBUG_STREAM("VibrationWorker") << "  Channels:" << m_channelCount << "(global" << m_channelBase
+                                        << "-" << m_channelBase + m_channelCount - 1 << ")";
+    LOG_DEBUG_STREAM("VibrationWorker") << "  Block size:" << effectiveBlockSize() << "points";
+    LOG_DEBUG_STREAM("VibrationWorker") << "  Kernel ISA:" << VibrationKernels::isaName(VibrationKernels::activeIsa());
 
     // Load DLL first
     if (!loadDll()) {
@@ -119,6 +189,15 @@ bool VibrationWorker::initializeHardware()
 
     m_blockSequence = 0;
 
+    // 预热缓冲池和原始缓冲区，稳态采集不再分配（UI队列中的块同样占用缓冲区）
+    const int readSize = effectiveBlockSize();
+    const int warmupBuffers = POOL_WARMUP_BUFFERS + (uiRing() ? uiRing()->capacity() : 0);
+    m_bufferPool.reserve(warmupBuffers, 3 * readSize * static_cast<int>(sizeof(float)));
+    if (m_rawBuffer.size() < 4 * readSize) {
+        m_rawBuffer.resize(4 * readSize);
+        m_scratchAllocations++;
+    }
+
     LOG_DEBUG("VibrationWorker", "Hardware initialized successfully");
     return true;
 }
@@ -130,6 +209,10 @@ void VibrationWorker::shutdownHardware()
     // 只停止采样，保持TCP连接（下次启动更快）
     stopSampling();
 
+    // 写出未满1秒的摘要，关闭进行中的降级区间
+    flushSummary();
+    endDegradedInterval(currentTimestampUs(), "采集停止");
+
     // 注意：不断开连接，保持 m_isCardConnected = true
     // 这样下次 initializeHardware() 时会跳过连接步骤
 
@@ -225,6 +308,11 @@ bool VibrationWorker::connectToCard(bool isTestMode)
         LOG_WARNING("VibrationWorker", "Server opened but no device connected");
         return false;
     }
+    if (curDeviceNum <= m_cardId) {
+        // 多卡时各卡陆续接入服务器，卡号超出当前设备数时仍尝试初始化（由configureChannels判定）
+        LOG_WARNING_STREAM("VibrationWorker") << "Card" << m_cardId << "requested but only"
+                                              << curDeviceNum << "device(s) connected";
+    }
 
     QThread::msleep(500);  // 等待设备枚举完全完成（参考例程）
 
@@ -287,7 +375,7 @@ bool VibrationWorker::configureChannels(bool isTestMode)
     const int maxRetries = 100;  // 测试模式最多重试100次
 
     // VK701初始化参数（参考vk701nsd）
-    double refVol = 1.0;           // 参考电压
+    double refVol = VK701_REF_VOLTAGE;  // 参考电压
     int bitMode = 2;               // 采样分辨率 (24位)
     int volRange = 0;              // 电压输入范围
 
@@ -367,56 +455,71 @@ void VibrationWorker::stopSampling()
     LOG_DEBUG("VibrationWorker", "Sampling stopped");
 }
 
+int VibrationWorker::effectiveBlockSize() const
+{
+    const int pointsPerSecond = qMax(1, static_cast<int>(m_sampleRate));
+    int points = m_blockSize;
+    if (points <= 0) {
+        points = static_cast<int>(static_cast<qint64>(pointsPerSecond) * m_blockDurationMs / 1000);
+    }
+    return qBound(1, points, pointsPerSecond);
+}
+
+qint64 VibrationWorker::heapAllocationCount() const
+{
+    return m_bufferPool.allocationCount() + m_scratchAllocations + m_summaryAllocations
+           + publishSignalCount();
+}
+
 bool VibrationWorker::readDataBlock()
 {
     if (!m_isDllLoaded) {
         return false;
     }
 
-    // 使用采样频率作为读取点数（与例程和Linux版本一致）
-    int readSize = static_cast<int>(m_sampleRate);
+    // 每次读取点数：默认等于采样频率（1秒/块，与例程和Linux版本一致），流式模式更短
+    int readSize = effectiveBlockSize();
 
-    // 分配缓冲区用于接收4通道数据（VK701硬件限制）
-    double *pucRecBuf = new double[4 * readSize];
+    // 复用接收缓冲区（4通道数据，VK701硬件限制），仅在采样率提高时扩容
+    if (m_rawBuffer.size() < 4 * readSize) {
+        m_rawBuffer.resize(4 * readSize);
+        m_scratchAllocations++;
+    }
+    double *pucRecBuf = m_rawBuffer.data();
 
     // Start sampling if needed to avoid restarting every read.
     if (!m_isSampling) {
         int result = m_fnStartSampling(m_cardId);
         if (result < 0) {
             LOG_WARNING_STREAM("VibrationWorker") << "VK70xNMC_StartSampling failed before read: error code" << result;
-            delete[] pucRecBuf;
             return false;
         }
         m_isSampling = true;
+        resetSampleClock();  // 样本序号从头开始
     }
 
-    // 读取4通道数据（第三个参数使用采样频率，与例程一致）
+    // 读取4通道数据（第三个参数为本块点数）
     int recv = m_fnGetFourChannel(m_cardId, pucRecBuf, readSize);
 
     if (recv > 0) {
+        // 读回后立即打时间戳：由采样时钟模型反推本块第一个样本的采样时刻
+        const qint64 firstSampleUs = sampleTimestampUs(recv);
+        markHardwareRead();
+
         // 成功读取数据
         // recv 是每个通道实际读取的采样点数
         // pucRecBuf 存储格式：[ch0[0], ch1[0], ch2[0], ch3[0], ch0[1], ch1[1], ...]
 
-        // 分离3个通道的数据（忽略第4通道）
-        float *ch0Data = new float[recv];
-        float *ch1Data = new float[recv];
-        float *ch2Data = new float[recv];
+        // 从缓冲池获取一块打包存储（SoA：X|Y|Z依次连续，DataBlock直接引用，用完自动归还）
+        PooledBuffer packed = m_bufferPool.acquire(3 * recv * static_cast<int>(sizeof(float)));
+        float *base = packed.dataAs<float>();
+        float *const channelOut[3] = { base, base + recv, base + 2 * recv };
 
-        for (int i = 0; i < recv; i++) {
-            ch0Data[i] = static_cast<float>(pucRecBuf[i * 4 + 0]);
-            ch1Data[i] = static_cast<float>(pucRecBuf[i * 4 + 1]);
-            ch2Data[i] = static_cast<float>(pucRecBuf[i * 4 + 2]);
-            // 第4通道 (pucRecBuf[i * 4 + 3]) 被忽略
-        }
+        // 一次遍历完成：解交织、丢弃第4通道、double→float、V→g标定
+        VibrationKernels::fusedDeinterleave(pucRecBuf, recv, channelOut, m_calibration);
 
         // 处理并发送数据
-        processAndSendData(ch0Data, ch1Data, ch2Data, recv);
-
-        delete[] ch0Data;
-        delete[] ch1Data;
-        delete[] ch2Data;
-        delete[] pucRecBuf;
+        processAndSendData(packed, recv, firstSampleUs);
 
         // 成功读取，重置失败计数器
         if (m_consecutiveFails > 0) {
@@ -442,78 +545,263 @@ bool VibrationWorker::readDataBlock()
         }
 
         LOG_WARNING_STREAM("VibrationWorker") << "VK70xNMC_GetFourChannel failed: error code" << recv;
-        delete[] pucRecBuf;
         return false;
     } else {
         // recv == 0，没有数据可读（与例程不同：例程中会在循环中等待）
-        delete[] pucRecBuf;
         QThread::msleep(1);  // 短暂延迟后重试（参考例程：1ms）
         return true;
     }
 }
 
-void VibrationWorker::processAndSendData(float *ch0Data, float *ch1Data, float *ch2Data, int numSamples)
+void VibrationWorker::processAndSendData(PooledBuffer &packedData, int numSamples, qint64 firstSampleUs)
 {
     // 检查数据有效性
-    if (!ch0Data || !ch1Data || !ch2Data || numSamples <= 0) {
+    if (packedData.isNull() || numSamples <= 0) {
         return;
     }
 
-    // 单位换算：传感器灵敏度 100mV/g = 0.1V/g
-    // VK701返回电压值(V)，需要转换为加速度(g)
-    // g = V / 0.1 = V * 10
-    const float sensitivity = 0.1f;  // 100mV/g = 0.1V/g
+    // 通道数据已由融合内核换算为加速度(g)
+    const int channelCount = qBound(1, m_channelCount, 3);
 
-    // 计算当前块的起始时间戳
-    qint64 blockTimestamp = currentTimestampUs();
+    // 按DbWriter剩余写入额度选择输出模式
+    updateOutputMode(firstSampleUs);
 
-    // 为每个通道创建DataBlock并发送
-    for (int ch = 0; ch < m_channelCount; ++ch) {
-        DataBlock block;
-        block.roundId = m_currentRoundId;
-        block.channelId = ch;
-        block.startTimestampUs = blockTimestamp;
-        block.sampleRate = m_sampleRate;
-        block.numSamples = numSamples;
-
-        // 设置传感器类型
-        if (ch == 0) {
-            block.sensorType = SensorType::Vibration_X;
-        } else if (ch == 1) {
-            block.sensorType = SensorType::Vibration_Y;
-        } else {
-            block.sensorType = SensorType::Vibration_Z;
-        }
-
-        // 选择对应通道数据并换算单位
-        float *channelData = (ch == 0) ? ch0Data : (ch == 1) ? ch1Data : ch2Data;
-
-        // 创建换算后的数据缓冲区
-        QVector<float> convertedData(numSamples);
-        for (int i = 0; i < numSamples; ++i) {
-            convertedData[i] = channelData[i] / sensitivity;  // V → g
+    if (m_outputMode == OutputMode::SummaryOnly) {
+        // 只写摘要：波形不发布，缓冲区随packedData析构归还
+        accumulateSummary(packedData, channelCount, numSamples, firstSampleUs);
+    } else {
+        int outSamples = numSamples;
+        // 采样时钟估计的实际采样率：下游按 起始时间戳 + i / sampleRate 递推逐样本时间，
+        // 用标称值时晶振漂移会在块内和1秒窗口内累积（200ppm @ 1s = 200us，即一个采样周期）
+        const double clockRate = m_sampleClock.estimatedRateHz() > 0 ? m_sampleClock.estimatedRateHz() : m_sampleRate;
+        double outRate = clockRate;
+        int decimation = 1;             // 包络抽取因子（1 = 原始波形）
+
+        if (m_outputMode == OutputMode::Decimate) {
+            // 抽取只保留min/max，RMS/均值在抽取前按全速率样本累加，每秒输出摘要块
+            accumulateSummary(packedData, channelCount, numSamples, firstSampleUs);
+
+            // 包络抽取：各通道原地压缩到缓冲区前部，仍保持SoA布局
+            const int decimated = 2 * ((numSamples + m_decimationFactor - 1) / m_decimationFactor);
+            if (decimated < numSamples) {
+                float *base = packedData.dataAs<float>();
+                for (int ch = 0; ch < channelCount; ++ch) {
+                    VibrationKernels::envelopeDecimate(base + ch * numSamples, numSamples,
+                                                       m_decimationFactor, base + ch * decimated);
+                }
+                outSamples = decimated;
+                outRate = clockRate * 2.0 / m_decimationFactor;
+                decimation = m_decimationFactor;
+            }
         }
 
-        // 将换算后的float数组转换为BLOB
-        block.blobData = QByteArray(
-            reinterpret_cast<const char*>(convertedData.constData()),
-            numSamples * sizeof(float)
-        );
+        // 一帧只发送一个打包块：单一时间戳、单次分发，各通道天然采样对齐
+        DataBlock block;
+        block.roundId = m_currentRoundId;
+        block.sensorType = SensorType::Vibration_Packed;
+        block.channelId = m_channelBase;
+        block.startTimestampUs = firstSampleUs;
+        block.sampleRate = outRate;
+        block.numSamples = outSamples;
+        block.channelCount = channelCount;
+        block.quantStep = quantStep();      // 抽取只挑选原样本，步长不变
+        block.decimation = decimation;      // 读取端据此区分包络对与原始波形
+
+        // 池化缓冲区直接作为BLOB载荷，无需拷贝（通道数不足3时截掉尾部通道）
+        packedData.setSize(channelCount * outSamples * static_cast<int>(sizeof(float)));
+        block.pooledData = packedData;
+
+        publishBlock(block);
+    }
 
-        // 发送数据块
-        emit dataBlockReady(block);
+    if (m_outputMode != OutputMode::Full) {
+        m_degradedBlocks++;
     }
 
     // 更新统计
-    m_samplesCollected += numSamples * m_channelCount;
+    m_samplesCollected += numSamples * channelCount;
     m_blockSequence++;
 
-    // 调试信息（每10个块输出一次，约10秒）
-    if (m_blockSequence % 10 == 0) {
+    // 调试信息（约每10秒输出一次，与块时长无关）
+    const int blocksPerLog = qMax(1, 10 * static_cast<int>(m_sampleRate) / qMax(1, numSamples));
+    if (m_blockSequence % blocksPerLog == 0) {
         LOG_DEBUG_STREAM("VibrationWorker")
             << "Block #" << m_blockSequence
             << ", Samples this block:" << numSamples
             << ", Total samples:" << m_samplesCollected
-            << ", Rate:" << m_sampleRate << "Hz";
+            << ", Rate:" << m_sampleRate << "Hz"
+            << ", Output:" << outputModeName(m_outputMode)
+            << ", Heap allocations:" << heapAllocationCount()
+            << "(pool acquires:" << m_bufferPool.acquireCount()
+            << ", in flight:" << m_bufferPool.outstandingCount() << ")";
     }
 }
+
+void VibrationWorker::updateOutputMode(qint64 timestampUs)
+{
+    if (m_degradeMode == OutputMode::Full || !creditGate()) {
+        return;
+    }
+
+    // 回差：低于degradeBelow降级，高于recoverAbove才恢复；额度几近耗尽时只写摘要
+    const double level = creditLevel();
+    OutputMode next = m_outputMode;
+    if (level < SUMMARY_CREDIT_LEVEL) {
+        next = OutputMode::SummaryOnly;
+    } else if (m_outputMode == OutputMode::Full) {
+        if (level < m_degradeBelow) {
+            next = m_degradeMode;
+        }
+    } else if (level >= m_recoverAbove) {
+        next = OutputMode::Full;
+    } else if (m_outputMode == OutputMode::SummaryOnly && level >= m_degradeBelow) {
+        next = m_degradeMode;
+    }
+
+    if (next == m_outputMode) {
+        return;
+    }
+
+    // 恢复全速率前写出未满1秒的摘要（包络抽取与只写摘要之间切换时摘要连续累加）
+    if (next == OutputMode::Full) {
+        flushSummary();
+    }
+
+    if (next == OutputMode::Full) {
+        endDegradedInterval(timestampUs, QString("剩余写入额度%1%").arg(level * 100.0, 0, 'f', 1));
+        return;
+    }
+
+    QString description;
+    if (m_outputMode == OutputMode::Full) {
+        m_degradedSinceUs = timestampUs;
+        m_degradedBlocks = 0;
+        m_deepestMode = next;
+        description = QString("DbWriter剩余写入额度%1%，振动输出降级为%2")
+                      .arg(level * 100.0, 0, 'f', 1).arg(outputModeName(next));
+    } else {
+        if (next == OutputMode::SummaryOnly) {
+            m_deepestMode = OutputMode::SummaryOnly;
+        }
+        description = QString("DbWriter剩余写入额度%1%，振动输出由%2切换为%3")
+                      .arg(level * 100.0, 0, 'f', 1).arg(outputModeName(m_outputMode), outputModeName(next));
+    }
+    if (next == OutputMode::Decimate) {
+        description += QString("（1/%1抽取，保留min/max，RMS/均值见每秒摘要）").arg(m_decimationFactor);
+    }
+
+    m_outputMode = next;
+    emit eventOccurred("BackpressureDegraded", description);
+    LOG_WARNING_STREAM("VibrationWorker") << description;
+}
+
+void VibrationWorker::endDegradedInterval(qint64 timestampUs, const QString &reason)
+{
+    m_outputMode = OutputMode::Full;
+    if (m_degradedSinceUs < 0) {
+        return;
+    }
+
+    const QString description =
+        QString("振动输出恢复全速率（%1）：降级区间 %2 ~ %3 us，持续%4秒，降级块%5个，最深模式：%6")
+            .arg(reason)
+            .arg(m_degradedSinceUs)
+            .arg(timestampUs)
+            .arg((timestampUs - m_degradedSinceUs) / 1e6, 0, 'f', 1)
+            .arg(m_degradedBlocks)
+            .arg(outputModeName(m_deepestMode));
+
+    m_degradedSinceUs = -1;
+    m_degradedBlocks = 0;
+    m_deepestMode = OutputMode::Full;
+
+    emit eventOccurred("BackpressureRecovered", description);
+    LOG_INFO_STREAM("VibrationWorker") << description;
+}
+
+void VibrationWorker::accumulateSummary(const PooledBuffer &packedData, int channelCount,
+                                        int numSamples, qint64 firstSampleUs)
+{
+    SummaryAccumulator &acc = m_summary;
+    if (acc.startUs < 0) {
+        acc.startUs = firstSampleUs;
+        acc.count = 0;
+        acc.channelCount = channelCount;
+        for (int ch = 0; ch < 3; ++ch) {
+            acc.min[ch] = std::numeric_limits<float>::max();
+            acc.max[ch] = std::numeric_limits<float>::lowest();
+            acc.sum[ch] = 0.0;
+            acc.sumSq[ch] = 0.0;
+        }
+    }
+
+    const float *base = packedData.constDataAs<float>();
+    for (int ch = 0; ch < acc.channelCount; ++ch) {
+        const float *data = base + ch * numSamples;
+        float minValue = acc.min[ch];
+        float maxValue = acc.max[ch];
+        double sum = 0.0;
+        double sumSq = 0.0;
+        for (int i = 0; i < numSamples; ++i) {
+            const float v = data[i];
+            minValue = qMin(minValue, v);
+            maxValue = qMax(maxValue, v);
+            sum += v;
+            sumSq += static_cast<double>(v) * v;
+        }
+        acc.min[ch] = minValue;
+        acc.max[ch] = maxValue;
+        acc.sum[ch] += sum;
+        acc.sumSq[ch] += sumSq;
+    }
+    acc.count += numSamples;
+
+    // 每秒一个摘要块
+    if (acc.count >= qMax(1, static_cast<int>(m_sampleRate))) {
+        flushSummary();
+    }
+}
+
+void VibrationWorker::flushSummary()
+{
+    SummaryAccumulator &acc = m_summary;
+    if (acc.startUs < 0 || acc.count <= 0) {
+        acc.startUs = -1;
+        return;
+    }
+
+    // 取一个下游已释放的摘要缓冲原地改写；全部仍被持有时改写会分离出新缓冲
+    QVector<double> *values = &m_summaryBuffers[0];
+    for (QVector<double> &buffer : m_summaryBuffers) {
+        if (buffer.isDetached()) {
+            values = &buffer;
+            break;
+        }
+    }
+    const int valueCount = acc.channelCount * VibrationSummary::StatCount;
+    if (!values->isDetached() || values->capacity() < valueCount) {
+        m_summaryAllocations++;
+    }
+    values->resize(valueCount);
+
+    for (int ch = 0; ch < acc.channelCount; ++ch) {
+        double *stats = values->data() + ch * VibrationSummary::StatCount;
+        stats[VibrationSummary::Min] = acc.min[ch];
+        stats[VibrationSummary::Max] = acc.max[ch];
+        stats[VibrationSummary::Rms] = qSqrt(acc.sumSq[ch] / acc.count);
+        stats[VibrationSummary::Mean] = acc.sum[ch] / acc.count;
+    }
+
+    DataBlock block;
+    block.roundId = m_currentRoundId;
+    block.sensorType = SensorType::Vibration_Summary;
+    block.channelId = m_channelBase;
+    block.startTimestampUs = acc.startUs;
+    block.sampleRate = m_sampleRate;
+    block.numSamples = acc.count;
+    block.channelCount = acc.channelCount;
+    block.values = *values;     // 只增加引用计数
+
+    acc.startUs = -1;
+    publishBlock(block);
+}
@@ -1,13 +1,25 @@
 #include "database/DataQuerier.h"
+#include "database/ScalarBlockCodec.h"
+#include "database/VibrationCodec.h"
+#include "database/VibrationPyramid.h"
 #include <QSqlError>
 #include <QDebug>
+#include <QDir>
 #include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 DataQuerier::DataQuerier(const QString &dbPath, QObject *parent)
     : QObject(parent)
     , m_dbPath(dbPath)
     , m_isInitialized(false)
+    , m_hasScalarBlocks(false)
+    , m_hasVibrationSegments(false)
+    , m_hasVibrationPyramid(false)
+    , m_hasVibrationDecimation(false)
 {
+    m_segments.setDirectory(VibrationSegmentWriter::directoryFor(m_dbPath));
 }
 
 DataQuerier::~DataQuerier()
@@ -41,6 +53,11 @@ void DataQuerier::close()
     if (m_isInitialized && m_db.isOpen()) {
         m_db.close();
         m_isInitialized = false;
+        m_hasScalarBlocks = false;
+        m_hasVibrationSegments = false;
+        m_hasVibrationPyramid = false;
+        m_hasVibrationDecimation = false;
+        m_segments.release();
     }
 }
 
@@ -101,7 +118,7 @@ QList<qint64> DataQuerier::getWindowTimestamps(int roundId)
     return timestamps;
 }
 
-DataQuerier::WindowData DataQuerier::getWindowData(int roundId, qint64 windowStartUs)
+DataQuerier::WindowData DataQuerier::getWindowData(int roundId, qint64 windowStartUs, bool decodeVibration)
 {
     WindowData data;
     data.windowStartUs = windowStartUs;
@@ -123,64 +140,91 @@ DataQuerier::WindowData DataQuerier::getWindowData(int roundId, qint64 windowSta
 
     int windowId = queryWindow.value(0).toInt();
 
-    // 2. 查询振动数据（解析BLOB）
+    // 2. 查询振动数据（解析BLOB；不解码时不读取BLOB列）
     QSqlQuery queryVib(m_db);
-    queryVib.prepare("SELECT channel_id, n_samples, data_blob "
+    queryVib.prepare("SELECT channel_id, n_samples, " + vibrationDecimationColumn() + ", "
+                     + (decodeVibration ? vibrationPayloadColumns() : QString("NULL, NULL, NULL, NULL")) + " "
                      "FROM vibration_blocks "
-                     "WHERE window_id = ?");
+                     "WHERE window_id = ? "
+                     "ORDER BY start_ts_us");
     queryVib.addBindValue(windowId);
 
     if (queryVib.exec()) {
         while (queryVib.next()) {
             int channelId = queryVib.value(0).toInt();
             int nSamples = queryVib.value(1).toInt();
-            QByteArray blob = queryVib.value(2).toByteArray();
-
-            // 解析BLOB为float数组
-            const float *floatData = reinterpret_cast<const float*>(blob.constData());
-            QVector<float> values;
-            values.reserve(nSamples);
-
-            for (int i = 0; i < nSamples; ++i) {
-                values.append(floatData[i]);
+            data.vibrationSampleCounts[channelId] += nSamples;
+            const int decimation = decimationOf(queryVib.value(2));
+            if (decimation > 1) {
+                data.vibrationDecimation[channelId] = decimation;
+            }
+            if (!decodeVibration) {
+                continue;
+            }
+            QByteArray blob = vibrationBlob(roundId, queryVib, 3);
+
+            // 解码BLOB（编码格式或旧的原始float数组），同一窗口可能有多行，按时间顺序拼接
+            QVector<float> &values = data.vibrationData[channelId];
+            const int offset = values.size();
+            const int decoded = VibrationCodec::decodeAppend(blob, values);
+            if (decoded < 0) {
+                qWarning() << "Corrupt vibration blob, channel" << channelId << "window" << windowId;
+            } else if (decoded > nSamples) {
+                values.resize(offset + nSamples);
             }
-
-            data.vibrationData[channelId] = values;
         }
     }
 
-    // 3. 查询标量数据（包含channel_id用于区分不同电机）
+    // 3. 查询标量数据（包含channel_id用于区分不同电机），两种布局合并后按时间排序
+    QVector<ScalarSample> samples;
+
     QSqlQuery queryScalar(m_db);
-    queryScalar.prepare("SELECT sensor_type, channel_id, value "
+    queryScalar.prepare("SELECT sensor_type, channel_id, timestamp_us, value "
                         "FROM scalar_samples "
-                        "WHERE window_id = ? "
-                        "ORDER BY timestamp_us");
+                        "WHERE window_id = ?");
     queryScalar.addBindValue(windowId);
 
     if (queryScalar.exec()) {
         while (queryScalar.next()) {
-            int sensorType = queryScalar.value(0).toInt();
-            int channelId = queryScalar.value(1).toInt();
-            double value = queryScalar.value(2).toDouble();
-
-            // 对于电机数据(300-303)，使用组合键区分不同电机
-            // 组合键 = sensorType * 100 + channelId
-            // 例如：电机2的位置(300) = 30002
-            int key = sensorType;
-            if (sensorType >= 300 && sensorType < 400) {
-                key = sensorType * 100 + channelId;
-            }
+            samples.append({queryScalar.value(0).toInt(), queryScalar.value(1).toInt(),
+                            queryScalar.value(2).toLongLong(), queryScalar.value(3).toDouble()});
+        }
+    }
+
+    if (hasScalarBlocks()) {
+        QSqlQuery queryBlocks(m_db);
+        queryBlocks.prepare("SELECT sensor_type, channel_id, start_ts_us, n_samples, ts_blob, value_blob "
+                            "FROM scalar_blocks "
+                            "WHERE window_id = ?");
+        queryBlocks.addBindValue(windowId);
 
-            data.scalarData[key].append(value);
+        if (queryBlocks.exec()) {
+            appendScalarBlocks(queryBlocks, std::numeric_limits<qint64>::min(),
+                               std::numeric_limits<qint64>::max(), samples);
         }
     }
 
+    sortScalarSamples(samples);
+
+    for (const ScalarSample &sample : samples) {
+        // 对于电机数据(300-303)，使用组合键区分不同电机
+        // 组合键 = sensorType * 100 + channelId
+        // 例如：电机2的位置(300) = 30002
+        int key = sample.sensorType;
+        if (sample.sensorType >= 300 && sample.sensorType < 400) {
+            key = sample.sensorType * 100 + sample.channelId;
+        }
+
+        data.scalarData[key].append(sample.value);
+    }
+
     return data;
 }
 
 QList<DataQuerier::WindowData> DataQuerier::getTimeRangeData(int roundId,
                                                                qint64 startTimeUs,
-                                                               qint64 endTimeUs)
+                                                               qint64 endTimeUs,
+                                                               bool decodeVibration)
 {
     QList<WindowData> dataList;
 
@@ -205,7 +249,7 @@ QList<DataQuerier::WindowData> DataQuerier::getTimeRangeData(int roundId,
     // 逐窗口查询数据
     while (query.next()) {
         qint64 windowStart = query.value(0).toLongLong();
-        WindowData data = getWindowData(roundId, windowStart);
+        WindowData data = getWindowData(roundId, windowStart, decodeVibration);
         dataList.append(data);
     }
 
@@ -245,14 +289,386 @@ QList<DataQuerier::VibrationStats> DataQuerier::getVibrationStats(int roundId,
         stats.timestampUs = query.value(0).toLongLong();
         stats.minValue = query.value(1).toFloat();
         stats.maxValue = query.value(2).toFloat();
-        stats.meanValue = query.value(3).toFloat();
-        stats.rmsValue = query.value(4).toFloat();
+        // 包络抽取行没有均值/RMS（NULL）
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        stats.meanValue = query.value(3).isNull() ? nan : query.value(3).toFloat();
+        stats.rmsValue = query.value(4).isNull() ? nan : query.value(4).toFloat();
         statsList.append(stats);
     }
 
     return statsList;
 }
 
+DataQuerier::VibrationEnvelope DataQuerier::getVibrationEnvelope(int roundId, int channelId,
+                                                                 qint64 startTimeUs, qint64 endTimeUs,
+                                                                 int maxPoints)
+{
+    VibrationEnvelope envelope;
+
+    if (!m_isInitialized || endTimeUs <= startTimeUs) {
+        return envelope;
+    }
+
+    if (hasVibrationPyramid()) {
+        const int level = VibrationPyramid::coarsestLevel((endTimeUs - startTimeUs) / qMax(1, maxPoints));
+        const qint64 bucketUs = VibrationPyramid::levelUs(level);
+        const qint64 rowUs = bucketUs * VibrationPyramid::BUCKETS_PER_ROW;
+
+        QSqlQuery query(m_db);
+        query.prepare("SELECT start_us, data_blob FROM vibration_pyramid "
+                      "WHERE round_id = ? AND channel_id = ? AND level_us = ? "
+                      "AND start_us > ? AND start_us < ? "
+                      "ORDER BY start_us");
+        query.addBindValue(roundId);
+        query.addBindValue(channelId);
+        query.addBindValue(bucketUs);
+        query.addBindValue(startTimeUs - rowUs);
+        query.addBindValue(endTimeUs);
+
+        if (!query.exec()) {
+            emit errorOccurred("Failed to query vibration pyramid: " + query.lastError().text());
+            return envelope;
+        }
+
+        VibrationPyramid::Bucket buckets[VibrationPyramid::BUCKETS_PER_ROW];
+        while (query.next()) {
+            const qint64 rowStartUs = query.value(0).toLongLong();
+            const int count = VibrationPyramid::unpack(query.value(1).toByteArray(), buckets,
+                                                       VibrationPyramid::BUCKETS_PER_ROW);
+            for (int i = 0; i < count; ++i) {
+                const qint64 timestampUs = rowStartUs + i * bucketUs;
+                // 空桶（NaN）和范围外的桶跳过
+                if (timestampUs + bucketUs <= startTimeUs || timestampUs >= endTimeUs ||
+                    std::isnan(buckets[i].meanValue)) {
+                    continue;
+                }
+                envelope.timestampsUs.append(timestampUs);
+                envelope.minValues.append(buckets[i].minValue);
+                envelope.maxValues.append(buckets[i].maxValue);
+                envelope.meanValues.append(buckets[i].meanValue);
+                envelope.rmsValues.append(buckets[i].rmsValue);
+            }
+        }
+
+        if (!envelope.timestampsUs.isEmpty()) {
+            envelope.bucketUs = bucketUs;
+            return envelope;
+        }
+    }
+
+    // 没有金字塔的轮次：每块的预计算统计（流式合并后每窗口一块）
+    for (const VibrationStats &stats : getVibrationStats(roundId, channelId, startTimeUs, endTimeUs)) {
+        envelope.timestampsUs.append(stats.timestampUs);
+        envelope.minValues.append(stats.minValue);
+        envelope.maxValues.append(stats.maxValue);
+        envelope.meanValues.append(stats.meanValue);
+        envelope.rmsValues.append(stats.rmsValue);
+    }
+    envelope.bucketUs = 1000000;
+    return envelope;
+}
+
+QList<DataQuerier::VibrationFrame> DataQuerier::getVibrationFrames(int roundId,
+                                                                    qint64 startTimeUs,
+                                                                    qint64 endTimeUs,
+                                                                    int channelCount,
+                                                                    int firstChannel)
+{
+    QList<VibrationFrame> frames;
+
+    if (!m_isInitialized || channelCount <= 0) {
+        return frames;
+    }
+
+    QSqlQuery query(m_db);
+    query.prepare("SELECT start_ts_us, channel_id, sample_rate, n_samples, " + vibrationDecimationColumn() + ", "
+                  + vibrationPayloadColumns() + " "
+                  "FROM vibration_blocks "
+                  "WHERE round_id = ? AND channel_id >= ? AND channel_id < ? "
+                  "AND start_ts_us >= ? AND start_ts_us < ? "
+                  "ORDER BY start_ts_us, channel_id");
+    query.addBindValue(roundId);
+    query.addBindValue(firstChannel);
+    query.addBindValue(firstChannel + channelCount);
+    query.addBindValue(startTimeUs);
+    query.addBindValue(endTimeUs);
+
+    if (!query.exec()) {
+        emit errorOccurred("Failed to query vibration frames: " + query.lastError().text());
+        return frames;
+    }
+
+    VibrationFrame frame;
+    int channelsFilled = 0;
+
+    while (query.next()) {
+        qint64 timestamp = query.value(0).toLongLong();
+        int channelId = query.value(1).toInt() - firstChannel;
+        double sampleRate = query.value(2).toDouble();
+        int nSamples = query.value(3).toInt();
+        const int decimation = decimationOf(query.value(4));
+        QByteArray blob = vibrationBlob(roundId, query, 5);
+
+        // 新时间戳：开始新的一帧（上一帧不完整则丢弃）
+        if (channelsFilled == 0 || timestamp != frame.startTimestampUs) {
+            frame = VibrationFrame();
+            frame.startTimestampUs = timestamp;
+            frame.sampleRate = sampleRate;
+            frame.numSamples = nSamples;
+            frame.channelCount = channelCount;
+            frame.decimation = decimation;
+            frame.data.resize(channelCount * nSamples);
+            channelsFilled = 0;
+        }
+
+        // 通道必须按顺序到齐且样本数一致，才能保证对齐
+        if (channelId != channelsFilled || nSamples != frame.numSamples || decimation != frame.decimation ||
+            VibrationCodec::sampleCount(blob) < nSamples) {
+            channelsFilled = 0;
+            continue;
+        }
+
+        if (VibrationCodec::decode(blob, frame.data.data() + channelId * nSamples, nSamples) < 0) {
+            channelsFilled = 0;
+            continue;
+        }
+        if (++channelsFilled == channelCount) {
+            frames.append(frame);
+            channelsFilled = 0;
+        }
+    }
+
+    return frames;
+}
+
+QVector<DataQuerier::ScalarSample> DataQuerier::getScalarSamples(int roundId,
+                                                                 qint64 startTimeUs,
+                                                                 qint64 endTimeUs,
+                                                                 SensorType firstType,
+                                                                 SensorType lastType)
+{
+    QVector<ScalarSample> samples;
+
+    if (!m_isInitialized) {
+        return samples;
+    }
+
+    // 旧布局：每值一行
+    QSqlQuery query(m_db);
+    query.prepare("SELECT sensor_type, channel_id, timestamp_us, value FROM scalar_samples "
+                  "WHERE round_id = ? AND sensor_type BETWEEN ? AND ? "
+                  "AND timestamp_us >= ? AND timestamp_us < ?");
+    query.addBindValue(roundId);
+    query.addBindValue(static_cast<int>(firstType));
+    query.addBindValue(static_cast<int>(lastType));
+    query.addBindValue(startTimeUs);
+    query.addBindValue(endTimeUs);
+
+    if (!query.exec()) {
+        emit errorOccurred("Failed to query scalar samples: " + query.lastError().text());
+        return samples;
+    }
+    while (query.next()) {
+        samples.append({query.value(0).toInt(), query.value(1).toInt(),
+                        query.value(2).toLongLong(), query.value(3).toDouble()});
+    }
+
+    // 块布局：与时间范围相交的块，展开后按样本时间戳过滤
+    if (hasScalarBlocks()) {
+        QSqlQuery queryBlocks(m_db);
+        queryBlocks.prepare("SELECT sensor_type, channel_id, start_ts_us, n_samples, ts_blob, value_blob "
+                            "FROM scalar_blocks "
+                            "WHERE round_id = ? AND start_ts_us < ? AND end_ts_us >= ? "
+                            "AND sensor_type BETWEEN ? AND ?");
+        queryBlocks.addBindValue(roundId);
+        queryBlocks.addBindValue(endTimeUs);
+        queryBlocks.addBindValue(startTimeUs);
+        queryBlocks.addBindValue(static_cast<int>(firstType));
+        queryBlocks.addBindValue(static_cast<int>(lastType));
+
+        if (!queryBlocks.exec()) {
+            emit errorOccurred("Failed to query scalar blocks: " + queryBlocks.lastError().text());
+            return samples;
+        }
+        appendScalarBlocks(queryBlocks, startTimeUs, endTimeUs, samples);
+    }
+
+    sortScalarSamples(samples);
+    return samples;
+}
+
+bool DataQuerier::hasScalarBlocks()
+{
+    if (m_hasScalarBlocks || !m_isInitialized) {
+        return m_hasScalarBlocks;
+    }
+
+    // 只读打开的旧库可能还没有该表；DbWriter打开后会创建，因此未检测到时每次重新检查
+    m_hasScalarBlocks = hasTable("scalar_blocks");
+    return m_hasScalarBlocks;
+}
+
+bool DataQuerier::hasVibrationSegments()
+{
+    if (m_hasVibrationSegments || !m_isInitialized) {
+        return m_hasVibrationSegments;
+    }
+
+    // DbWriter先给vibration_blocks补列再建vibration_segments表，表存在即列存在
+    m_hasVibrationSegments = hasTable("vibration_segments");
+    return m_hasVibrationSegments;
+}
+
+bool DataQuerier::hasVibrationPyramid()
+{
+    if (m_hasVibrationPyramid || !m_isInitialized) {
+        return m_hasVibrationPyramid;
+    }
+
+    m_hasVibrationPyramid = hasTable("vibration_pyramid");
+    return m_hasVibrationPyramid;
+}
+
+bool DataQuerier::hasTable(const QString &name)
+{
+    QSqlQuery query(m_db);
+    query.prepare("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?");
+    query.addBindValue(name);
+    return query.exec() && query.next();
+}
+
+QString DataQuerier::vibrationPayloadColumns()
+{
+    return hasVibrationSegments() ? "data_blob, segment_id, segment_offset, segment_length"
+                                  : "data_blob, NULL, NULL, NULL";
+}
+
+QString DataQuerier::vibrationDecimationColumn()
+{
+    if (!m_hasVibrationDecimation && m_isInitialized) {
+        QSqlQuery query(m_db);
+        if (query.exec("PRAGMA table_info(vibration_blocks)")) {
+            while (query.next()) {
+                if (query.value(1).toString() == "decimation") {
+                    m_hasVibrationDecimation = true;
+                    break;
+                }
+            }
+        }
+    }
+    return m_hasVibrationDecimation ? "decimation" : "NULL";
+}
+
+QByteArray DataQuerier::vibrationBlob(int roundId, const QSqlQuery &query, int column)
+{
+    const QVariant segmentId = query.value(column + 1);
+    if (segmentId.isNull()) {
+        return query.value(column).toByteArray();
+    }
+
+    const QByteArray view = m_segments.view(VibrationSegmentWriter::fileName(roundId, segmentId.toLongLong()),
+                                            query.value(column + 2).toLongLong(),
+                                            query.value(column + 3).toLongLong());
+    if (view.isEmpty()) {
+        qWarning() << "Missing vibration segment data, segment" << segmentId.toLongLong()
+                   << "offset" << query.value(column + 2).toLongLong();
+    }
+    return view;
+}
+
+QList<DataQuerier::VibrationBlockView> DataQuerier::getVibrationBlocks(int roundId, int channelId,
+                                                                       qint64 startTimeUs, qint64 endTimeUs)
+{
+    QList<VibrationBlockView> blocks;
+
+    if (!m_isInitialized) {
+        return blocks;
+    }
+
+    QSqlQuery query(m_db);
+    query.prepare("SELECT start_ts_us, sample_rate, n_samples, " + vibrationDecimationColumn() + ", "
+                  + vibrationPayloadColumns() + " "
+                  "FROM vibration_blocks "
+                  "WHERE round_id = ? AND channel_id = ? "
+                  "AND start_ts_us >= ? AND start_ts_us < ? "
+                  "ORDER BY start_ts_us");
+    query.addBindValue(roundId);
+    query.addBindValue(channelId);
+    query.addBindValue(startTimeUs);
+    query.addBindValue(endTimeUs);
+
+    if (!query.exec()) {
+        emit errorOccurred("Failed to query vibration blocks: " + query.lastError().text());
+        return blocks;
+    }
+
+    while (query.next()) {
+        VibrationBlockView block;
+        block.startTimestampUs = query.value(0).toLongLong();
+        block.sampleRate = query.value(1).toDouble();
+        block.numSamples = query.value(2).toInt();
+        block.decimation = decimationOf(query.value(3));
+        block.blob = vibrationBlob(roundId, query, 4);
+        blocks.append(block);
+    }
+
+    return blocks;
+}
+
+void DataQuerier::removeSegmentFiles(const QStringList &fileNames)
+{
+    m_segments.release();
+
+    const QDir dir(VibrationSegmentWriter::directoryFor(m_dbPath));
+    for (const QString &fileName : fileNames) {
+        if (dir.exists(fileName) && !dir.remove(fileName)) {
+            qWarning() << "Cannot remove vibration segment file:" << dir.filePath(fileName);
+        }
+    }
+}
+
+void DataQuerier::appendScalarBlocks(QSqlQuery &query, qint64 startTimeUs, qint64 endTimeUs,
+                                     QVector<ScalarSample> &out)
+{
+    QVector<qint64> timestamps;
+    QVector<double> values;
+
+    while (query.next()) {
+        const int sensorType = query.value(0).toInt();
+        const int channelId = query.value(1).toInt();
+        const qint64 blockStartUs = query.value(2).toLongLong();
+        const int n = query.value(3).toInt();
+
+        timestamps.resize(0);
+        values.resize(0);
+        if (!ScalarBlockCodec::unpack(query.value(4).toByteArray(), query.value(5).toByteArray(),
+                                      blockStartUs, n, &timestamps, values)) {
+            qWarning() << "Corrupt scalar block, sensor type" << sensorType << "channel" << channelId
+                       << "start" << blockStartUs;
+            continue;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            if (timestamps[i] >= startTimeUs && timestamps[i] < endTimeUs) {
+                out.append({sensorType, channelId, timestamps[i], values[i]});
+            }
+        }
+    }
+}
+
+void DataQuerier::sortScalarSamples(QVector<ScalarSample> &samples)
+{
+    std::stable_sort(samples.begin(), samples.end(), [](const ScalarSample &a, const ScalarSample &b) {
+        if (a.timestampUs != b.timestampUs) {
+            return a.timestampUs < b.timestampUs;
+        }
+        if (a.sensorType != b.sensorType) {
+            return a.sensorType < b.sensorType;
+        }
+        return a.channelId < b.channelId;
+    });
+}
+
 qint64 DataQuerier::getRoundActualDuration(int roundId)
 {
     if (!m_isInitialized) {
@@ -0,0 +1,136 @@
+#include "database/DbStoragePolicy.h"
+
+bool DbStoragePolicy::fromJson(const QJsonObject &json, DbStoragePolicy &policy, QString *errorMessage)
+{
+    auto fail = [errorMessage](const QString &message) {
+        if (errorMessage) {
+            *errorMessage = message;
+        }
+        return false;
+    };
+
+    policy = DbStoragePolicy();
+
+    const QString durability = json.value("durability").toString("balanced").toLower();
+    if (durability == "max-throughput") {
+        policy.durability = Durability::MaxThroughput;
+    } else if (durability == "balanced") {
+        policy.durability = Durability::Balanced;
+    } else if (durability == "crash-safe") {
+        policy.durability = Durability::CrashSafe;
+    } else {
+        return fail(QString("未知的持久性档位: %1（max-throughput | balanced | crash-safe）").arg(durability));
+    }
+
+    policy.checkpointIntervalMs = json.value("checkpoint_interval_ms").toInt(policy.checkpointIntervalMs);
+    if (policy.checkpointIntervalMs < 0) {
+        return fail(QString("checkpoint_interval_ms不能为负: %1").arg(policy.checkpointIntervalMs));
+    }
+
+    const int truncateMb = json.value("wal_truncate_mb").toInt(static_cast<int>(policy.walTruncateBytes >> 20));
+    if (truncateMb < 1) {
+        return fail(QString("wal_truncate_mb至少为1: %1").arg(truncateMb));
+    }
+    policy.walTruncateBytes = static_cast<qint64>(truncateMb) << 20;
+
+    const QString storage = json.value("vibration_storage").toString("sqlite").toLower();
+    if (storage == "sqlite") {
+        policy.vibrationStorage = VibrationStorage::Blob;
+    } else if (storage == "segments") {
+        policy.vibrationStorage = VibrationStorage::Segments;
+    } else {
+        return fail(QString("未知的振动存储方式: %1（sqlite | segments）").arg(storage));
+    }
+
+    const int segmentMb = json.value("segment_mb").toInt(static_cast<int>(policy.segmentBytes >> 20));
+    if (segmentMb < 1) {
+        return fail(QString("segment_mb至少为1: %1").arg(segmentMb));
+    }
+    policy.segmentBytes = static_cast<qint64>(segmentMb) << 20;
+
+    const QString scalarStorage = json.value("scalar_storage").toString("blocks").toLower();
+    if (scalarStorage == "blocks") {
+        policy.scalarStorage = ScalarStorage::Blocks;
+    } else if (scalarStorage == "rows") {
+        policy.scalarStorage = ScalarStorage::Rows;
+    } else {
+        return fail(QString("未知的标量存储方式: %1（blocks | rows）").arg(scalarStorage));
+    }
+
+    policy.migrateScalarSamples = json.value("migrate_scalar_samples").toBool(policy.migrateScalarSamples);
+    return true;
+}
+
+QString DbStoragePolicy::durabilityName(Durability durability)
+{
+    switch (durability) {
+    case Durability::MaxThroughput: return "max-throughput";
+    case Durability::Balanced: return "balanced";
+    case Durability::CrashSafe: return "crash-safe";
+    }
+    return "unknown";
+}
+
+QString DbStoragePolicy::vibrationStorageName(VibrationStorage storage)
+{
+    switch (storage) {
+    case VibrationStorage::Blob: return "sqlite";
+    case VibrationStorage::Segments: return "segments";
+    }
+    return "unknown";
+}
+
+QString DbStoragePolicy::scalarStorageName(ScalarStorage storage)
+{
+    switch (storage) {
+    case ScalarStorage::Blocks: return "blocks";
+    case ScalarStorage::Rows: return "rows";
+    }
+    return "unknown";
+}
+
+QStringList DbStoragePolicy::pragmas() const
+{
+    QStringList list;
+    list << "PRAGMA journal_mode = WAL";
+
+    switch (durability) {
+    case Durability::MaxThroughput:
+        list << "PRAGMA synchronous = OFF";
+        break;
+    case Durability::Balanced:
+        list << "PRAGMA synchronous = NORMAL";
+        break;
+    case Durability::CrashSafe:
+        list << "PRAGMA synchronous = FULL";
+        break;
+    }
+
+    // 后台检查点接管时关闭自动检查点，提交不再触发内联检查点
+    list << QString("PRAGMA wal_autocheckpoint = %1").arg(backgroundCheckpoint() ? 0 : 1000);
+
+    list << "PRAGMA cache_size = -64000"        // 64MB缓存
+         << "PRAGMA temp_store = MEMORY"
+         << "PRAGMA mmap_size = 268435456";     // 256MB内存映射
+    return list;
+}
+
+QString DbStoragePolicy::describe() const
+{
+    QString text = durabilityName(durability);
+    if (backgroundCheckpoint()) {
+        text += QString(", background checkpoint every %1 ms, truncate WAL above %2 MB")
+                .arg(checkpointIntervalMs).arg(walTruncateBytes >> 20);
+    } else {
+        text += ", SQLite auto checkpoint";
+    }
+    if (vibrationSegments()) {
+        text += QString(", vibration in segment files (%1 MB each)").arg(segmentBytes >> 20);
+    }
+    if (!scalarBlocks()) {
+        text += ", scalar samples as rows (legacy layout, not migrated)";
+    } else if (!migrateScalarSamples) {
+        text += ", legacy scalar_samples not migrated";
+    }
+    return text;
+}
@@ -1,25 +1,48 @@
 #include "database/DbWriter.h"
+#include "database/WalCheckpointer.h"
+#include "database/ScalarBlockCodec.h"
+#include "database/VibrationCodec.h"
+#include "Logger.h"
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QSqlRecord>
 #include <QDateTime>
 #include <QDebug>
-#include <QFile>
+#include <QDir>
 #include <QThread>
 #include <QtMath>
+#include <algorithm>
 #include <cfloat>
+#include <utility>
 
 DbWriter::DbWriter(const QString &dbPath, QObject *parent)
     : QObject(parent)
     , m_dbPath(dbPath)
+    , m_checkpointThread(nullptr)
+    , m_checkpointer(nullptr)
+    , m_statements(StatementCount)
+    , m_cacheStatements(true)
+    , m_statementPrepares(0)
+    , m_bulkScalarInserts(true)
+    , m_scalarRowsWritten(0)
+    , m_scalarTableRows(0)
+    , m_vibrationRawBytes(0)
+    , m_vibrationBlobBytes(0)
     , m_batchTimer(nullptr)
+    , m_migrationTimer(nullptr)
+    , m_migratedRows(0)
+    , m_ringCursor(0)
+    , m_ringReportTicks(0)
+    , m_latency(nullptr)
     , m_currentRoundId(0)
     , m_maxQueueSize(10000)
     , m_batchSize(200)
     , m_batchIntervalMs(100)
     , m_totalBlocksWritten(0)
     , m_isInitialized(false)
+    , m_accumulatorFlushTimeoutMs(1500)
+    , m_windowFlagUpdates(0)
     , m_maxCacheSize(100)  // 窗口缓存大小
 {
     qDebug() << "DbWriter created, db path:" << m_dbPath;
@@ -47,10 +70,13 @@ bool DbWriter::initialize()
     // 检查并标记异常中断的轮次
     markAbnormalRounds();
 
+    // WAL检查点移到后台线程
+    startCheckpointer();
+
     // 创建批量写入定时器
     m_batchTimer = new QTimer(this);
     m_batchTimer->setInterval(m_batchIntervalMs);
-    connect(m_batchTimer, &QTimer::timeout, this, &DbWriter::processBatch);
+    connect(m_batchTimer, &QTimer::timeout, this, &DbWriter::onBatchTimer);
     m_batchTimer->start();
 
     m_isInitialized = true;
@@ -73,13 +99,23 @@ void DbWriter::shutdown()
         m_batchTimer = nullptr;
     }
 
-    // 处理剩余队列
-    processBatch();
+    // 未完成的标量迁移停在段边界，下次打开继续
+    stopScalarMigration();
+
+    // 处理剩余队列（包括环形队列），再写出未满窗口的振动子块和标量块
+    while (processBatch() > 0) {
+    }
+    flushAccumulators(true);
+    m_segmentWriter.close();
 
     // 清理窗口缓存
     clearWindowCache();
 
-    // 关闭数据库
+    // 写入已停止，后台检查点回写并截断WAL后退出
+    stopCheckpointer();
+
+    // 关闭数据库（先释放预编译语句，否则连接无法关闭）
+    releaseStatements();
     if (m_db.isOpen()) {
         m_db.close();
     }
@@ -91,7 +127,30 @@ void DbWriter::shutdown()
 int DbWriter::queueSize() const
 {
     QMutexLocker locker(&m_queueMutex);
-    return m_queue.size();
+    int total = m_queue.size();
+    for (const RingSource &source : m_rings) {
+        total += source.ring->size();
+    }
+    return total;
+}
+
+void DbWriter::attachRing(const QString &name, DataBlockRing *ring, CreditGate *credits)
+{
+    if (!ring) {
+        return;
+    }
+
+    QMutexLocker locker(&m_queueMutex);
+    m_rings.append({name, ring, credits, 0});
+    qDebug() << "DbWriter ring attached:" << name << "capacity:" << ring->capacity()
+             << "credits:" << (credits ? credits->capacity() : 0);
+}
+
+void DbWriter::detachRings()
+{
+    QMutexLocker locker(&m_queueMutex);
+    m_rings.clear();
+    m_ringCursor = 0;
 }
 
 void DbWriter::enqueueDataBlock(const DataBlock &block)
@@ -107,7 +166,9 @@ void DbWriter::enqueueDataBlock(const DataBlock &block)
         return;
     }
     
-    m_queue.enqueue(block);
+    DataBlock queued = block;
+    queued.trace.mark(PipelineTrace::Enqueued);
+    m_queue.enqueue(queued);
     
     // 如果队列达到批量大小，立即处理
     if (m_queue.size() >= m_batchSize) {
@@ -120,73 +181,268 @@ void DbWriter::clearQueue()
 {
     QMutexLocker locker(&m_queueMutex);
     m_queue.clear();
+
+    // 丢弃环形队列中的数据（DbWriter是唯一消费者），丢弃的块同样归还额度
+    DataBlock discarded;
+    for (RingSource &source : m_rings) {
+        while (source.ring->tryPop(discarded)) {
+            if (source.credits) {
+                source.pendingCredits += CreditGate::costOf(discarded);
+            }
+        }
+        if (source.credits) {
+            source.credits->release(source.pendingCredits);
+        }
+        source.pendingCredits = 0;
+    }
+
+    // 丢弃尚未落盘的振动子块、标量块和金字塔未满的层
+    m_vibrationAccumulators.clear();
+    m_scalarAccumulators.clear();
+    m_pyramids.clear();
 }
 
 void DbWriter::flushQueue()
 {
     // 先处理所有待写入的数据
-    while (queueSize() > 0) {
-        processBatch();
+    while (queueSize() > 0 && processBatch() > 0) {
     }
+    flushAccumulators(true);
     // 然后清空队列（以防processBatch期间又有新数据进来）
     clearQueue();
 }
 
-void DbWriter::processBatch()
+void DbWriter::onBatchTimer()
+{
+    // 每个tick持续写入直到队列排空（上限避免长时间阻塞本线程事件循环）
+    const int maxBatchesPerTick = 50;
+    int batches = 0;
+    while (processBatch() >= m_batchSize && ++batches < maxBatchesPerTick) {
+    }
+
+    // 振动/标量流停止后，把未满窗口的缓冲写出
+    flushAccumulators(false);
+
+    // 约每秒输出一次环形队列统计
+    const int ticksPerReport = qMax(1, 1000 / qMax(1, m_batchIntervalMs));
+    if (++m_ringReportTicks >= ticksPerReport) {
+        m_ringReportTicks = 0;
+        reportRingMetrics();
+        if (m_latency) {
+            const QString latencySummary = m_latency->summary();
+            if (!latencySummary.isEmpty()) {
+                emit latencyMetricsUpdated(latencySummary);
+            }
+        }
+    }
+}
+
+int DbWriter::drainRings(QVector<DataBlock> &batch, int maxBlocks)
 {
     QMutexLocker locker(&m_queueMutex);
-    
-    if (m_queue.isEmpty()) {
+    if (m_rings.isEmpty()) {
+        return 0;
+    }
+
+    // 从不同的起点轮询，避免高频通道（振动）饿死低频通道
+    int drained = 0;
+    const int ringCount = m_rings.size();
+    bool progress = true;
+    DataBlock block;
+
+    while (drained < maxBlocks && progress) {
+        progress = false;
+        for (int i = 0; i < ringCount && drained < maxBlocks; ++i) {
+            RingSource &source = m_rings[(m_ringCursor + i) % ringCount];
+            if (source.ring->tryPop(block)) {
+                if (source.credits) {
+                    source.pendingCredits += CreditGate::costOf(block);
+                }
+                batch.append(std::move(block));
+                ++drained;
+                progress = true;
+            }
+        }
+    }
+
+    m_ringCursor = (m_ringCursor + 1) % ringCount;
+    return drained;
+}
+
+void DbWriter::grantCredits()
+{
+    // 本批已离开环形队列的块不再占用生产者额度（无论提交成功与否，避免额度泄漏）
+    QMutexLocker locker(&m_queueMutex);
+    for (RingSource &source : m_rings) {
+        if (source.credits && source.pendingCredits > 0) {
+            source.credits->release(source.pendingCredits);
+        }
+        source.pendingCredits = 0;
+    }
+}
+
+void DbWriter::reportRingMetrics()
+{
+    QMutexLocker locker(&m_queueMutex);
+    const QVector<RingSource> rings = m_rings;
+    locker.unlock();
+
+    for (const RingSource &source : rings) {
+        emit ringMetricsUpdated(source.name,
+                                source.ring->size(),
+                                source.ring->highWaterMark(),
+                                source.ring->capacity(),
+                                source.ring->droppedCount());
+        source.ring->resetHighWaterMark();
+    }
+}
+
+void DbWriter::writeLatencyReport(int roundId)
+{
+    if (!m_latency || roundId <= 0) {
         return;
     }
-    
-    // 取出一批数据
+
+    const QVector<PipelineLatency::Row> rows = m_latency->snapshot();
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    for (const QString &line : m_latency->report()) {
+        qDebug() << "[Latency] round" << roundId << line;
+    }
+
+    if (!m_db.transaction()) {
+        emit errorOccurred("Failed to start transaction: " + m_db.lastError().text());
+        return;
+    }
+
+    QSqlQuery query(m_db);
+    query.prepare("INSERT INTO pipeline_latency "
+                  "(round_id, sensor_type, segment, n_samples, p50_us, p99_us, max_us, mean_us) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+    for (const PipelineLatency::Row &row : rows) {
+        query.addBindValue(roundId);
+        query.addBindValue(static_cast<int>(row.sensorType));
+        query.addBindValue(PipelineLatency::segmentName(row.segment));
+        query.addBindValue(row.count);
+        query.addBindValue(row.p50Us);
+        query.addBindValue(row.p99Us);
+        query.addBindValue(row.maxUs);
+        query.addBindValue(row.meanUs);
+        if (!query.exec()) {
+            m_db.rollback();
+            emit errorOccurred("Failed to write pipeline latency: " + query.lastError().text());
+            return;
+        }
+    }
+
+    if (!m_db.commit()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to commit transaction: " + m_db.lastError().text());
+        return;
+    }
+
+    m_latency->reset();
+}
+
+int DbWriter::processBatch()
+{
+    // 取出一批数据：先排空Worker环形队列，再取信号队列
     QVector<DataBlock> batch;
-    int batchCount = qMin(m_batchSize, m_queue.size());
-    batch.reserve(batchCount);
-    
-    for (int i = 0; i < batchCount; ++i) {
-        batch.append(m_queue.dequeue());
+    batch.reserve(m_batchSize);
+
+    drainRings(batch, m_batchSize);
+
+    {
+        QMutexLocker locker(&m_queueMutex);
+        int batchCount = qMin(m_batchSize - batch.size(), m_queue.size());
+        for (int i = 0; i < batchCount; ++i) {
+            batch.append(m_queue.dequeue());
+        }
+    }
+
+    if (batch.isEmpty()) {
+        return 0;
+    }
+
+    const qint64 dequeuedUs = PipelineTrace::nowUs();
+    for (DataBlock &block : batch) {
+        block.trace.mark(PipelineTrace::Dequeued, dequeuedUs);
     }
-    
-    locker.unlock();
     
     // 开始事务
     if (!m_db.transaction()) {
+        grantCredits();
         emit errorOccurred("Failed to start transaction: " + m_db.lastError().text());
-        return;
+        return 0;
     }
     
     // 批量写入数据
     int successCount = 0;
+    int scalarBlocks = 0;           // 标量行进入列缓冲、尚未插入的块数
     for (const DataBlock &block : batch) {
         bool success = false;
         
         // 根据传感器类型选择写入方法
-        if (block.sensorType >= SensorType::Vibration_X && 
-            block.sensorType <= SensorType::Vibration_Z) {
-            // 高频振动数据
+        if (isVibrationType(block.sensorType)) {
+            // 高频振动数据（单通道或打包块）
             success = writeVibrationData(block);
+        } else if (block.sensorType == SensorType::Motor_Snapshot) {
+            // 电机快照：一个块包含一个tick的全部电机参数
+            success = writeMotorSnapshot(block);
+            scalarBlocks += success ? 1 : 0;
+        } else if (block.sensorType == SensorType::Vibration_Summary) {
+            // 振动摘要：反压降级期间替代波形的每通道统计量
+            success = writeVibrationSummary(block);
+            scalarBlocks += success ? 1 : 0;
         } else {
             // 低频标量数据
             success = writeScalarData(block);
+            scalarBlocks += success ? 1 : 0;
         }
         
         if (success) {
             successCount++;
         }
     }
+
+    // 本批全部标量行以多行INSERT写出
+    if (!flushScalarRows() && m_bulkScalarInserts) {
+        successCount -= scalarBlocks;
+    }
+
+    // 本批新增的窗口标志（每个窗口一条UPDATE）
+    flushWindowFlags();
     
-    // 提交事务
-    if (!m_db.commit()) {
+    // 提交事务（段文件先flush，索引行可见时数据已在文件中）
+    const bool committed = flushSegments() && m_db.commit();
+    if (!committed) {
         m_db.rollback();
+        m_segmentWriter.close();    // 回滚的段登记行可能不存在，换新段
+    }
+
+    // 事务结束，归还生产者额度
+    grantCredits();
+
+    if (!committed) {
         emit errorOccurred("Failed to commit transaction: " + m_db.lastError().text());
-        return;
+        return 0;
     }
     
+    // 记录分段延迟（合并写入的振动子块/标量样本以本事务提交为准，不等待所在行落盘）
+    if (m_latency) {
+        const qint64 committedUs = PipelineTrace::nowUs();
+        for (DataBlock &block : batch) {
+            block.trace.mark(PipelineTrace::Committed, committedUs);
+        }
+        m_latency->recordCommitted(batch);
+    }
+
     m_totalBlocksWritten += successCount;
     emit batchWritten(successCount);
     emit statisticsUpdated(m_totalBlocksWritten, queueSize());
+    return batch.size();
 }
 
 int DbWriter::startNewRound(const QString &operatorName, const QString &note)
@@ -221,6 +477,9 @@ int DbWriter::startNewRound(const QString &operatorName, const QString &note)
 
     m_currentRoundId = query.lastInsertId().toInt();
     clearWindowCache();
+    if (m_latency) {
+        m_latency->reset();     // 延迟统计按轮次累计
+    }
     qDebug() << "New round started, ID:" << m_currentRoundId << "(from lastInsertId)";
     return m_currentRoundId;
 }
@@ -243,6 +502,7 @@ void DbWriter::endCurrentRound()
     }
 
     qDebug() << "Round ended and marked as completed, ID:" << m_currentRoundId;
+    writeLatencyReport(m_currentRoundId);
     m_currentRoundId = 0;
 }
 
@@ -273,6 +533,28 @@ void DbWriter::clearRoundData(int roundId)
 
     int deletedScalarSamples = query.numRowsAffected();
 
+    query.prepare("DELETE FROM scalar_blocks WHERE round_id = ?");
+    query.addBindValue(roundId);
+
+    if (!query.exec()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to clear scalar blocks: " + query.lastError().text());
+        return;
+    }
+
+    int deletedScalarBlocks = query.numRowsAffected();
+
+    // 迁移保留的原始标量行随轮次一起删除
+    if (m_db.tables().contains("scalar_samples_legacy")) {
+        query.prepare("DELETE FROM scalar_samples_legacy WHERE round_id = ?");
+        query.addBindValue(roundId);
+        if (!query.exec()) {
+            m_db.rollback();
+            emit errorOccurred("Failed to clear legacy scalar samples: " + query.lastError().text());
+            return;
+        }
+    }
+
     // 删除该轮次的振动数据
     query.prepare("DELETE FROM vibration_blocks WHERE round_id = ?");
     query.addBindValue(roundId);
@@ -285,6 +567,37 @@ void DbWriter::clearRoundData(int roundId)
 
     int deletedVibrationBlocks = query.numRowsAffected();
 
+    // 删除该轮次的降采样金字塔
+    query.prepare("DELETE FROM vibration_pyramid WHERE round_id = ?");
+    query.addBindValue(roundId);
+
+    if (!query.exec()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to clear vibration pyramid: " + query.lastError().text());
+        return;
+    }
+
+    // 删除该轮次的段登记（文件在提交后删除）
+    const QStringList segments = segmentFiles("=", roundId);
+    query.prepare("DELETE FROM vibration_segments WHERE round_id = ?");
+    query.addBindValue(roundId);
+
+    if (!query.exec()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to clear vibration segments: " + query.lastError().text());
+        return;
+    }
+
+    // 删除该轮次的管线延迟统计
+    query.prepare("DELETE FROM pipeline_latency WHERE round_id = ?");
+    query.addBindValue(roundId);
+
+    if (!query.exec()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to clear pipeline latency: " + query.lastError().text());
+        return;
+    }
+
     // 删除该轮次的所有时间窗口
     query.prepare("DELETE FROM time_windows WHERE round_id = ?");
     query.addBindValue(roundId);
@@ -315,7 +628,50 @@ void DbWriter::clearRoundData(int roundId)
         return;
     }
 
-    // 清除窗口缓存中该轮次的条目
+    // 段文件不再被引用（轮次号会被复用，写入端换新段）
+    if (m_segmentWriter.roundId() == roundId) {
+        m_segmentWriter.close();
+    }
+    removeSegmentFiles(segments);
+
+    // 丢弃该轮次尚未落盘的振动子块和标量块
+    auto accIt = m_vibrationAccumulators.begin();
+    while (accIt != m_vibrationAccumulators.end()) {
+        if (accIt->roundId == roundId) {
+            accIt = m_vibrationAccumulators.erase(accIt);
+        } else {
+            ++accIt;
+        }
+    }
+
+    auto scalarIt = m_scalarAccumulators.begin();
+    while (scalarIt != m_scalarAccumulators.end()) {
+        if (scalarIt->roundId == roundId) {
+            scalarIt = m_scalarAccumulators.erase(scalarIt);
+        } else {
+            ++scalarIt;
+        }
+    }
+
+    auto pyramidIt = m_pyramids.begin();
+    while (pyramidIt != m_pyramids.end()) {
+        if (pyramidIt->roundId == roundId) {
+            pyramidIt = m_pyramids.erase(pyramidIt);
+        } else {
+            ++pyramidIt;
+        }
+    }
+
+    // 清除窗口缓存中该轮次的条目（窗口已删除，未写出的标志直接丢弃）
+    auto stateIt = m_windowStates.begin();
+    while (stateIt != m_windowStates.end()) {
+        if (stateIt->roundId == roundId) {
+            stateIt = m_windowStates.erase(stateIt);
+        } else {
+            ++stateIt;
+        }
+    }
+
     auto it = m_windowCache.begin();
     while (it != m_windowCache.end()) {
         if (it.key().first == roundId) {
@@ -327,6 +683,7 @@ void DbWriter::clearRoundData(int roundId)
 
     qDebug() << "Round data cleared for ID:" << roundId
              << "| Scalar samples:" << deletedScalarSamples
+             << "| Scalar blocks:" << deletedScalarBlocks
              << "| Vibration blocks:" << deletedVibrationBlocks
              << "| Windows:" << deletedWindows;
 }
@@ -358,6 +715,26 @@ void DbWriter::resetToRound(int targetRound)
     }
     int deletedScalarSamples = query.numRowsAffected();
 
+    query.prepare("DELETE FROM scalar_blocks WHERE round_id >= ?");
+    query.addBindValue(targetRound);
+    if (!query.exec()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to delete scalar blocks: " + query.lastError().text());
+        return;
+    }
+    int deletedScalarBlocks = query.numRowsAffected();
+
+    // 迁移保留的原始标量行（轮次号会被复用，不能留下旧行）
+    if (m_db.tables().contains("scalar_samples_legacy")) {
+        query.prepare("DELETE FROM scalar_samples_legacy WHERE round_id >= ?");
+        query.addBindValue(targetRound);
+        if (!query.exec()) {
+            m_db.rollback();
+            emit errorOccurred("Failed to delete legacy scalar samples: " + query.lastError().text());
+            return;
+        }
+    }
+
     // 删除所有 round_id >= targetRound 的振动数据
     query.prepare("DELETE FROM vibration_blocks WHERE round_id >= ?");
     query.addBindValue(targetRound);
@@ -368,6 +745,25 @@ void DbWriter::resetToRound(int targetRound)
     }
     int deletedVibrationBlocks = query.numRowsAffected();
 
+    // 删除所有 round_id >= targetRound 的降采样金字塔
+    query.prepare("DELETE FROM vibration_pyramid WHERE round_id >= ?");
+    query.addBindValue(targetRound);
+    if (!query.exec()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to delete vibration pyramid: " + query.lastError().text());
+        return;
+    }
+
+    // 删除所有 round_id >= targetRound 的段登记（文件在提交后删除）
+    const QStringList segments = segmentFiles(">=", targetRound);
+    query.prepare("DELETE FROM vibration_segments WHERE round_id >= ?");
+    query.addBindValue(targetRound);
+    if (!query.exec()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to delete vibration segments: " + query.lastError().text());
+        return;
+    }
+
     // 删除所有 round_id >= targetRound 的时间窗口
     query.prepare("DELETE FROM time_windows WHERE round_id >= ?");
     query.addBindValue(targetRound);
@@ -398,6 +794,15 @@ void DbWriter::resetToRound(int targetRound)
     }
     int deletedFreqLog = query.numRowsAffected();
 
+    // 删除所有 round_id >= targetRound 的管线延迟统计
+    query.prepare("DELETE FROM pipeline_latency WHERE round_id >= ?");
+    query.addBindValue(targetRound);
+    if (!query.exec()) {
+        m_db.rollback();
+        emit errorOccurred("Failed to delete pipeline latency: " + query.lastError().text());
+        return;
+    }
+
     // 删除所有 round_id >= targetRound 的轮次记录
     query.prepare("DELETE FROM rounds WHERE round_id >= ?");
     query.addBindValue(targetRound);
@@ -453,12 +858,45 @@ void DbWriter::resetToRound(int targetRound)
         }
     }
 
-    // 清除窗口缓存
+    // 清除窗口缓存，丢弃被删除轮次尚未落盘的振动子块、标量块和段文件
     clearWindowCache();
 
+    if (m_segmentWriter.isOpen() && m_segmentWriter.roundId() >= targetRound) {
+        m_segmentWriter.close();
+    }
+    removeSegmentFiles(segments);
+
+    auto accIt = m_vibrationAccumulators.begin();
+    while (accIt != m_vibrationAccumulators.end()) {
+        if (accIt->roundId >= targetRound) {
+            accIt = m_vibrationAccumulators.erase(accIt);
+        } else {
+            ++accIt;
+        }
+    }
+
+    auto scalarIt = m_scalarAccumulators.begin();
+    while (scalarIt != m_scalarAccumulators.end()) {
+        if (scalarIt->roundId >= targetRound) {
+            scalarIt = m_scalarAccumulators.erase(scalarIt);
+        } else {
+            ++scalarIt;
+        }
+    }
+
+    auto pyramidIt = m_pyramids.begin();
+    while (pyramidIt != m_pyramids.end()) {
+        if (pyramidIt->roundId >= targetRound) {
+            pyramidIt = m_pyramids.erase(pyramidIt);
+        } else {
+            ++pyramidIt;
+        }
+    }
+
     qDebug() << "Reset to round" << targetRound << "complete."
              << "| Deleted rounds:" << deletedRounds
              << "| Scalar samples:" << deletedScalarSamples
+             << "| Scalar blocks:" << deletedScalarBlocks
              << "| Vibration blocks:" << deletedVibrationBlocks
              << "| Windows:" << deletedWindows
              << "| Events:" << deletedEvents
@@ -513,8 +951,7 @@ void DbWriter::logEvent(int roundId, const QString &eventType, const QString &de
 bool DbWriter::initializeDatabase()
 {
     // 创建数据库连接（使用线程ID作为连接名）
-    QString connectionName = QString("DbWriter_%1").arg((qint64)QThread::currentThreadId());
-    m_db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+    m_db = QSqlDatabase::addDatabase("QSQLITE", connectionName());
     m_db.setDatabaseName(m_dbPath);
     
     if (!m_db.open()) {
@@ -523,90 +960,231 @@ bool DbWriter::initializeDatabase()
     }
     
     qDebug() << "Database opened:" << m_dbPath;
+
+    // 持久性档位（不依赖schema文件，每次打开都执行）
+    if (!applyStoragePolicy()) {
+        return false;
+    }
     
     // 创建表结构
     if (!createTables()) {
         return false;
     }
-    
-    return true;
-}
 
-bool DbWriter::createTables()
-{
-    // 读取schema.sql文件
-    QFile schemaFile(":/database/schema.sql");
-    if (!schemaFile.exists()) {
-        // 如果资源文件不存在，尝试从文件系统读取
-        schemaFile.setFileName("database/schema.sql");
+    // 段文件存储：打开时确认段目录可写，避免轮次开始后才发现振动数据无处落盘
+    if (m_storagePolicy.vibrationSegments()) {
+        const QString directory = VibrationSegmentWriter::directoryFor(m_dbPath);
+        if (!QDir().mkpath(directory)) {
+            emit errorOccurred("Cannot create segment directory " + directory);
+            return false;
+        }
+        qDebug() << "Vibration BLOBs stored in segment files under" << directory;
     }
-    
-    if (!schemaFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Cannot open schema.sql, creating tables manually...";
-        // 手动创建表（精简版）
-        return createTablesManually();
+
+    // 表结构就绪后创建热路径预编译语句（重新打开时重新创建）
+    if (!prepareStatements()) {
+        return false;
     }
-    
-    QString sql = schemaFile.readAll();
-    schemaFile.close();
-    
-    // 执行SQL脚本
-    QStringList statements = sql.split(';', Qt::SkipEmptyParts);
-    QSqlQuery query(m_db);
-    
-    for (const QString &statement : statements) {
-        QString trimmed = statement.trimmed();
-        if (trimmed.isEmpty() || trimmed.startsWith("--")) {
-            continue;
-        }
-        
-        if (!query.exec(trimmed)) {
-            qWarning() << "Failed to execute SQL:" << query.lastError().text();
-            qWarning() << "Statement:" << trimmed;
-        }
+
+    // 旧库的逐行标量数据按schema版本在后台分段转换为块布局（不阻塞打开）
+    if (m_storagePolicy.scalarBlocks() && !startScalarMigration()) {
+        return false;
     }
     
-    qDebug() << "Database tables created/verified";
     return true;
 }
 
-bool DbWriter::createTablesManually()
+bool DbWriter::applyStoragePolicy()
 {
     QSqlQuery query(m_db);
+    for (const QString &pragma : m_storagePolicy.pragmas()) {
+        if (!query.exec(pragma)) {
+            emit errorOccurred("Failed to apply " + pragma + ": " + query.lastError().text());
+            return false;
+        }
+    }
 
-    // 创建rounds表（添加status字段）
-    if (!query.exec(
-        "CREATE TABLE IF NOT EXISTS rounds ("
-        "round_id INTEGER PRIMARY KEY AUTOINCREMENT, "
-        "start_ts_us INTEGER NOT NULL, "
-        "end_ts_us INTEGER, "
-        "status TEXT DEFAULT 'running', "
-        "operator_name TEXT, "
-        "note TEXT, "
-        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)")) {
-        emit errorOccurred("Failed to create rounds table: " + query.lastError().text());
-        return false;
+    // journal_mode返回实际模式（如内存数据库无法切换到WAL）
+    QString journalMode;
+    if (query.exec("PRAGMA journal_mode") && query.next()) {
+        journalMode = query.value(0).toString();
     }
+    query.finish();
 
-    // 创建time_windows表（核心创新）
-    if (!query.exec(
-        "CREATE TABLE IF NOT EXISTS time_windows ("
-        "window_id INTEGER PRIMARY KEY AUTOINCREMENT, "
-        "round_id INTEGER NOT NULL, "
-        "window_start_us INTEGER NOT NULL, "
-        "window_end_us INTEGER NOT NULL, "
-        "has_vibration INTEGER DEFAULT 0, "
-        "has_mdb INTEGER DEFAULT 0, "
-        "has_motor INTEGER DEFAULT 0)")) {
-        emit errorOccurred("Failed to create time_windows table: " + query.lastError().text());
-        return false;
+    if (journalMode.compare("wal", Qt::CaseInsensitive) != 0) {
+        qWarning() << "Database journal mode is" << journalMode << "instead of WAL";
     }
+    qDebug() << "Storage policy applied:" << m_storagePolicy.describe() << ", journal mode" << journalMode;
+    return true;
+}
 
-    // 创建time_windows索引
-    query.exec("CREATE UNIQUE INDEX IF NOT EXISTS idx_tw_round_start "
-               "ON time_windows(round_id, window_start_us)");
+void DbWriter::startCheckpointer()
+{
+    if (!m_storagePolicy.backgroundCheckpoint() || m_checkpointThread) {
+        return;
+    }
 
-    // 创建scalar_samples表（添加window_id）
+    m_checkpointThread = new QThread();
+    m_checkpointThread->setObjectName("DbCheckpoint");
+    m_checkpointer = new WalCheckpointer(m_dbPath, m_storagePolicy);
+    m_checkpointer->moveToThread(m_checkpointThread);
+
+    connect(m_checkpointThread, &QThread::started, m_checkpointer, &WalCheckpointer::start);
+    connect(m_checkpointer, &WalCheckpointer::metricsUpdated, this, &DbWriter::walMetricsUpdated);
+    connect(m_checkpointer, &WalCheckpointer::errorOccurred, this, &DbWriter::errorOccurred);
+
+    m_checkpointThread->start(QThread::LowPriority);
+}
+
+void DbWriter::stopCheckpointer()
+{
+    if (!m_checkpointThread) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_checkpointer, "stop", Qt::BlockingQueuedConnection);
+    m_checkpointThread->quit();
+    m_checkpointThread->wait();
+
+    // 线程已退出，可在本线程中销毁
+    delete m_checkpointer;
+    m_checkpointer = nullptr;
+    delete m_checkpointThread;
+    m_checkpointThread = nullptr;
+}
+
+QString DbWriter::connectionName()
+{
+    return QString("DbWriter_%1").arg((qint64)QThread::currentThreadId());
+}
+
+QString DbWriter::statementSql(Statement id)
+{
+    switch (id) {
+    case StmtInsertScalar:
+        return "INSERT INTO scalar_samples "
+               "(round_id, window_id, sensor_type, channel_id, timestamp_us, value) "
+               "VALUES (?, ?, ?, ?, ?, ?)";
+    case StmtInsertVibration:
+        return "INSERT INTO vibration_blocks "
+               "(round_id, window_id, channel_id, start_ts_us, sample_rate, "
+               "n_samples, data_blob, min_value, max_value, mean_value, rms_value, "
+               "segment_id, segment_offset, segment_length, decimation) "
+               "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    case StmtSelectWindow:
+        return "SELECT window_id FROM time_windows "
+               "WHERE round_id = ? AND window_start_us = ?";
+    case StmtInsertWindow:
+        return "INSERT INTO time_windows "
+               "(round_id, window_start_us, window_end_us) "
+               "VALUES (?, ?, ?)";
+    case StmtUpdateWindowFlags:
+        // 只置位不清零：窗口可能已由其他批次/上次运行写过标志
+        return "UPDATE time_windows SET has_vibration = MAX(has_vibration, ?), "
+               "has_mdb = MAX(has_mdb, ?), has_motor = MAX(has_motor, ?) WHERE window_id = ?";
+    case StmtInsertScalarBlock:
+        return "INSERT INTO scalar_blocks "
+               "(round_id, window_id, sensor_type, channel_id, start_ts_us, end_ts_us, "
+               "n_samples, ts_blob, value_blob) "
+               "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)";
+    case StmtInsertSegment:
+        return "INSERT INTO vibration_segments (round_id) VALUES (?)";
+    case StmtReplacePyramid:
+        // 未满的行可能多次写出，后写的包含之前的全部桶
+        return "INSERT OR REPLACE INTO vibration_pyramid "
+               "(round_id, channel_id, level_us, start_us, n_buckets, data_blob) "
+               "VALUES (?, ?, ?, ?, ?, ?)";
+    default:
+        break;
+    }
+
+    // 多行标量插入：2^k行（SQLite 3.7.11+，参数数 ≤ 6 × 128，低于默认上限999）
+    const int level = id - StmtInsertScalarBulk;
+    if (level >= 0 && level < BULK_SCALAR_LEVELS) {
+        QStringList rows;
+        for (int i = 0; i < (1 << level); ++i) {
+            rows << "(?, ?, ?, ?, ?, ?)";
+        }
+        return "INSERT INTO scalar_samples "
+               "(round_id, window_id, sensor_type, channel_id, timestamp_us, value) "
+               "VALUES " + rows.join(", ");
+    }
+    return QString();
+}
+
+bool DbWriter::prepareStatements()
+{
+    releaseStatements();
+
+    for (int id = 0; id < StatementCount; ++id) {
+        QSqlQuery query(m_db);
+        if (!query.prepare(statementSql(static_cast<Statement>(id)))) {
+            emit errorOccurred("Failed to prepare statement: " + query.lastError().text());
+            releaseStatements();
+            return false;
+        }
+        m_statementPrepares++;
+        m_statements[id] = query;
+    }
+    return true;
+}
+
+void DbWriter::releaseStatements()
+{
+    // 空语句占位：未打开数据库时执行直接失败
+    m_statements = QVector<QSqlQuery>(StatementCount);
+}
+
+QSqlQuery &DbWriter::statement(Statement id)
+{
+    // 不缓存（基准对照）：每次重新prepare，等同于每块构造新QSqlQuery
+    if (!m_cacheStatements && m_db.isOpen()) {
+        m_statements[id] = QSqlQuery(m_db);
+        m_statements[id].prepare(statementSql(id));
+        m_statementPrepares++;
+    }
+    return m_statements[id];
+}
+
+// 表结构以此处DDL为准（database/schema_v2.sql仅为v2设计说明，不被执行）。
+// 新增表/列在这里追加，旧库中缺失的列由下方ALTER补齐
+bool DbWriter::createTables()
+{
+    QSqlQuery query(m_db);
+
+    // 创建rounds表（添加status字段）
+    if (!query.exec(
+        "CREATE TABLE IF NOT EXISTS rounds ("
+        "round_id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "start_ts_us INTEGER NOT NULL, "
+        "end_ts_us INTEGER, "
+        "status TEXT DEFAULT 'running', "
+        "operator_name TEXT, "
+        "note TEXT, "
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)")) {
+        emit errorOccurred("Failed to create rounds table: " + query.lastError().text());
+        return false;
+    }
+
+    // 创建time_windows表（核心创新）
+    if (!query.exec(
+        "CREATE TABLE IF NOT EXISTS time_windows ("
+        "window_id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "round_id INTEGER NOT NULL, "
+        "window_start_us INTEGER NOT NULL, "
+        "window_end_us INTEGER NOT NULL, "
+        "has_vibration INTEGER DEFAULT 0, "
+        "has_mdb INTEGER DEFAULT 0, "
+        "has_motor INTEGER DEFAULT 0)")) {
+        emit errorOccurred("Failed to create time_windows table: " + query.lastError().text());
+        return false;
+    }
+
+    // 创建time_windows索引
+    query.exec("CREATE UNIQUE INDEX IF NOT EXISTS idx_tw_round_start "
+               "ON time_windows(round_id, window_start_us)");
+
+    // 创建scalar_samples表（添加window_id）
     if (!query.exec(
         "CREATE TABLE IF NOT EXISTS scalar_samples ("
         "sample_id INTEGER PRIMARY KEY AUTOINCREMENT, "
@@ -623,6 +1201,26 @@ bool DbWriter::createTablesManually()
     // 创建scalar_samples索引
     query.exec("CREATE INDEX IF NOT EXISTS idx_scalar_window ON scalar_samples(window_id)");
 
+    // 创建scalar_blocks表（每窗口/传感器类型/通道一行，时间戳和数值打包为BLOB）
+    if (!query.exec(
+        "CREATE TABLE IF NOT EXISTS scalar_blocks ("
+        "scalar_block_id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "round_id INTEGER NOT NULL, "
+        "window_id INTEGER NOT NULL, "
+        "sensor_type INTEGER NOT NULL, "
+        "channel_id INTEGER NOT NULL, "
+        "start_ts_us INTEGER NOT NULL, "
+        "end_ts_us INTEGER NOT NULL, "
+        "n_samples INTEGER NOT NULL, "
+        "ts_blob BLOB NOT NULL, "
+        "value_blob BLOB NOT NULL)")) {
+        emit errorOccurred("Failed to create scalar_blocks table: " + query.lastError().text());
+        return false;
+    }
+
+    query.exec("CREATE INDEX IF NOT EXISTS idx_scalar_block_window ON scalar_blocks(window_id)");
+    query.exec("CREATE INDEX IF NOT EXISTS idx_scalar_block_round_ts ON scalar_blocks(round_id, start_ts_us)");
+
     // 创建vibration_blocks表（添加window_id和统计字段）
     if (!query.exec(
         "CREATE TABLE IF NOT EXISTS vibration_blocks ("
@@ -645,6 +1243,47 @@ bool DbWriter::createTablesManually()
     // 创建vibration_blocks索引
     query.exec("CREATE INDEX IF NOT EXISTS idx_vib_window ON vibration_blocks(window_id)");
 
+    // 段文件位置列（旧库补列；数据在data_blob中时为NULL）和包络抽取因子（NULL/1 = 原始波形）
+    QStringList vibrationColumns;
+    if (query.exec("PRAGMA table_info(vibration_blocks)")) {
+        while (query.next()) {
+            vibrationColumns << query.value(1).toString();
+        }
+    }
+    for (const char *column : {"segment_id", "segment_offset", "segment_length", "decimation"}) {
+        if (!vibrationColumns.contains(QLatin1String(column)) &&
+            !query.exec(QString("ALTER TABLE vibration_blocks ADD COLUMN %1 INTEGER").arg(QLatin1String(column)))) {
+            emit errorOccurred("Failed to add vibration_blocks column: " + query.lastError().text());
+            return false;
+        }
+    }
+
+    // 创建vibration_segments表（段文件登记：AUTOINCREMENT保证删除后段号不复用）
+    if (!query.exec(
+        "CREATE TABLE IF NOT EXISTS vibration_segments ("
+        "segment_id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "round_id INTEGER NOT NULL, "
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)")) {
+        emit errorOccurred("Failed to create vibration_segments table: " + query.lastError().text());
+        return false;
+    }
+
+    query.exec("CREATE INDEX IF NOT EXISTS idx_segment_round ON vibration_segments(round_id)");
+
+    // 创建vibration_pyramid表（振动降采样金字塔，每层每100个桶一行）
+    if (!query.exec(
+        "CREATE TABLE IF NOT EXISTS vibration_pyramid ("
+        "round_id INTEGER NOT NULL, "
+        "channel_id INTEGER NOT NULL, "
+        "level_us INTEGER NOT NULL, "
+        "start_us INTEGER NOT NULL, "
+        "n_buckets INTEGER NOT NULL, "
+        "data_blob BLOB NOT NULL, "
+        "PRIMARY KEY (round_id, channel_id, level_us, start_us)) WITHOUT ROWID")) {
+        emit errorOccurred("Failed to create vibration_pyramid table: " + query.lastError().text());
+        return false;
+    }
+
     // 创建events表
     if (!query.exec(
         "CREATE TABLE IF NOT EXISTS events ("
@@ -672,6 +1311,24 @@ bool DbWriter::createTablesManually()
         return false;
     }
 
+    // 创建pipeline_latency表（每轮次结束时写入分段延迟统计）
+    if (!query.exec(
+        "CREATE TABLE IF NOT EXISTS pipeline_latency ("
+        "latency_id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "round_id INTEGER NOT NULL, "
+        "sensor_type INTEGER NOT NULL, "
+        "segment TEXT NOT NULL, "
+        "n_samples INTEGER NOT NULL, "
+        "p50_us INTEGER NOT NULL, "
+        "p99_us INTEGER NOT NULL, "
+        "max_us INTEGER NOT NULL, "
+        "mean_us REAL NOT NULL)")) {
+        emit errorOccurred("Failed to create pipeline_latency table: " + query.lastError().text());
+        return false;
+    }
+
+    query.exec("CREATE INDEX IF NOT EXISTS idx_latency_round ON pipeline_latency(round_id)");
+
     // 创建system_config表
     if (!query.exec(
         "CREATE TABLE IF NOT EXISTS system_config ("
@@ -689,7 +1346,7 @@ bool DbWriter::createTablesManually()
     query.exec("INSERT OR IGNORE INTO system_config (key, value, description) "
                "VALUES ('window_duration_us', '1000000', '时间窗口时长（微秒）')");
 
-    qDebug() << "Database v2.0 tables created manually";
+    qDebug() << "Database v2.0 tables created/verified";
     return true;
 }
 
@@ -701,12 +1358,12 @@ bool DbWriter::writeScalarData(const DataBlock &block)
         return false;
     }
 
-    // 低频标量数据（MDB传感器、电机参数等）
-    QSqlQuery query(m_db);
-    query.prepare("INSERT INTO scalar_samples "
-                  "(round_id, window_id, sensor_type, channel_id, timestamp_us, value) "
-                  "VALUES (?, ?, ?, ?, ?, ?)");
+    // 多样本块（如控制器端高速采集）可能跨越窗口边界，逐样本检查所属窗口
+    qint64 windowEnd = (block.startTimestampUs / 1000000 + 1) * 1000000;
+    QVector<int> touchedWindows;
+    touchedWindows.append(windowId);
 
+    // 低频标量数据（MDB传感器、电机参数等）
     for (int i = 0; i < block.values.size(); ++i) {
         // 计算每个样本的时间戳
         qint64 sampleTimestamp = block.startTimestampUs;
@@ -714,35 +1371,536 @@ bool DbWriter::writeScalarData(const DataBlock &block)
             sampleTimestamp += static_cast<qint64>((i * 1000000.0) / block.sampleRate);
         }
 
-        query.addBindValue(block.roundId);
-        query.addBindValue(windowId);
-        query.addBindValue(static_cast<int>(block.sensorType));
-        query.addBindValue(block.channelId);
-        query.addBindValue(sampleTimestamp);
-        query.addBindValue(block.values[i]);
+        if (sampleTimestamp >= windowEnd) {
+            windowId = getOrCreateWindow(block.roundId, sampleTimestamp);
+            if (windowId < 0) {
+                return false;
+            }
+            windowEnd = (sampleTimestamp / 1000000 + 1) * 1000000;
+            touchedWindows.append(windowId);
+        }
 
-        if (!query.exec()) {
-            qWarning() << "Failed to write scalar data:" << query.lastError().text();
+        if (!addScalarRow(block.roundId, windowId, static_cast<int>(block.sensorType),
+                          block.channelId, sampleTimestamp, block.values[i])) {
             return false;
         }
     }
 
     // 更新窗口状态
-    if (block.sensorType >= SensorType::Force_Upper &&
-        block.sensorType <= SensorType::Position_MDB) {
-        updateWindowStatus(windowId, "mdb");
-    } else if (block.sensorType >= SensorType::Motor_Position &&
-               block.sensorType <= SensorType::Motor_Current) {
-        updateWindowStatus(windowId, "motor");
+    for (int touchedWindowId : touchedWindows) {
+        if (block.sensorType >= SensorType::Force_Upper &&
+            block.sensorType <= SensorType::Position_MDB) {
+            markWindow(touchedWindowId, WindowHasMdb);
+        } else if (block.sensorType >= SensorType::Motor_Position &&
+                   block.sensorType <= SensorType::Motor_Current) {
+            markWindow(touchedWindowId, WindowHasMotor);
+        }
+    }
+
+    return true;
+}
+
+void DbWriter::ScalarRows::append(int roundId, int windowId, int sensorType, int channelId,
+                                  qint64 timestampUs, double value)
+{
+    roundIds.append(roundId);
+    windowIds.append(windowId);
+    sensorTypes.append(sensorType);
+    channelIds.append(channelId);
+    timestamps.append(timestampUs);
+    values.append(value);
+}
+
+void DbWriter::ScalarRows::clear()
+{
+    // resize(0)保留容量，稳态下不再分配
+    roundIds.resize(0);
+    windowIds.resize(0);
+    sensorTypes.resize(0);
+    channelIds.resize(0);
+    timestamps.resize(0);
+    values.resize(0);
+}
+
+bool DbWriter::addScalarRow(int roundId, int windowId, int sensorType, int channelId,
+                            qint64 timestampUs, double value)
+{
+    if (m_storagePolicy.scalarBlocks()) {
+        ScalarAccumulator &acc = m_scalarAccumulators[scalarKey(sensorType, channelId)];
+
+        // 轮次/窗口变化：先写出上一窗口的样本
+        bool ok = true;
+        if (!acc.values.isEmpty() && (acc.roundId != roundId || acc.windowId != windowId)) {
+            ok = writeScalarBlock(sensorType, channelId, acc);
+        }
+
+        if (acc.values.isEmpty()) {
+            acc.roundId = roundId;
+            acc.windowId = windowId;
+            acc.ordered = true;
+        } else if (timestampUs < acc.timestamps.last()) {
+            acc.ordered = false;
+        }
+        acc.timestamps.append(timestampUs);
+        acc.values.append(value);
+        acc.lastAppendMs = QDateTime::currentMSecsSinceEpoch();
+        return ok;
+    }
+
+    if (m_bulkScalarInserts) {
+        m_scalarRows.append(roundId, windowId, sensorType, channelId, timestampUs, value);
+        return true;
+    }
+
+    QSqlQuery &query = statement(StmtInsertScalar);
+    query.addBindValue(roundId);
+    query.addBindValue(windowId);
+    query.addBindValue(sensorType);
+    query.addBindValue(channelId);
+    query.addBindValue(timestampUs);
+    query.addBindValue(value);
+
+    if (!query.exec()) {
+        qWarning() << "Failed to write scalar data:" << query.lastError().text();
+        return false;
+    }
+    m_scalarRowsWritten++;
+    m_scalarTableRows++;
+    return true;
+}
+
+bool DbWriter::flushScalarRows()
+{
+    const int total = m_scalarRows.size();
+    bool ok = true;
+
+    // 按2的幂分块（最大2^(BULK_SCALAR_LEVELS-1)行），每种块大小一条预编译的多行INSERT
+    int offset = 0;
+    while (offset < total) {
+        int level = BULK_SCALAR_LEVELS - 1;
+        while ((1 << level) > total - offset) {
+            --level;
+        }
+        const int rows = 1 << level;
+
+        QSqlQuery &query = statement(static_cast<Statement>(StmtInsertScalarBulk + level));
+        for (int i = offset; i < offset + rows; ++i) {
+            query.addBindValue(m_scalarRows.roundIds[i]);
+            query.addBindValue(m_scalarRows.windowIds[i]);
+            query.addBindValue(m_scalarRows.sensorTypes[i]);
+            query.addBindValue(m_scalarRows.channelIds[i]);
+            query.addBindValue(m_scalarRows.timestamps[i]);
+            query.addBindValue(m_scalarRows.values[i]);
+        }
+
+        if (query.exec()) {
+            m_scalarRowsWritten += rows;
+            m_scalarTableRows += rows;
+        } else {
+            qWarning() << "Failed to write scalar data:" << query.lastError().text();
+            ok = false;
+        }
+        offset += rows;
+    }
+
+    m_scalarRows.clear();
+    return ok;
+}
+
+quint64 DbWriter::scalarKey(int sensorType, int channelId)
+{
+    return (static_cast<quint64>(static_cast<quint32>(sensorType)) << 32) | static_cast<quint32>(channelId);
+}
+
+bool DbWriter::writeScalarBlock(int sensorType, int channelId, ScalarAccumulator &acc)
+{
+    const int n = acc.values.size();
+    if (n == 0) {
+        return true;
+    }
+
+    // 乱序到达（如多源合并）时按时间戳排序后再打包，读取端可假定块内有序
+    if (!acc.ordered) {
+        QVector<int> order(n);
+        for (int i = 0; i < n; ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&acc](int a, int b) {
+            return acc.timestamps[a] < acc.timestamps[b];
+        });
+
+        QVector<qint64> timestamps(n);
+        QVector<double> values(n);
+        for (int i = 0; i < n; ++i) {
+            timestamps[i] = acc.timestamps[order[i]];
+            values[i] = acc.values[order[i]];
+        }
+        acc.timestamps.swap(timestamps);
+        acc.values.swap(values);
+        acc.ordered = true;
+    }
+
+    const qint64 startUs = acc.timestamps.first();
+    const qint64 endUs = acc.timestamps.last();
+
+    QSqlQuery &query = statement(StmtInsertScalarBlock);
+    query.addBindValue(acc.roundId);
+    query.addBindValue(acc.windowId);
+    query.addBindValue(sensorType);
+    query.addBindValue(channelId);
+    query.addBindValue(startUs);
+    query.addBindValue(endUs);
+    query.addBindValue(n);
+    query.addBindValue(ScalarBlockCodec::packTimestamps(acc.timestamps, startUs));
+    query.addBindValue(ScalarBlockCodec::packValues(acc.values));
+
+    // resize(0)保留容量，下一窗口不再分配
+    acc.timestamps.resize(0);
+    acc.values.resize(0);
+
+    if (!query.exec()) {
+        qWarning() << "Failed to write scalar block:" << query.lastError().text();
+        return false;
+    }
+    m_scalarRowsWritten += n;
+    m_scalarTableRows++;
+    return true;
+}
+
+int DbWriter::schemaVersion()
+{
+    QSqlQuery query(m_db);
+    if (!query.exec("PRAGMA user_version") || !query.next()) {
+        return -1;
     }
+    return query.value(0).toInt();
+}
 
+bool DbWriter::setSchemaVersion(int version)
+{
+    QSqlQuery query(m_db);
+    if (!query.exec(QString("PRAGMA user_version = %1").arg(version))) {
+        emit errorOccurred("Failed to set schema version: " + query.lastError().text());
+        return false;
+    }
+    return true;
+}
+
+bool DbWriter::startScalarMigration()
+{
+    const int version = schemaVersion();
+    if (version < 0) {
+        emit errorOccurred("Failed to read schema version: " + m_db.lastError().text());
+        return false;
+    }
+    if (version >= SCHEMA_VERSION) {
+        return true;
+    }
+
+    QSqlQuery query(m_db);
+    if (!query.exec("SELECT EXISTS (SELECT 1 FROM scalar_samples)") || !query.next()) {
+        emit errorOccurred("Failed to inspect scalar_samples: " + query.lastError().text());
+        return false;
+    }
+    const bool hasLegacyRows = query.value(0).toBool();
+    query.finish();
+
+    // 新库或已清空的旧库：直接标记为当前版本
+    if (!hasLegacyRows) {
+        return setSchemaVersion(SCHEMA_VERSION);
+    }
+
+    // 未迁移的行留在scalar_samples，读取端同时读取两张表，数据不缺失
+    if (!m_storagePolicy.migrateScalarSamples) {
+        qDebug() << "Legacy scalar_samples rows kept (migrate_scalar_samples = false)";
+        return true;
+    }
+
+    // 原始行按段移入scalar_samples_legacy保留，转换有误时可从中恢复
+    if (!query.exec("CREATE TABLE IF NOT EXISTS scalar_samples_legacy AS SELECT * FROM scalar_samples WHERE 0")) {
+        emit errorOccurred("Failed to create scalar_samples_legacy: " + query.lastError().text());
+        return false;
+    }
+
+    m_migratedRows = 0;
+    m_migrationClock.start();
+    m_migrationTimer = new QTimer(this);
+    m_migrationTimer->setInterval(MIGRATION_INTERVAL_MS);
+    connect(m_migrationTimer, &QTimer::timeout, this, &DbWriter::onMigrationTimer);
+    m_migrationTimer->start();
+
+    qDebug() << "Migrating scalar_samples to scalar_blocks in the background,"
+             << MIGRATION_CHUNK_WINDOWS << "windows per step";
+    return true;
+}
+
+void DbWriter::stopScalarMigration()
+{
+    if (m_migrationTimer) {
+        m_migrationTimer->stop();
+        delete m_migrationTimer;
+        m_migrationTimer = nullptr;
+    }
+}
+
+void DbWriter::onMigrationTimer()
+{
+    const int migrated = migrateScalarChunk();
+    if (migrated < 0) {
+        // 失败的段已回滚，剩余行保持原样，下次打开数据库时继续
+        stopScalarMigration();
+        emit errorOccurred("Scalar migration stopped, remaining rows kept in scalar_samples");
+        return;
+    }
+    if (migrated > 0) {
+        return;
+    }
+
+    stopScalarMigration();
+    if (setSchemaVersion(SCHEMA_VERSION)) {
+        qDebug() << "Scalar migration complete:" << m_migratedRows << "rows in"
+                 << m_migrationClock.elapsed() << "ms, originals kept in scalar_samples_legacy";
+    }
+}
+
+int DbWriter::migrateScalarChunk()
+{
+    // 从最小的窗口号开始，每次转换MIGRATION_CHUNK_WINDOWS个窗口（idx_scalar_window）
+    QSqlQuery query(m_db);
+    if (!query.exec("SELECT MIN(window_id) FROM scalar_samples") || !query.next()) {
+        qWarning() << "Failed to read scalar_samples:" << query.lastError().text();
+        return -1;
+    }
+    if (query.value(0).isNull()) {
+        return 0;
+    }
+    const qint64 firstWindow = query.value(0).toLongLong();
+    const qint64 endWindow = firstWindow + MIGRATION_CHUNK_WINDOWS;
+    query.finish();
+
+    // 每段一个事务：转换、备份、删除三步的行数一致才提交
+    if (!m_db.transaction()) {
+        qWarning() << "Failed to start transaction:" << m_db.lastError().text();
+        return -1;
+    }
+
+    QSqlQuery select(m_db);
+    select.setForwardOnly(true);
+    select.prepare("SELECT round_id, window_id, sensor_type, channel_id, timestamp_us, value "
+                   "FROM scalar_samples "
+                   "WHERE window_id >= ? AND window_id < ? "
+                   "ORDER BY window_id, sensor_type, channel_id, timestamp_us");
+    select.addBindValue(firstWindow);
+    select.addBindValue(endWindow);
+    if (!select.exec()) {
+        m_db.rollback();
+        qWarning() << "Failed to read scalar_samples:" << select.lastError().text();
+        return -1;
+    }
+
+    ScalarAccumulator acc;
+    int sensorType = 0;
+    int channelId = 0;
+    int rows = 0;
+    int packed = 0;
+    bool ok = true;
+
+    while (ok && select.next()) {
+        const int roundId = select.value(0).toInt();
+        const int windowId = select.value(1).toInt();
+        const int type = select.value(2).toInt();
+        const int channel = select.value(3).toInt();
+
+        if (!acc.values.isEmpty() &&
+            (acc.windowId != windowId || acc.roundId != roundId || sensorType != type || channelId != channel)) {
+            packed += acc.values.size();
+            ok = writeScalarBlock(sensorType, channelId, acc);
+        }
+        if (acc.values.isEmpty()) {
+            acc.roundId = roundId;
+            acc.windowId = windowId;
+            sensorType = type;
+            channelId = channel;
+        }
+        acc.timestamps.append(select.value(4).toLongLong());
+        acc.values.append(select.value(5).toDouble());
+        ++rows;
+    }
+    packed += acc.values.size();
+    ok = ok && writeScalarBlock(sensorType, channelId, acc);
+    select.finish();
+
+    auto moveRows = [this, firstWindow, endWindow, rows](const QString &sql) {
+        QSqlQuery move(m_db);
+        move.prepare(sql);
+        move.addBindValue(firstWindow);
+        move.addBindValue(endWindow);
+        if (!move.exec()) {
+            qWarning() << "Scalar migration failed:" << move.lastError().text();
+            return false;
+        }
+        return move.numRowsAffected() == rows;
+    };
+
+    ok = ok && packed == rows &&
+         moveRows("INSERT INTO scalar_samples_legacy SELECT * FROM scalar_samples "
+                  "WHERE window_id >= ? AND window_id < ?") &&
+         moveRows("DELETE FROM scalar_samples WHERE window_id >= ? AND window_id < ?");
+
+    if (!ok || !m_db.commit()) {
+        m_db.rollback();
+        qWarning() << "Scalar migration of windows" << firstWindow << "-" << endWindow - 1
+                   << "rolled back (" << rows << "rows read," << packed << "packed)";
+        return -1;
+    }
+
+    m_migratedRows += rows;
+    return qMax(1, rows);
+}
+
+bool DbWriter::writeMotorSnapshot(const DataBlock &block)
+{
+    int windowId = getOrCreateWindow(block.roundId, block.startTimestampUs);
+    if (windowId < 0) {
+        return false;
+    }
+
+    // 展开为逐电机逐参数的标量行（表结构不变），NaN槽位跳过
+
+    bool written = false;
+    for (int param = 0; param < MotorSnapshot::ParamCount; ++param) {
+        for (int motorId = 0; motorId < block.channelCount; ++motorId) {
+            const double value = block.snapshotValue(param, motorId);
+            if (qIsNaN(value)) {
+                continue;
+            }
+
+            if (!addScalarRow(block.roundId, windowId, static_cast<int>(MotorSnapshot::paramSensorType(param)),
+                              motorId, block.startTimestampUs, value)) {
+                return false;
+            }
+            written = true;
+        }
+    }
+
+    if (written) {
+        markWindow(windowId, WindowHasMotor);
+    }
+    return true;
+}
+
+bool DbWriter::writeVibrationSummary(const DataBlock &block)
+{
+    int windowId = getOrCreateWindow(block.roundId, block.startTimestampUs);
+    if (windowId < 0) {
+        return false;
+    }
+
+    // 每通道每个统计量一行：channel_id = 通道 * StatCount + 统计量
+    const int count = qMin(block.values.size(), block.channelCount * VibrationSummary::StatCount);
+    for (int i = 0; i < count; ++i) {
+        if (!addScalarRow(block.roundId, windowId, static_cast<int>(SensorType::Vibration_Summary),
+                          block.channelId * VibrationSummary::StatCount + i,
+                          block.startTimestampUs, block.values[i])) {
+            return false;
+        }
+    }
+
+    if (count > 0) {
+        markWindow(windowId, WindowHasVibration);
+    }
     return true;
 }
 
 bool DbWriter::writeVibrationData(const DataBlock &block)
+{
+    if (block.numSamples <= 0) {
+        return true;
+    }
+
+    // 打包块（SoA）：拆成每通道一行，共享同一时间戳
+    if (block.isPacked()) {
+        const int channelCount = qMin(block.channelCount,
+                                      block.payloadSize() / qMax(1, block.numSamples * static_cast<int>(sizeof(float))));
+        bool ok = true;
+        for (int ch = 0; ch < channelCount; ++ch) {
+            ok = appendVibrationChannel(block.roundId, block.channelId + ch, block.startTimestampUs,
+                                        block.sampleRate, block.channelData(ch), block.numSamples,
+                                        block.quantStep, block.decimation) && ok;
+        }
+        return ok;
+    }
+
+    return appendVibrationChannel(block.roundId, block.channelId, block.startTimestampUs,
+                                  block.sampleRate, reinterpret_cast<const float*>(block.payloadData()),
+                                  block.numSamples, block.quantStep, block.decimation);
+}
+
+bool DbWriter::appendVibrationChannel(int roundId, int channelId, qint64 startTimestampUs,
+                                      double sampleRate, const float *data, int n, float quantStep,
+                                      int decimation)
+{
+    const int bytes = n * static_cast<int>(sizeof(float));
+    const qint64 windowStart = (startTimestampUs / 1000000) * 1000000;
+    VibrationAccumulator &acc = m_vibrationAccumulators[channelId];
+
+    // 轮次/窗口/采样率/抽取因子变化：先写出上一窗口的合并数据（包络对不与原始波形拼接）
+    // 采样率为采样时钟的估计值，逐块有ppm级变化，不视为采样率变化
+    bool ok = true;
+    if (acc.numSamples > 0 &&
+        (acc.roundId != roundId ||
+         acc.windowStartUs != windowStart ||
+         qAbs(acc.sampleRate - sampleRate) > sampleRate * SAMPLE_RATE_TOLERANCE ||
+         acc.decimation != decimation)) {
+        ok = writeVibrationRow(acc.roundId, channelId, acc.startTimestampUs,
+                               acc.sampleRate, acc.numSamples, acc.data, acc.quantStep, acc.decimation);
+        acc.numSamples = 0;
+        acc.data.clear();
+    }
+
+    // 整秒块（非流式模式）直接写入，不经过合并缓冲（载荷不拷贝）
+    const int samplesPerWindow = static_cast<int>(sampleRate);
+    if (acc.numSamples == 0 && n >= samplesPerWindow) {
+        const QByteArray blob = QByteArray::fromRawData(reinterpret_cast<const char*>(data), bytes);
+        return writeVibrationRow(roundId, channelId, startTimestampUs, sampleRate, n, blob,
+                                 quantStep, decimation) && ok;
+    }
+
+    if (acc.numSamples == 0) {
+        acc.roundId = roundId;
+        acc.windowStartUs = windowStart;
+        acc.startTimestampUs = startTimestampUs;
+        acc.sampleRate = sampleRate;
+        acc.quantStep = quantStep;
+        acc.decimation = decimation;
+        acc.data.reserve(static_cast<int>(sampleRate) * static_cast<int>(sizeof(float)));
+    } else if (acc.quantStep != quantStep) {
+        // 窗口内标定变化：取较细的步长，任一未知则按峰值量化
+        acc.quantStep = (acc.quantStep > 0.0f && quantStep > 0.0f) ? qMin(acc.quantStep, quantStep) : 0.0f;
+    }
+    acc.sampleRate = sampleRate;    // 合并行按最新的采样时钟估计递推
+
+    acc.data.append(reinterpret_cast<const char*>(data), bytes);
+    acc.numSamples += n;
+    acc.lastAppendMs = QDateTime::currentMSecsSinceEpoch();
+
+    // 已凑满一个窗口的数据量，立即写出
+    if (acc.numSamples >= samplesPerWindow) {
+        ok = writeVibrationRow(acc.roundId, channelId, acc.startTimestampUs,
+                               acc.sampleRate, acc.numSamples, acc.data, acc.quantStep, acc.decimation) && ok;
+        acc.numSamples = 0;
+        acc.data.clear();
+    }
+
+    return ok;
+}
+
+bool DbWriter::writeVibrationRow(int roundId, int channelId, qint64 startTimestampUs,
+                                 double sampleRate, int numSamples, const QByteArray &samples,
+                                 float quantStep, int decimation)
 {
     // 获取或创建时间窗口
-    int windowId = getOrCreateWindow(block.roundId, block.startTimestampUs);
+    int windowId = getOrCreateWindow(roundId, startTimestampUs);
     if (windowId < 0) {
         return false;
     }
@@ -753,8 +1911,8 @@ bool DbWriter::writeVibrationData(const DataBlock &block)
     double sum = 0.0;
     double sumSq = 0.0;
 
-    const float *data = reinterpret_cast<const float*>(block.blobData.constData());
-    int n = block.numSamples;
+    const float *data = reinterpret_cast<const float*>(samples.constData());
+    int n = numSamples;
 
     for (int i = 0; i < n; ++i) {
         float val = data[i];
@@ -767,38 +1925,249 @@ bool DbWriter::writeVibrationData(const DataBlock &block)
     double mean = (n > 0) ? (sum / n) : 0.0;
     double rms = (n > 0) ? qSqrt(sumSq / n) : 0.0;
 
+    const bool envelope = decimation > 1;
+
+    // 量化 + 差分 + 位打包（统计特征仍按原始样本计算）
+    const QByteArray blob = VibrationCodec::encode(data, n, quantStep);
+
+    // 段文件存储：BLOB追加到段文件，行中只记录位置
+    qint64 segmentId = -1;
+    qint64 segmentOffset = -1;
+    if (m_storagePolicy.vibrationSegments() &&
+        !appendVibrationSegment(roundId, blob, &segmentId, &segmentOffset)) {
+        return false;
+    }
+    const bool inSegment = segmentId >= 0;
+
     // 写入数据库
-    QSqlQuery query(m_db);
-    query.prepare(
-        "INSERT INTO vibration_blocks "
-        "(round_id, window_id, channel_id, start_ts_us, sample_rate, "
-        "n_samples, data_blob, min_value, max_value, mean_value, rms_value) "
-        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"
-    );
-
-    query.addBindValue(block.roundId);
+    QSqlQuery &query = statement(StmtInsertVibration);
+
+    query.addBindValue(roundId);
     query.addBindValue(windowId);
-    query.addBindValue(block.channelId);
-    query.addBindValue(block.startTimestampUs);
-    query.addBindValue(block.sampleRate);
+    query.addBindValue(channelId);
+    query.addBindValue(startTimestampUs);
+    query.addBindValue(sampleRate);
     query.addBindValue(n);
-    query.addBindValue(block.blobData);
+    query.addBindValue(inSegment ? QByteArray("") : blob);    // 空BLOB满足NOT NULL
     query.addBindValue(minVal);
     query.addBindValue(maxVal);
-    query.addBindValue(mean);
-    query.addBindValue(rms);
+    // 包络对的min/max即原始min/max，均值和RMS不成立（见同窗口的Vibration_Summary）
+    query.addBindValue(envelope ? QVariant(QVariant::Double) : QVariant(mean));
+    query.addBindValue(envelope ? QVariant(QVariant::Double) : QVariant(rms));
+    query.addBindValue(inSegment ? QVariant(segmentId) : QVariant(QVariant::LongLong));
+    query.addBindValue(inSegment ? QVariant(segmentOffset) : QVariant(QVariant::LongLong));
+    query.addBindValue(inSegment ? QVariant(blob.size()) : QVariant(QVariant::Int));
+    query.addBindValue(decimation);
 
     if (!query.exec()) {
         qWarning() << "Failed to write vibration data:" << query.lastError().text();
         return false;
     }
 
+    // 行写入成功后才进入降采样金字塔（按原始样本计算）；包络对不是样本，不进入金字塔（该区间在金字塔中为空桶）
+    if (!envelope && !addToPyramid(roundId, channelId, startTimestampUs, sampleRate, data, n)) {
+        return false;
+    }
+
+    m_vibrationRawBytes += samples.size();
+    m_vibrationBlobBytes += blob.size();
+
     // 更新窗口状态
-    updateWindowStatus(windowId, "vibration");
+    markWindow(windowId, WindowHasVibration);
+
+    return true;
+}
+
+bool DbWriter::flushAccumulators(bool force)
+{
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+
+    QList<int> pending;
+    for (auto it = m_vibrationAccumulators.constBegin(); it != m_vibrationAccumulators.constEnd(); ++it) {
+        if (it->numSamples > 0 &&
+            (force || nowMs - it->lastAppendMs >= m_accumulatorFlushTimeoutMs)) {
+            pending.append(it.key());
+        }
+    }
+
+    QList<quint64> pendingScalars;
+    for (auto it = m_scalarAccumulators.constBegin(); it != m_scalarAccumulators.constEnd(); ++it) {
+        if (!it->values.isEmpty() &&
+            (force || nowMs - it->lastAppendMs >= m_accumulatorFlushTimeoutMs)) {
+            pendingScalars.append(it.key());
+        }
+    }
+
+    QList<int> pendingPyramids;
+    for (auto it = m_pyramids.constBegin(); it != m_pyramids.constEnd(); ++it) {
+        if (it->pyramid.hasPending() &&
+            (force || nowMs - it->lastAppendMs >= m_accumulatorFlushTimeoutMs)) {
+            pendingPyramids.append(it.key());
+        }
+    }
+
+    if ((pending.isEmpty() && pendingScalars.isEmpty() && pendingPyramids.isEmpty()) || !m_db.isOpen()) {
+        return true;
+    }
+
+    if (!m_db.transaction()) {
+        emit errorOccurred("Failed to start transaction: " + m_db.lastError().text());
+        return false;
+    }
+
+    // 累加器在提交成功后才清空：提交失败时回滚，数据留待下次刷新重试。
+    // 金字塔同理，失败时恢复到写入前的状态，避免重试时重复计入
+    const QMap<int, PyramidState> pyramidsBefore = m_pyramids;
+
+    bool ok = true;
+    for (int channelId : pending) {
+        const VibrationAccumulator &acc = m_vibrationAccumulators[channelId];
+        ok = writeVibrationRow(acc.roundId, channelId, acc.startTimestampUs,
+                               acc.sampleRate, acc.numSamples, acc.data, acc.quantStep, acc.decimation) && ok;
+    }
+    for (quint64 key : pendingScalars) {
+        ScalarAccumulator acc = m_scalarAccumulators.value(key);    // 副本（隐式共享），写出时清空的是副本
+        ok = writeScalarBlock(static_cast<int>(key >> 32), static_cast<int>(static_cast<quint32>(key)), acc) && ok;
+    }
+
+    // 振动行写出后金字塔可能又有新的未满行，写出后再取一次
+    for (auto it = m_pyramids.begin(); it != m_pyramids.end(); ++it) {
+        if (pending.contains(it.key()) || pendingPyramids.contains(it.key())) {
+            QVector<VibrationPyramid::Row> rows;
+            it->pyramid.takePending(rows);
+            ok = writePyramidRows(it->roundId, it.key(), rows) && ok;
+        }
+    }
+    flushWindowFlags();
+
+    if (!flushSegments() || !m_db.commit()) {
+        m_db.rollback();
+        m_segmentWriter.close();
+        m_pyramids = pyramidsBefore;
+        emit errorOccurred("Failed to commit transaction: " + m_db.lastError().text());
+        return false;
+    }
+
+    for (int channelId : pending) {
+        VibrationAccumulator &acc = m_vibrationAccumulators[channelId];
+        acc.numSamples = 0;
+        acc.data.clear();
+    }
+    for (quint64 key : pendingScalars) {
+        // resize(0)保留容量，下一窗口不再分配
+        ScalarAccumulator &acc = m_scalarAccumulators[key];
+        acc.timestamps.resize(0);
+        acc.values.resize(0);
+    }
+
+    return ok;
+}
+
+bool DbWriter::addToPyramid(int roundId, int channelId, qint64 startTimestampUs,
+                            double sampleRate, const float *data, int n)
+{
+    PyramidState &state = m_pyramids[channelId];
+    bool ok = true;
+
+    // 轮次变化：上一轮次未满的行按当前内容写出
+    if (state.roundId != roundId) {
+        QVector<VibrationPyramid::Row> rows;
+        state.pyramid.takePending(rows);
+        ok = writePyramidRows(state.roundId, channelId, rows);
+        state.pyramid.clear();
+        state.roundId = roundId;
+    }
+
+    QVector<VibrationPyramid::Row> completed;
+    state.pyramid.add(startTimestampUs, sampleRate, data, n, completed);
+    state.lastAppendMs = QDateTime::currentMSecsSinceEpoch();
+    return writePyramidRows(roundId, channelId, completed) && ok;
+}
+
+bool DbWriter::writePyramidRows(int roundId, int channelId, const QVector<VibrationPyramid::Row> &rows)
+{
+    for (const VibrationPyramid::Row &row : rows) {
+        QSqlQuery &query = statement(StmtReplacePyramid);
+        query.addBindValue(roundId);
+        query.addBindValue(channelId);
+        query.addBindValue(VibrationPyramid::levelUs(row.level));
+        query.addBindValue(row.startUs);
+        query.addBindValue(VibrationPyramid::BUCKETS_PER_ROW);
+        query.addBindValue(row.blob);
+
+        if (!query.exec()) {
+            qWarning() << "Failed to write vibration pyramid:" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
 
+bool DbWriter::appendVibrationSegment(int roundId, const QByteArray &blob,
+                                      qint64 *segmentId, qint64 *offset)
+{
+    // 新轮次或当前段已满：登记新段（登记行与引用它的振动行在同一事务中提交）
+    if (!m_segmentWriter.isOpen() || m_segmentWriter.roundId() != roundId ||
+        m_segmentWriter.size() >= m_storagePolicy.segmentBytes) {
+        if (!flushSegments()) {
+            return false;
+        }
+        m_segmentWriter.close();
+
+        QSqlQuery &query = statement(StmtInsertSegment);
+        query.addBindValue(roundId);
+        if (!query.exec()) {
+            qWarning() << "Failed to register vibration segment:" << query.lastError().text();
+            return false;
+        }
+
+        QString error;
+        if (!m_segmentWriter.open(VibrationSegmentWriter::directoryFor(m_dbPath), roundId,
+                                  query.lastInsertId().toLongLong(), &error)) {
+            emit errorOccurred(error);
+            return false;
+        }
+    }
+
+    *offset = m_segmentWriter.append(blob);
+    if (*offset < 0) {
+        return false;
+    }
+    *segmentId = m_segmentWriter.segmentId();
     return true;
 }
 
+bool DbWriter::flushSegments()
+{
+    // crash-safe档位同步到磁盘，与synchronous=FULL的提交保证一致
+    return m_segmentWriter.flush(m_storagePolicy.durability == DbStoragePolicy::Durability::CrashSafe);
+}
+
+QStringList DbWriter::segmentFiles(const QString &roundCondition, int roundId)
+{
+    QStringList files;
+    QSqlQuery query(m_db);
+    query.prepare("SELECT round_id, segment_id FROM vibration_segments WHERE round_id " + roundCondition + " ?");
+    query.addBindValue(roundId);
+    if (query.exec()) {
+        while (query.next()) {
+            files << VibrationSegmentWriter::fileName(query.value(0).toInt(), query.value(1).toLongLong());
+        }
+    }
+    return files;
+}
+
+void DbWriter::removeSegmentFiles(const QStringList &fileNames)
+{
+    // 尽力删除：读取端仍映射着文件时（Windows）删除失败，只留下不再被引用的文件
+    const QDir dir(VibrationSegmentWriter::directoryFor(m_dbPath));
+    for (const QString &fileName : fileNames) {
+        if (dir.exists(fileName) && !dir.remove(fileName)) {
+            qWarning() << "Cannot remove vibration segment file:" << dir.filePath(fileName);
+        }
+    }
+}
+
 qint64 DbWriter::getCurrentTimestampUs()
 {
     // 返回当前时间的微秒级时间戳
@@ -822,23 +2191,22 @@ int DbWriter::getOrCreateWindow(int roundId, qint64 timestampUs)
         return m_windowCache[cacheKey];
     }
 
-    // 查询数据库
-    QSqlQuery query(m_db);
-    query.prepare("SELECT window_id FROM time_windows "
-                  "WHERE round_id = ? AND window_start_us = ?");
-    query.addBindValue(roundId);
-    query.addBindValue(windowStart);
+    // 查询数据库（读完立即finish，避免未结束的读语句阻塞提交）
+    QSqlQuery &select = statement(StmtSelectWindow);
+    select.addBindValue(roundId);
+    select.addBindValue(windowStart);
 
-    if (query.exec() && query.next()) {
-        int windowId = query.value(0).toInt();
+    if (select.exec() && select.next()) {
+        int windowId = select.value(0).toInt();
+        select.finish();
         m_windowCache[cacheKey] = windowId;
+        m_windowStates[windowId].roundId = roundId;
         return windowId;
     }
+    select.finish();
 
     // 创建新窗口
-    query.prepare("INSERT INTO time_windows "
-                  "(round_id, window_start_us, window_end_us) "
-                  "VALUES (?, ?, ?)");
+    QSqlQuery &query = statement(StmtInsertWindow);
     query.addBindValue(roundId);
     query.addBindValue(windowStart);
     query.addBindValue(windowEnd);
@@ -850,43 +2218,64 @@ int DbWriter::getOrCreateWindow(int roundId, qint64 timestampUs)
 
     int windowId = query.lastInsertId().toInt();
     m_windowCache[cacheKey] = windowId;
+    m_windowStates[windowId].roundId = roundId;
 
     // 缓存大小控制
     if (m_windowCache.size() > m_maxCacheSize) {
-        // 移除最旧的条目
+        // 移除最旧的条目（窗口已关闭：先写出其未写的标志）
+        const int evictedId = m_windowCache.begin().value();
         m_windowCache.erase(m_windowCache.begin());
+        if (m_windowStates.value(evictedId).pendingFlags != 0) {
+            flushWindowFlags();
+        }
+        m_windowStates.remove(evictedId);
     }
 
     return windowId;
 }
 
-void DbWriter::updateWindowStatus(int windowId, const QString &dataType)
+void DbWriter::markWindow(int windowId, quint8 flag)
 {
-    // 简洁实现：只更新对应的标志
-    QString field;
-    if (dataType == "vibration") {
-        field = "has_vibration";
-    } else if (dataType == "mdb") {
-        field = "has_mdb";
-    } else if (dataType == "motor") {
-        field = "has_motor";
-    } else {
-        return;
+    // 已设置的标志不再写库；新增标志留到批提交前统一写出
+    WindowState &state = m_windowStates[windowId];
+    if ((state.flags & flag) == 0) {
+        state.flags |= flag;
+        state.pendingFlags |= flag;
     }
+}
 
-    QSqlQuery query(m_db);
-    QString sql = QString("UPDATE time_windows SET %1 = 1 WHERE window_id = ?").arg(field);
-    query.prepare(sql);
-    query.addBindValue(windowId);
+bool DbWriter::flushWindowFlags()
+{
+    bool ok = true;
+    for (auto it = m_windowStates.begin(); it != m_windowStates.end(); ++it) {
+        WindowState &state = it.value();
+        if (state.pendingFlags == 0) {
+            continue;
+        }
 
-    if (!query.exec()) {
-        qWarning() << "Failed to update window status:" << query.lastError().text();
+        QSqlQuery &query = statement(StmtUpdateWindowFlags);
+        query.addBindValue((state.pendingFlags & WindowHasVibration) ? 1 : 0);
+        query.addBindValue((state.pendingFlags & WindowHasMdb) ? 1 : 0);
+        query.addBindValue((state.pendingFlags & WindowHasMotor) ? 1 : 0);
+        query.addBindValue(it.key());
+
+        if (!query.exec()) {
+            qWarning() << "Failed to update window status:" << query.lastError().text();
+            state.flags &= ~state.pendingFlags;     // 下次写入该类型时重试
+            ok = false;
+        } else {
+            m_windowFlagUpdates++;
+        }
+        state.pendingFlags = 0;
     }
+    return ok;
 }
 
 void DbWriter::clearWindowCache()
 {
+    flushWindowFlags();
     m_windowCache.clear();
+    m_windowStates.clear();
 }
 
 void DbWriter::markAbnormalRounds()
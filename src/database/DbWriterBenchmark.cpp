@@ -0,0 +1,204 @@
+// DbWriter写入基准（--bench-db），仅在 qmake CONFIG+=bench 时编入
+#include "database/DbWriter.h"
+#include "Logger.h"
+#include <QSqlDatabase>
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QtMath>
+
+namespace {
+/**
+ * @brief 基准用合成轮次：每秒10个振动打包块（3通道×500样本）、4路MDB×10Hz、电机快照×10Hz（4电机）
+ * @param includeVibration false时只生成标量流（测量标量行吞吐）
+ */
+QVector<DataBlock> makeBenchmarkRound(int seconds, bool includeVibration)
+{
+    const int vibSamples = 500;
+    QByteArray vibPayload(3 * vibSamples * static_cast<int>(sizeof(float)), Qt::Uninitialized);
+    float *vib = reinterpret_cast<float*>(vibPayload.data());
+    for (int i = 0; i < 3 * vibSamples; ++i) {
+        vib[i] = static_cast<float>(qSin(i * 0.05) * 0.5);
+    }
+
+    const SensorType mdbTypes[4] = {SensorType::Force_Upper, SensorType::Force_Lower,
+                                    SensorType::Torque_MDB, SensorType::Position_MDB};
+    const qint64 originUs = QDateTime::currentMSecsSinceEpoch() / 1000 * 1000000;
+
+    QVector<DataBlock> blocks;
+    blocks.reserve(seconds * 60);
+    for (int tick = 0; tick < seconds * 10; ++tick) {
+        const qint64 timestampUs = originUs + tick * 100000LL;
+
+        if (includeVibration) {
+            DataBlock vibration;
+            vibration.sensorType = SensorType::Vibration_Packed;
+            vibration.startTimestampUs = timestampUs;
+            vibration.sampleRate = 5000.0;
+            vibration.numSamples = vibSamples;
+            vibration.channelCount = 3;
+            vibration.blobData = vibPayload;
+            vibration.quantStep = 10.0f / (1 << 23);     // 默认标定下的ADC 1 LSB（g）
+            blocks.append(vibration);
+        }
+
+        for (int i = 0; i < 4; ++i) {
+            DataBlock mdb;
+            mdb.sensorType = mdbTypes[i];
+            mdb.startTimestampUs = timestampUs;
+            mdb.sampleRate = 10.0;
+            mdb.numSamples = 1;
+            mdb.values.append(100.0 * i + tick % 50);
+            blocks.append(mdb);
+        }
+
+        DataBlock motor;
+        motor.sensorType = SensorType::Motor_Snapshot;
+        motor.startTimestampUs = timestampUs;
+        motor.sampleRate = 10.0;
+        motor.numSamples = 1;
+        motor.channelCount = 4;
+        for (int i = 0; i < MotorSnapshot::ParamCount * 4; ++i) {
+            motor.values.append(tick * 0.01 + i);
+        }
+        blocks.append(motor);
+    }
+    return blocks;
+}
+} // namespace
+
+QVector<DbWriter::BenchmarkResult> DbWriter::runBenchmark(int seconds, bool includeVibration)
+{
+    QVector<BenchmarkResult> results;
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        qWarning() << "DbWriter benchmark: cannot create temporary directory";
+        return results;
+    }
+
+    const QVector<DataBlock> blocks = makeBenchmarkRound(qMax(1, seconds), includeVibration);
+
+    const BenchmarkMode modes[5] = {BenchmarkMode::PerCallPrepare, BenchmarkMode::CachedStatements,
+                                    BenchmarkMode::BulkScalar, BenchmarkMode::ScalarBlocks,
+                                    BenchmarkMode::Segments};
+    for (BenchmarkMode mode : modes) {
+        {
+            DbWriter writer(dir.filePath(benchmarkModeName(mode) + ".db"));
+            writer.m_cacheStatements = (mode != BenchmarkMode::PerCallPrepare);
+            writer.m_storagePolicy.scalarStorage =
+                (mode == BenchmarkMode::ScalarBlocks || mode == BenchmarkMode::Segments)
+                ? DbStoragePolicy::ScalarStorage::Blocks : DbStoragePolicy::ScalarStorage::Rows;
+            if (mode == BenchmarkMode::Segments) {
+                writer.m_storagePolicy.vibrationStorage = DbStoragePolicy::VibrationStorage::Segments;
+            }
+            writer.m_bulkScalarInserts = (mode == BenchmarkMode::BulkScalar);
+            if (!writer.initialize()) {
+                qWarning() << "DbWriter benchmark: cannot initialize database";
+                break;
+            }
+            writer.m_batchTimer->stop();    // 同步执行，不依赖事件循环
+            const int roundId = writer.startNewRound("benchmark");
+
+            const qint64 preparesBefore = writer.m_statementPrepares;
+            const qint64 rowsBefore = writer.m_scalarRowsWritten;
+            const qint64 tableRowsBefore = writer.m_scalarTableRows;
+            const qint64 flagUpdatesBefore = writer.m_windowFlagUpdates;
+            const qint64 rawBytesBefore = writer.m_vibrationRawBytes;
+            const qint64 blobBytesBefore = writer.m_vibrationBlobBytes;
+            QElapsedTimer timer;
+            timer.start();
+            for (DataBlock block : blocks) {
+                block.roundId = roundId;
+                writer.enqueueDataBlock(block);
+            }
+            writer.flushQueue();
+            const double elapsedMs = timer.nsecsElapsed() / 1e6;
+
+            BenchmarkResult result;
+            result.mode = mode;
+            result.blocks = blocks.size();
+            result.scalarRows = writer.m_scalarRowsWritten - rowsBefore;
+            result.scalarTableRows = writer.m_scalarTableRows - tableRowsBefore;
+            result.windowFlagUpdates = writer.m_windowFlagUpdates - flagUpdatesBefore;
+            const qint64 blobBytes = writer.m_vibrationBlobBytes - blobBytesBefore;
+            result.vibrationCompression = blobBytes > 0
+                                          ? static_cast<double>(writer.m_vibrationRawBytes - rawBytesBefore) / blobBytes
+                                          : 0.0;
+            result.prepares = writer.m_statementPrepares - preparesBefore;
+            result.elapsedMs = elapsedMs;
+            result.blocksPerSecond = elapsedMs > 0 ? blocks.size() * 1000.0 / elapsedMs : 0.0;
+            result.scalarRowsPerSecond = elapsedMs > 0 ? result.scalarRows * 1000.0 / elapsedMs : 0.0;
+            results.append(result);
+
+            writer.endCurrentRound();
+            writer.shutdown();
+        }
+        QSqlDatabase::removeDatabase(connectionName());
+    }
+
+    return results;
+}
+
+void DbWriter::logBenchmark(int seconds)
+{
+    for (bool includeVibration : {true, false}) {
+        LOG_INFO_STREAM("DbWriter") << "Write benchmark," << seconds << "s synthetic round"
+                                    << (includeVibration ? "(vibration 3ch 5kHz + 4 MDB + motor snapshot)"
+                                                         : "(scalar only: 4 MDB + motor snapshot)");
+        logBenchmarkResults(runBenchmark(seconds, includeVibration));
+    }
+}
+
+void DbWriter::logBenchmarkResults(const QVector<BenchmarkResult> &results)
+{
+    for (const BenchmarkResult &r : results) {
+        LOG_INFO_STREAM("DbWriter")
+            << QString("%1  %2 blocks  %3 scalar samples in %4 rows  %5 window updates  %6 prepares  %7 ms  %8 blocks/s  %9 samples/s  vib %10x")
+                   .arg(benchmarkModeName(r.mode), -8)
+                   .arg(r.blocks)
+                   .arg(r.scalarRows)
+                   .arg(r.scalarTableRows)
+                   .arg(r.windowFlagUpdates)
+                   .arg(r.prepares, 6)
+                   .arg(r.elapsedMs, 8, 'f', 1)
+                   .arg(r.blocksPerSecond, 8, 'f', 0)
+                   .arg(r.scalarRowsPerSecond, 9, 'f', 0)
+                   .arg(r.vibrationCompression, 0, 'f', 2);
+    }
+
+    if (results.size() == 5 && results[0].blocksPerSecond > 0 && results[1].blocksPerSecond > 0) {
+        LOG_INFO_STREAM("DbWriter") << "Cached statement speedup:"
+                                    << QString::number(results[1].blocksPerSecond / results[0].blocksPerSecond, 'f', 2) << "x,"
+                                    << "bulk scalar speedup:"
+                                    << QString::number(results[2].blocksPerSecond / results[1].blocksPerSecond, 'f', 2) << "x"
+                                    << "(rows/s vs per-call:"
+                                    << QString::number(results[0].scalarRowsPerSecond > 0
+                                                       ? results[2].scalarRowsPerSecond / results[0].scalarRowsPerSecond : 0.0,
+                                                       'f', 1) << "x)";
+        LOG_INFO_STREAM("DbWriter") << "Scalar blocks vs bulk rows:"
+                                    << QString::number(results[2].scalarRowsPerSecond > 0
+                                                       ? results[3].scalarRowsPerSecond / results[2].scalarRowsPerSecond : 0.0,
+                                                       'f', 2) << "x samples/s,"
+                                    << QString::number(results[3].scalarTableRows > 0
+                                                       ? static_cast<double>(results[2].scalarTableRows) / results[3].scalarTableRows : 0.0,
+                                                       'f', 0) << "x fewer rows";
+        LOG_INFO_STREAM("DbWriter") << "Segment files vs SQLite BLOBs:"
+                                    << QString::number(results[3].blocksPerSecond > 0
+                                                       ? results[4].blocksPerSecond / results[3].blocksPerSecond : 0.0,
+                                                       'f', 2) << "x blocks/s";
+    }
+}
+
+QString DbWriter::benchmarkModeName(BenchmarkMode mode)
+{
+    switch (mode) {
+    case BenchmarkMode::PerCallPrepare: return "per-call";
+    case BenchmarkMode::CachedStatements: return "cached";
+    case BenchmarkMode::BulkScalar: return "bulk";
+    case BenchmarkMode::ScalarBlocks: return "blocks";
+    case BenchmarkMode::Segments: return "segments";
+    }
+    return "unknown";
+}
@@ -0,0 +1,54 @@
+#include "database/ScalarBlockCodec.h"
+#include <QtEndian>
+#include <cstring>
+
+QByteArray ScalarBlockCodec::packTimestamps(const QVector<qint64> &timestamps, qint64 startUs)
+{
+    QByteArray blob(timestamps.size() * static_cast<int>(sizeof(qint32)), Qt::Uninitialized);
+    uchar *p = reinterpret_cast<uchar*>(blob.data());
+    for (int i = 0; i < timestamps.size(); ++i) {
+        qToLittleEndian<qint32>(static_cast<qint32>(timestamps[i] - startUs), p + i * sizeof(qint32));
+    }
+    return blob;
+}
+
+QByteArray ScalarBlockCodec::packValues(const QVector<double> &values)
+{
+    QByteArray blob(values.size() * static_cast<int>(sizeof(double)), Qt::Uninitialized);
+    uchar *p = reinterpret_cast<uchar*>(blob.data());
+    for (int i = 0; i < values.size(); ++i) {
+        quint64 bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        qToLittleEndian<quint64>(bits, p + i * sizeof(double));
+    }
+    return blob;
+}
+
+bool ScalarBlockCodec::unpack(const QByteArray &timestampBlob, const QByteArray &valueBlob,
+                              qint64 startUs, int n, QVector<qint64> *timestamps, QVector<double> &values)
+{
+    if (n < 0 ||
+        timestampBlob.size() != n * static_cast<int>(sizeof(qint32)) ||
+        valueBlob.size() != n * static_cast<int>(sizeof(double))) {
+        return false;
+    }
+
+    const uchar *ts = reinterpret_cast<const uchar*>(timestampBlob.constData());
+    const uchar *v = reinterpret_cast<const uchar*>(valueBlob.constData());
+
+    if (timestamps) {
+        timestamps->reserve(timestamps->size() + n);
+        for (int i = 0; i < n; ++i) {
+            timestamps->append(startUs + qFromLittleEndian<qint32>(ts + i * sizeof(qint32)));
+        }
+    }
+
+    values.reserve(values.size() + n);
+    for (int i = 0; i < n; ++i) {
+        const quint64 bits = qFromLittleEndian<quint64>(v + i * sizeof(double));
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        values.append(value);
+    }
+    return true;
+}
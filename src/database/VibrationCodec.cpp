@@ -0,0 +1,345 @@
+#include "database/VibrationCodec.h"
+#include <QtEndian>
+#include <QtAlgorithms>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VIBRATION_CODEC_X86 1
+#include <emmintrin.h>
+#endif
+
+// GCC/Clang需要为单个函数开启指令集；MSVC可直接使用intrinsics
+#if defined(VIBRATION_CODEC_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CODEC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CODEC_TARGET(isa)
+#endif
+
+namespace {
+
+const char MAGIC[3] = {'V', 'B', 'C'};
+constexpr int TAIL_PADDING = 8;     // 解码按8字节整字读取位流
+
+struct Header {
+    quint8 codec = VibrationCodec::Float32;
+    int numSamples = 0;
+    float step = 0.0f;
+    qint32 first = 0;
+};
+
+int groupBytes(int count, int width)
+{
+    return (count * width + 7) / 8;
+}
+
+/**
+ * @brief 解析并校验头部；魔数不符或与载荷长度矛盾时返回false（按旧格式处理）
+ */
+bool parseHeader(const QByteArray &blob, Header &header)
+{
+    if (blob.size() < VibrationCodec::HEADER_SIZE || memcmp(blob.constData(), MAGIC, 3) != 0) {
+        return false;
+    }
+
+    const uchar *p = reinterpret_cast<const uchar*>(blob.constData());
+    header.codec = p[3];
+    header.numSamples = qFromLittleEndian<qint32>(p + 4);
+    const quint32 stepBits = qFromLittleEndian<quint32>(p + 8);
+    memcpy(&header.step, &stepBits, sizeof(float));
+    header.first = qFromLittleEndian<qint32>(p + 12);
+
+    if (header.numSamples < 0) {
+        return false;
+    }
+
+    const qint64 payload = blob.size() - VibrationCodec::HEADER_SIZE;
+    switch (header.codec) {
+    case VibrationCodec::Float32:
+        return payload == static_cast<qint64>(header.numSamples) * static_cast<qint64>(sizeof(float));
+    case VibrationCodec::QuantDelta: {
+        // 每组至少1字节位宽，末尾8字节填充
+        const qint64 groups = (qMax(0, header.numSamples - 1) + VibrationCodec::GROUP_SIZE - 1)
+                              / VibrationCodec::GROUP_SIZE;
+        return std::isfinite(header.step) && header.step > 0.0f && payload >= groups + TAIL_PADDING;
+    }
+    default:
+        return false;
+    }
+}
+
+void writeHeader(QByteArray &blob, quint8 codec, int numSamples, float step, qint32 first)
+{
+    blob.resize(VibrationCodec::HEADER_SIZE);
+    uchar *p = reinterpret_cast<uchar*>(blob.data());
+    memcpy(p, MAGIC, 3);
+    p[3] = codec;
+    qToLittleEndian<qint32>(numSamples, p + 4);
+    quint32 stepBits = 0;
+    memcpy(&stepBits, &step, sizeof(float));
+    qToLittleEndian<quint32>(stepBits, p + 8);
+    qToLittleEndian<qint32>(first, p + 12);
+}
+
+QByteArray encodeFloat32(const float *data, int n)
+{
+    QByteArray blob;
+    writeHeader(blob, VibrationCodec::Float32, n, 0.0f, 0);
+    blob.append(reinterpret_cast<const char*>(data), n * static_cast<int>(sizeof(float)));
+    return blob;
+}
+
+void packGroup(const quint32 *zigzag, int count, int width, QByteArray &blob)
+{
+    blob.append(static_cast<char>(width));
+    if (width == 0) {
+        return;
+    }
+
+    const int offset = blob.size();
+    blob.append(groupBytes(count, width), '\0');
+    uchar *dst = reinterpret_cast<uchar*>(blob.data()) + offset;
+
+    quint64 acc = 0;
+    int bits = 0;
+    for (int i = 0; i < count; ++i) {
+        acc |= static_cast<quint64>(zigzag[i]) << bits;
+        bits += width;
+        while (bits >= 8) {
+            *dst++ = static_cast<uchar>(acc);
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0) {
+        *dst = static_cast<uchar>(acc);
+    }
+}
+
+/**
+ * @brief 解包一组位宽为width的值（width ≤ 32，src之后至少有8字节可读）
+ */
+void unpackGroup(const uchar *src, int count, int width, quint32 *out)
+{
+    if (width == 0) {
+        memset(out, 0, count * sizeof(quint32));
+        return;
+    }
+
+    const quint64 mask = (static_cast<quint64>(1) << width) - 1;
+    for (int i = 0; i < count; ++i) {
+        const qint64 bit = static_cast<qint64>(i) * width;
+        quint64 word;
+        memcpy(&word, src + (bit >> 3), sizeof(word));
+        out[i] = static_cast<quint32>((qFromLittleEndian(word) >> (bit & 7)) & mask);
+    }
+}
+
+/**
+ * @brief zigzag还原 + 前缀和 + 乘步长，返回最后一个量化值
+ */
+qint32 restoreScalar(const quint32 *zigzag, int count, qint32 previous, float step, float *out)
+{
+    quint32 value = static_cast<quint32>(previous);
+    for (int i = 0; i < count; ++i) {
+        value += (zigzag[i] >> 1) ^ (0u - (zigzag[i] & 1u));
+        out[i] = static_cast<float>(static_cast<qint32>(value)) * step;
+    }
+    return static_cast<qint32>(value);
+}
+
+#if defined(VIBRATION_CODEC_X86)
+
+CODEC_TARGET("sse2")
+qint32 restoreSse2(const quint32 *zigzag, int count, qint32 previous, float step, float *out)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(step);
+    __m128i carry = _mm_set1_epi32(previous);
+
+    int i = 0;
+    // 每次4个：寄存器内两步移位相加完成前缀和，再加上一组的末值
+    for (; i + 4 <= count; i += 4) {
+        const __m128i z = _mm_loadu_si128(reinterpret_cast<const __m128i*>(zigzag + i));
+        __m128i d = _mm_xor_si128(_mm_srli_epi32(z, 1), _mm_sub_epi32(zero, _mm_and_si128(z, one)));
+        d = _mm_add_epi32(d, _mm_slli_si128(d, 4));
+        d = _mm_add_epi32(d, _mm_slli_si128(d, 8));
+        d = _mm_add_epi32(d, carry);
+        carry = _mm_shuffle_epi32(d, _MM_SHUFFLE(3, 3, 3, 3));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(d), scale));
+    }
+
+    previous = _mm_cvtsi128_si32(carry);
+    if (i < count) {
+        previous = restoreScalar(zigzag + i, count - i, previous, step, out + i);
+    }
+    return previous;
+}
+
+#endif // VIBRATION_CODEC_X86
+
+int decodeQuantDelta(bool simd, const QByteArray &blob, const Header &header, float *out)
+{
+    const int n = header.numSamples;
+    if (n == 0) {
+        return 0;
+    }
+
+    const uchar *p = reinterpret_cast<const uchar*>(blob.constData()) + VibrationCodec::HEADER_SIZE;
+    const uchar *end = reinterpret_cast<const uchar*>(blob.constData()) + blob.size();
+
+    out[0] = static_cast<float>(header.first) * header.step;
+    qint32 previous = header.first;
+
+    quint32 zigzag[VibrationCodec::GROUP_SIZE];
+    for (int index = 1; index < n; index += VibrationCodec::GROUP_SIZE) {
+        const int count = qMin(VibrationCodec::GROUP_SIZE, n - index);
+        if (end - p < 1 + TAIL_PADDING) {
+            return -1;
+        }
+        const int width = *p++;
+        const int bytes = groupBytes(count, width);
+        if (width > 32 || end - p < bytes + TAIL_PADDING) {
+            return -1;
+        }
+
+        unpackGroup(p, count, width, zigzag);
+        p += bytes;
+
+#if defined(VIBRATION_CODEC_X86)
+        if (simd) {
+            previous = restoreSse2(zigzag, count, previous, header.step, out + index);
+            continue;
+        }
+#else
+        Q_UNUSED(simd);
+#endif
+        previous = restoreScalar(zigzag, count, previous, header.step, out + index);
+    }
+
+    return end - p == TAIL_PADDING ? n : -1;
+}
+
+} // namespace
+
+QByteArray VibrationCodec::encode(const float *data, int n, float quantStep)
+{
+    if (!data || n <= 0) {
+        return encodeFloat32(data, 0);
+    }
+
+    float peak = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        if (!std::isfinite(data[i])) {
+            return encodeFloat32(data, n);     // NaN/Inf无法量化，原样保存
+        }
+        peak = qMax(peak, std::fabs(data[i]));
+    }
+
+    // 步长不小于峰值的24位分辨率，保证量化值在±2^23内
+    float step = (std::isfinite(quantStep) && quantStep > 0.0f) ? quantStep : 0.0f;
+    step = qMax(step, peak / MAX_CODE);
+    if (step <= 0.0f) {
+        step = 1.0f;                            // 全零
+    }
+
+    const double inverse = 1.0 / step;
+    auto quantize = [inverse](float value) {
+        const long code = std::lround(value * inverse);
+        return static_cast<qint32>(qBound(-static_cast<long>(MAX_CODE) - 1, code, static_cast<long>(MAX_CODE)));
+    };
+
+    QByteArray blob;
+    qint32 previous = quantize(data[0]);
+    writeHeader(blob, QuantDelta, n, step, previous);
+    blob.reserve(HEADER_SIZE + n * 2 + TAIL_PADDING);
+
+    quint32 zigzag[GROUP_SIZE];
+    for (int index = 1; index < n; index += GROUP_SIZE) {
+        const int count = qMin(GROUP_SIZE, n - index);
+        quint32 bits = 0;
+        for (int i = 0; i < count; ++i) {
+            const qint32 code = quantize(data[index + i]);
+            const qint32 delta = code - previous;
+            previous = code;
+            zigzag[i] = (static_cast<quint32>(delta) << 1) ^ static_cast<quint32>(delta >> 31);
+            bits |= zigzag[i];
+        }
+        packGroup(zigzag, count, bits ? 32 - qCountLeadingZeroBits(bits) : 0, blob);
+    }
+
+    blob.append(TAIL_PADDING, '\0');
+    return blob;
+}
+
+int VibrationCodec::sampleCount(const QByteArray &blob)
+{
+    Header header;
+    if (parseHeader(blob, header)) {
+        return header.numSamples;
+    }
+    return blob.size() % static_cast<int>(sizeof(float)) == 0 ? blob.size() / static_cast<int>(sizeof(float)) : -1;
+}
+
+VibrationCodec::Codec VibrationCodec::codecOf(const QByteArray &blob)
+{
+    Header header;
+    return parseHeader(blob, header) ? static_cast<Codec>(header.codec) : Float32;
+}
+
+float VibrationCodec::quantStepOf(const QByteArray &blob)
+{
+    Header header;
+    return parseHeader(blob, header) ? header.step : 0.0f;
+}
+
+int VibrationCodec::decode(const QByteArray &blob, float *out, int capacity)
+{
+    return decode(VibrationKernels::activeIsa(), blob, out, capacity);
+}
+
+int VibrationCodec::decode(VibrationKernels::Isa isa, const QByteArray &blob, float *out, int capacity)
+{
+    if (!VibrationKernels::isSupported(isa)) {
+        return -1;
+    }
+
+    Header header;
+    if (!parseHeader(blob, header)) {
+        // 旧格式：原始float数组
+        const int n = blob.size() / static_cast<int>(sizeof(float));
+        if (n > capacity) {
+            return -1;
+        }
+        memcpy(out, blob.constData(), n * sizeof(float));
+        return n;
+    }
+
+    if (header.numSamples > capacity) {
+        return -1;
+    }
+
+    if (header.codec == Float32) {
+        memcpy(out, blob.constData() + HEADER_SIZE, header.numSamples * sizeof(float));
+        return header.numSamples;
+    }
+    return decodeQuantDelta(isa != VibrationKernels::Isa::Scalar, blob, header, out);
+}
+
+int VibrationCodec::decodeAppend(const QByteArray &blob, QVector<float> &out)
+{
+    const int n = sampleCount(blob);
+    if (n < 0) {
+        return -1;
+    }
+
+    const int offset = out.size();
+    out.resize(offset + n);
+    const int decoded = decode(blob, out.data() + offset, n);
+    if (decoded < 0) {
+        out.resize(offset);
+        return -1;
+    }
+    return decoded;
+}
@@ -0,0 +1,95 @@
+// VibrationCodec编解码微基准（--bench-codec），仅在 qmake CONFIG+=bench 时编入
+#include "database/VibrationCodec.h"
+#include "Logger.h"
+#include <QElapsedTimer>
+#include <cmath>
+
+QVector<VibrationCodec::BenchmarkResult> VibrationCodec::runBenchmark(int minDurationMs)
+{
+    const int rate = 5000;
+    // 默认标定（100mV/g → gain 10）下1V参考电压的24位LSB
+    const float adcStep = 10.0f / (1 << 23);
+
+    struct Signal {
+        QString name;
+        float step;
+        QVector<float> data;
+    };
+    QVector<Signal> inputs(3);
+    inputs[0] = {"vibration 0.05g + noise", adcStep, QVector<float>(rate)};
+    inputs[1] = {"sine 0.5g", adcStep, QVector<float>(rate)};
+    inputs[2] = {"vibration, step unknown", 0.0f, QVector<float>(rate)};
+
+    quint32 seed = 12345;
+    for (int i = 0; i < rate; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const float noise = ((seed >> 8) / 16777216.0f - 0.5f) * 0.004f;
+        const float vibration = 0.05f * std::sin(2.0f * 3.14159265f * 120.0f * i / rate)
+                                + 0.02f * std::sin(2.0f * 3.14159265f * 37.0f * i / rate) + noise;
+        inputs[0].data[i] = std::round(vibration / adcStep) * adcStep;    // 已量化到ADC分辨率
+        inputs[1].data[i] = std::round(0.5f * std::sin(0.05f * i) / adcStep) * adcStep;
+        inputs[2].data[i] = inputs[0].data[i];
+    }
+
+    auto measure = [minDurationMs](auto &&operation) {
+        QElapsedTimer timer;
+        timer.start();
+        qint64 iterations = 0;
+        do {
+            operation();
+            ++iterations;
+        } while (timer.elapsed() < minDurationMs);
+        return static_cast<double>(timer.nsecsElapsed()) / iterations;     // 每次耗时（纳秒）
+    };
+    const double rawBytes = rate * static_cast<double>(sizeof(float));
+    auto throughput = [rawBytes](double ns) { return ns > 0 ? rawBytes / (ns / 1e9) / 1e6 : 0.0; };
+
+    QVector<BenchmarkResult> results;
+    QVector<float> decoded(rate);
+    for (const Signal &signal : inputs) {
+        const QByteArray blob = encode(signal.data.constData(), rate, signal.step);
+
+        BenchmarkResult result;
+        result.signal = signal.name;
+        result.samples = rate;
+        result.compressionRatio = rawBytes / blob.size();
+        result.step = quantStepOf(blob);
+
+        decode(VibrationKernels::Isa::Scalar, blob, decoded.data(), rate);
+        result.maxAbsError = 0.0f;
+        for (int i = 0; i < rate; ++i) {
+            result.maxAbsError = qMax(result.maxAbsError, std::fabs(decoded[i] - signal.data[i]));
+        }
+
+        result.encodeMBps = throughput(measure([&]() {
+            encode(signal.data.constData(), rate, signal.step);
+        }));
+        result.decodeScalarMBps = throughput(measure([&]() {
+            decode(VibrationKernels::Isa::Scalar, blob, decoded.data(), rate);
+        }));
+        result.decodeSimdMBps = 0.0;
+        if (VibrationKernels::isSupported(VibrationKernels::Isa::SSE2)) {
+            result.decodeSimdMBps = throughput(measure([&]() {
+                decode(VibrationKernels::Isa::SSE2, blob, decoded.data(), rate);
+            }));
+        }
+        results.append(result);
+    }
+    return results;
+}
+
+void VibrationCodec::logBenchmark()
+{
+    LOG_INFO_STREAM("VibrationCodec") << "Vibration BLOB codec benchmark (1 s @ 5 kHz per row)";
+    for (const BenchmarkResult &r : runBenchmark()) {
+        LOG_INFO_STREAM("VibrationCodec")
+            << QString("%1  ratio %2x  encode %3 MB/s  decode scalar %4 MB/s  SSE2 %5 MB/s  step %6  err=%7")
+                   .arg(r.signal, -24)
+                   .arg(r.compressionRatio, 0, 'f', 2)
+                   .arg(r.encodeMBps, 7, 'f', 0)
+                   .arg(r.decodeScalarMBps, 7, 'f', 0)
+                   .arg(r.decodeSimdMBps, 7, 'f', 0)
+                   .arg(r.step, 0, 'g', 3)
+                   .arg(r.maxAbsError, 0, 'g', 3);
+    }
+}
@@ -0,0 +1,197 @@
+#include "database/VibrationPyramid.h"
+#include <QtEndian>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+void storeFloat(uchar *p, float value)
+{
+    quint32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    qToLittleEndian<quint32>(bits, p);
+}
+
+float loadFloat(const uchar *p)
+{
+    const quint32 bits = qFromLittleEndian<quint32>(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+} // namespace
+
+qint64 VibrationPyramid::levelUs(int level)
+{
+    qint64 us = 10000;
+    for (int i = 0; i < level; ++i) {
+        us *= 10;
+    }
+    return us;
+}
+
+int VibrationPyramid::coarsestLevel(qint64 bucketUs)
+{
+    int level = 0;
+    while (level + 1 < LEVEL_COUNT && levelUs(level + 1) <= bucketUs) {
+        ++level;
+    }
+    return level;
+}
+
+VibrationPyramid::VibrationPyramid()
+{
+    clear();
+}
+
+void VibrationPyramid::clear()
+{
+    for (LevelState &state : m_levels) {
+        resetRow(state, -1);
+    }
+}
+
+void VibrationPyramid::resetRow(LevelState &state, qint64 rowStartUs)
+{
+    state.rowStartUs = rowStartUs;
+    state.dirty = false;
+    for (Accum &bucket : state.buckets) {
+        bucket.minValue = FLT_MAX;
+        bucket.maxValue = -FLT_MAX;
+        bucket.sum = 0.0;
+        bucket.sumSq = 0.0;
+        bucket.count = 0;
+    }
+}
+
+void VibrationPyramid::add(qint64 startTimestampUs, double sampleRate, const float *data, int n,
+                           QVector<Row> &completed)
+{
+    if (n <= 0 || sampleRate <= 0) {
+        return;
+    }
+
+    const qint64 finestUs = levelUs(0);
+    auto timestampOf = [startTimestampUs, sampleRate](int i) {
+        return startTimestampUs + static_cast<qint64>(i * 1000000.0 / sampleRate);
+    };
+
+    // 按最细层级的桶切分样本：每段在一个10ms桶内，先聚合再并入各层级
+    int i = 0;
+    while (i < n) {
+        const qint64 timestampUs = timestampOf(i);
+        const qint64 bucketEndUs = (timestampUs / finestUs + 1) * finestUs;
+
+        int j = i + qMax(1, static_cast<int>(std::ceil((bucketEndUs - timestampUs) * sampleRate / 1e6)));
+        j = qMin(j, n);
+        while (j > i + 1 && timestampOf(j - 1) >= bucketEndUs) {
+            --j;
+        }
+        while (j < n && timestampOf(j) < bucketEndUs) {
+            ++j;
+        }
+
+        Accum run = {FLT_MAX, -FLT_MAX, 0.0, 0.0, j - i};
+        for (int k = i; k < j; ++k) {
+            const float value = data[k];
+            run.minValue = qMin(run.minValue, value);
+            run.maxValue = qMax(run.maxValue, value);
+            run.sum += value;
+            run.sumSq += static_cast<double>(value) * value;
+        }
+
+        addRun(timestampUs, run, completed);
+        i = j;
+    }
+}
+
+void VibrationPyramid::addRun(qint64 timestampUs, const Accum &run, QVector<Row> &completed)
+{
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        LevelState &state = m_levels[level];
+        const qint64 bucketUs = levelUs(level);
+        const qint64 rowUs = bucketUs * BUCKETS_PER_ROW;
+        const qint64 rowStartUs = (timestampUs / rowUs) * rowUs;
+
+        // 进入新行：上一行已写满（含已取出过的部分），输出后重置
+        if (state.rowStartUs != rowStartUs) {
+            if (state.rowStartUs >= 0 && state.dirty) {
+                completed.append(pack(level, state));
+            }
+            resetRow(state, rowStartUs);
+        }
+
+        Accum &bucket = state.buckets[(timestampUs - rowStartUs) / bucketUs];
+        bucket.minValue = qMin(bucket.minValue, run.minValue);
+        bucket.maxValue = qMax(bucket.maxValue, run.maxValue);
+        bucket.sum += run.sum;
+        bucket.sumSq += run.sumSq;
+        bucket.count += run.count;
+        state.dirty = true;
+    }
+}
+
+void VibrationPyramid::takePending(QVector<Row> &rows)
+{
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        LevelState &state = m_levels[level];
+        if (state.rowStartUs >= 0 && state.dirty) {
+            rows.append(pack(level, state));
+            state.dirty = false;
+        }
+    }
+}
+
+bool VibrationPyramid::hasPending() const
+{
+    for (const LevelState &state : m_levels) {
+        if (state.rowStartUs >= 0 && state.dirty) {
+            return true;
+        }
+    }
+    return false;
+}
+
+VibrationPyramid::Row VibrationPyramid::pack(int level, const LevelState &state)
+{
+    Row row;
+    row.level = level;
+    row.startUs = state.rowStartUs;
+    row.blob = QByteArray(BUCKETS_PER_ROW * BUCKET_BYTES, Qt::Uninitialized);
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    uchar *p = reinterpret_cast<uchar*>(row.blob.data());
+    for (const Accum &bucket : state.buckets) {
+        if (bucket.count > 0) {
+            storeFloat(p, bucket.minValue);
+            storeFloat(p + 4, bucket.maxValue);
+            storeFloat(p + 8, static_cast<float>(bucket.sum / bucket.count));
+            storeFloat(p + 12, static_cast<float>(std::sqrt(bucket.sumSq / bucket.count)));
+        } else {
+            storeFloat(p, nan);
+            storeFloat(p + 4, nan);
+            storeFloat(p + 8, nan);
+            storeFloat(p + 12, nan);
+        }
+        p += BUCKET_BYTES;
+    }
+    return row;
+}
+
+int VibrationPyramid::unpack(const QByteArray &blob, Bucket *out, int capacity)
+{
+    if (blob.size() % BUCKET_BYTES != 0 || blob.size() / BUCKET_BYTES > capacity) {
+        return -1;
+    }
+
+    const int count = blob.size() / BUCKET_BYTES;
+    const uchar *p = reinterpret_cast<const uchar*>(blob.constData());
+    for (int i = 0; i < count; ++i, p += BUCKET_BYTES) {
+        out[i].minValue = loadFloat(p);
+        out[i].maxValue = loadFloat(p + 4);
+        out[i].meanValue = loadFloat(p + 8);
+        out[i].rmsValue = loadFloat(p + 12);
+    }
+    return count;
+}
@@ -0,0 +1,213 @@
+#include "database/VibrationSegments.h"
+#include <QDebug>
+#include <QDir>
+#include <climits>
+#include <fcntl.h>
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// ============================================
+// VibrationSegmentWriter
+// ============================================
+
+QString VibrationSegmentWriter::directoryFor(const QString &dbPath)
+{
+    return dbPath + ".segments";
+}
+
+QString VibrationSegmentWriter::fileName(int roundId, qint64 segmentId)
+{
+    return QString("round%1_%2.vseg").arg(roundId).arg(segmentId);
+}
+
+VibrationSegmentWriter::VibrationSegmentWriter()
+    : m_roundId(0)
+    , m_segmentId(-1)
+    , m_size(0)
+    , m_dirty(false)
+{
+}
+
+VibrationSegmentWriter::~VibrationSegmentWriter()
+{
+    close();
+}
+
+bool VibrationSegmentWriter::open(const QString &directory, int roundId, qint64 segmentId,
+                                  QString *errorMessage)
+{
+    close();
+
+    if (!QDir().mkpath(directory)) {
+        if (errorMessage) {
+            *errorMessage = "Cannot create segment directory " + directory;
+        }
+        return false;
+    }
+
+    // 自己打开文件描述符：QFile::handle()对按名称打开的文件在Windows上不可用，同步时需要fd
+    const QByteArray path = QFile::encodeName(QDir(directory).filePath(fileName(roundId, segmentId)));
+#ifdef Q_OS_WIN
+    const int fd = ::_open(path.constData(), _O_WRONLY | _O_CREAT | _O_BINARY, 0644);
+#else
+    const int fd = ::open(path.constData(), O_WRONLY | O_CREAT, 0644);
+#endif
+    if (fd < 0 || !m_file.open(fd, QIODevice::WriteOnly, QFileDevice::AutoCloseHandle)) {
+        if (fd >= 0) {
+#ifdef Q_OS_WIN
+            ::_close(fd);
+#else
+            ::close(fd);
+#endif
+        }
+        if (errorMessage) {
+            *errorMessage = "Cannot open segment file " + QString::fromLocal8Bit(path);
+        }
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (!m_file.seek(m_size)) {
+        m_file.close();
+        if (errorMessage) {
+            *errorMessage = "Cannot seek segment file " + QString::fromLocal8Bit(path);
+        }
+        return false;
+    }
+
+    m_roundId = roundId;
+    m_segmentId = segmentId;
+    m_dirty = false;
+    return true;
+}
+
+void VibrationSegmentWriter::close()
+{
+    if (m_file.isOpen()) {
+        m_file.flush();
+        m_file.close();
+    }
+    m_roundId = 0;
+    m_segmentId = -1;
+    m_size = 0;
+    m_dirty = false;
+}
+
+qint64 VibrationSegmentWriter::append(const QByteArray &blob)
+{
+    if (!m_file.isOpen()) {
+        return -1;
+    }
+
+    // 起始偏移按ALIGNMENT对齐，读取端映射后可直接按float数组访问
+    const int padding = static_cast<int>((ALIGNMENT - m_size % ALIGNMENT) % ALIGNMENT);
+    if (padding > 0) {
+        static const char zeros[ALIGNMENT] = {};
+        if (m_file.write(zeros, padding) != padding) {
+            qWarning() << "Failed to pad segment file:" << m_file.errorString();
+            return -1;
+        }
+        m_size += padding;
+    }
+
+    const qint64 offset = m_size;
+    if (m_file.write(blob) != blob.size()) {
+        qWarning() << "Failed to append to segment file:" << m_file.errorString();
+        // 部分写入的字节不被引用，从实际文件位置继续
+        m_size = m_file.pos();
+        return -1;
+    }
+
+    m_size += blob.size();
+    m_dirty = true;
+    return offset;
+}
+
+bool VibrationSegmentWriter::flush(bool sync)
+{
+    if (!m_file.isOpen() || !m_dirty) {
+        return true;
+    }
+
+    if (!m_file.flush()) {
+        qWarning() << "Failed to flush segment file:" << m_file.errorString();
+        return false;
+    }
+
+    if (sync) {
+#ifdef Q_OS_WIN
+        const bool synced = ::_commit(m_file.handle()) == 0;
+#else
+        const bool synced = ::fsync(m_file.handle()) == 0;
+#endif
+        if (!synced) {
+            qWarning() << "Failed to sync segment file, segment" << m_segmentId;
+            return false;
+        }
+    }
+
+    m_dirty = false;
+    return true;
+}
+
+// ============================================
+// VibrationSegmentReader
+// ============================================
+
+VibrationSegmentReader::VibrationSegmentReader()
+{
+}
+
+VibrationSegmentReader::~VibrationSegmentReader()
+{
+    release();
+}
+
+QByteArray VibrationSegmentReader::view(const QString &fileName, qint64 offset, qint64 length)
+{
+    if (offset < 0 || length <= 0 || length > INT_MAX) {
+        return QByteArray();
+    }
+
+    Mapping &mapping = m_mappings[fileName];
+    if (!mapping.file) {
+        mapping.file = new QFile(QDir(m_directory).filePath(fileName));
+        if (!mapping.file->open(QIODevice::ReadOnly)) {
+            qWarning() << "Cannot open segment file:" << mapping.file->fileName();
+            delete mapping.file;
+            m_mappings.remove(fileName);
+            return QByteArray();
+        }
+    }
+
+    // 写入端仍在追加：重新映射整个文件（旧映射随文件关闭释放，已返回的视图仍有效）
+    if (offset + length > mapping.size) {
+        const qint64 fileSize = mapping.file->size();
+        if (offset + length > fileSize) {
+            return QByteArray();
+        }
+        const uchar *data = mapping.file->map(0, fileSize);
+        if (!data) {
+            qWarning() << "Cannot map segment file:" << mapping.file->fileName()
+                       << mapping.file->errorString();
+            return QByteArray();
+        }
+        mapping.data = data;
+        mapping.size = fileSize;
+    }
+
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(mapping.data + offset),
+                                   static_cast<int>(length));
+}
+
+void VibrationSegmentReader::release()
+{
+    for (Mapping &mapping : m_mappings) {
+        mapping.file->close();      // 关闭时解除该文件的全部映射
+        delete mapping.file;
+    }
+    m_mappings.clear();
+}
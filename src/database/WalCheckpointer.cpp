@@ -0,0 +1,145 @@
+#include "database/WalCheckpointer.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+
+WalCheckpointer::WalCheckpointer(const QString &dbPath, const DbStoragePolicy &policy, QObject *parent)
+    : QObject(parent)
+    , m_dbPath(dbPath)
+    , m_policy(policy)
+    , m_timer(nullptr)
+    , m_fullyBackfilled(false)
+    , m_lastDurationUs(0)
+    , m_lastWalBytes(0)
+    , m_truncations(0)
+    , m_busyCount(0)
+{
+}
+
+WalCheckpointer::~WalCheckpointer()
+{
+    stop();
+}
+
+qint64 WalCheckpointer::walBytes() const
+{
+    QFileInfo wal(m_dbPath + "-wal");
+    return wal.exists() ? wal.size() : 0;
+}
+
+void WalCheckpointer::start()
+{
+    if (m_db.isOpen()) {
+        return;
+    }
+
+    m_connectionName = QString("WalCheckpointer_%1").arg((qint64)QThread::currentThreadId());
+    m_db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    m_db.setDatabaseName(m_dbPath);
+    // 写入连接正在提交时不等待，下个周期再试
+    m_db.setConnectOptions("QSQLITE_BUSY_TIMEOUT=0");
+
+    if (!m_db.open()) {
+        emit errorOccurred("Failed to open checkpoint connection: " + m_db.lastError().text());
+        return;
+    }
+
+    m_timer = new QTimer(this);
+    m_timer->setInterval(m_policy.checkpointIntervalMs);
+    connect(m_timer, &QTimer::timeout, this, &WalCheckpointer::onTimer);
+    m_timer->start();
+
+    qDebug() << "WAL checkpointer started, interval" << m_policy.checkpointIntervalMs << "ms";
+}
+
+void WalCheckpointer::stop()
+{
+    if (m_timer) {
+        m_timer->stop();
+        delete m_timer;
+        m_timer = nullptr;
+    }
+
+    if (!m_db.isOpen()) {
+        return;
+    }
+
+    // 写入连接已停止，回写剩余帧并截断WAL
+    m_lastWalBytes = walBytes();
+    if (m_lastWalBytes > 0) {
+        checkpoint("TRUNCATE");
+        emit metricsUpdated(summary());
+    }
+
+    m_db.close();
+    m_db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(m_connectionName);
+    qDebug() << "WAL checkpointer stopped." << summary();
+}
+
+void WalCheckpointer::onTimer()
+{
+    m_lastWalBytes = walBytes();
+    if (m_lastWalBytes == 0) {
+        return;
+    }
+
+    // 先PASSIVE回写；已全部回写且WAL过大时才截断（此时TRUNCATE不再拷贝帧）
+    if (m_fullyBackfilled && m_lastWalBytes >= m_policy.walTruncateBytes) {
+        checkpoint("TRUNCATE");
+    } else {
+        checkpoint("PASSIVE");
+    }
+    emit metricsUpdated(summary());
+}
+
+bool WalCheckpointer::checkpoint(const char *mode)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery query(m_db);
+    if (!query.exec(QString("PRAGMA wal_checkpoint(%1)").arg(QLatin1String(mode)))) {
+        emit errorOccurred(QString("WAL checkpoint (%1) failed: %2")
+                           .arg(QLatin1String(mode), query.lastError().text()));
+        return false;
+    }
+
+    // 结果行：busy, WAL总帧数, 已回写帧数
+    bool busy = true;
+    int logFrames = -1;
+    int backfilledFrames = -1;
+    if (query.next()) {
+        busy = query.value(0).toInt() != 0;
+        logFrames = query.value(1).toInt();
+        backfilledFrames = query.value(2).toInt();
+    }
+    query.finish();
+
+    m_lastDurationUs = timer.nsecsElapsed() / 1000;
+    m_durations.record(m_lastDurationUs);
+
+    if (busy) {
+        m_busyCount++;
+    } else if (qstrcmp(mode, "TRUNCATE") == 0) {
+        m_truncations++;
+    }
+
+    m_fullyBackfilled = !busy && logFrames >= 0 && backfilledFrames == logFrames;
+    return m_fullyBackfilled;
+}
+
+QString WalCheckpointer::summary() const
+{
+    return QString("%1 MB, ckpt last %2 p99 %3 max %4 ms, n=%5 truncate %6 busy %7")
+           .arg(m_lastWalBytes / (1024.0 * 1024.0), 0, 'f', 1)
+           .arg(m_lastDurationUs / 1000.0, 0, 'f', 1)
+           .arg(m_durations.percentileUs(99) / 1000.0, 0, 'f', 1)
+           .arg(m_durations.maxUs() / 1000.0, 0, 'f', 1)
+           .arg(m_durations.count())
+           .arg(m_truncations)
+           .arg(m_busyCount);
+}
@@ -1,5 +1,15 @@
 #include "ui/MainWindow.h"
 #include "Logger.h"
+#include "control/AcquisitionManager.h"
+#include "dataACQ/SyntheticWorker.h"
+
+#ifdef DRILLCONTROL_BENCH
+#include "dataACQ/SampleClock.h"
+#include "dataACQ/VibrationKernels.h"
+#include "dataACQ/MotorWorker.h"
+#include "database/DbWriter.h"
+#include "database/VibrationCodec.h"
+#endif
 
 #include <QApplication>
 #include <QDebug>
@@ -44,8 +54,72 @@ int main(int argc, char *argv[])
     LOG_INFO_STREAM("Main") << "启动时间:" << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss");
     LOG_INFO("Main", "==================================");
 
+    const QStringList args = QCoreApplication::arguments();
+
+#ifdef DRILLCONTROL_BENCH
+    // 性能基准模式（qmake CONFIG+=bench）：运行后直接退出，不创建主窗口
+    if (args.contains("--bench-kernels")) {
+        VibrationKernels::logBenchmark();
+        return 0;
+    }
+
+    // 采样时钟漂移校验：模拟晶振漂移，检查按估计采样率递推的逐样本时间（失败时返回1）
+    if (args.contains("--bench-clock")) {
+        return SampleClock::logDriftCheck() ? 0 : 1;
+    }
+
+    // 振动BLOB编解码基准：压缩比 + 编码/标量解码/SSE2解码吞吐
+    if (args.contains("--bench-codec")) {
+        VibrationCodec::logBenchmark();
+        return 0;
+    }
+
+    // 电机参数读取基准：--bench-motor [控制器IP]，需连接真实控制器
+    const int benchMotorIndex = args.indexOf("--bench-motor");
+    if (benchMotorIndex >= 0) {
+        QString address = args.value(benchMotorIndex + 1);
+        if (address.isEmpty() || address.startsWith("--")) {
+            address = "192.168.0.11";
+        }
+        MotorWorker::logBenchmark(address);
+        return 0;
+    }
+
+    // 数据库写入基准：--bench-db [轮次秒数]，写入临时数据库，对比逐次prepare / 语句缓存 / 标量多行插入的吞吐
+    const int benchDbIndex = args.indexOf("--bench-db");
+    if (benchDbIndex >= 0) {
+        bool secondsOk = false;
+        const int seconds = args.value(benchDbIndex + 1).toInt(&secondsOk);
+        DbWriter::logBenchmark(secondsOk && seconds > 0 ? seconds : 60);
+        return 0;
+    }
+#endif
+
     // 创建并显示主窗口
     MainWindow mainWindow;
+
+    // 回放模式：--replay <轮次ID> [倍速，0=尽快]，开始采集时回放该轮次代替硬件采集
+    const int replayIndex = args.indexOf("--replay");
+    if (replayIndex >= 0) {
+        const int roundId = args.value(replayIndex + 1).toInt();
+        bool speedOk = false;
+        const double speed = args.value(replayIndex + 2).toDouble(&speedOk);
+        mainWindow.acquisitionManager()->setReplaySource(roundId, speedOk ? speed : 1.0);
+    }
+
+    // 合成负载模式：--synthetic [采样率Hz] [通道数]，开始采集时由SyntheticWorker生成振动数据
+    const int syntheticIndex = args.indexOf("--synthetic");
+    if (syntheticIndex >= 0) {
+        AcquisitionManager *manager = mainWindow.acquisitionManager();
+        bool rateOk = false;
+        bool channelsOk = false;
+        const double rate = args.value(syntheticIndex + 1).toDouble(&rateOk);
+        const int channels = args.value(syntheticIndex + 2).toInt(&channelsOk);
+        manager->syntheticWorker()->setSampleRate(rateOk ? rate : 5000.0);
+        manager->syntheticWorker()->setChannelCount(channelsOk ? channels : 3);
+        manager->setSyntheticVibration(true);
+    }
+
     mainWindow.show();
 
     LOG_DEBUG("Main", "主窗口已显示");
@@ -824,8 +824,11 @@ void AutoTaskPage::updateSensorIndicators()
         setStatusLabel(ui->lbl_motor_status, "电机", "#909399");
     }
 
-    VibrationWorker* vibrationWorker = m_acquisitionManager->vibrationWorker();
-    if (vibrationWorker && vibrationWorker->isConnected()) {
+    bool vibrationConnected = m_acquisitionManager->vibrationCardCount() > 0;
+    for (VibrationWorker* vibrationWorker : m_acquisitionManager->vibrationWorkers()) {
+        vibrationConnected = vibrationConnected && vibrationWorker->isConnected();
+    }
+    if (vibrationConnected) {
         setStatusLabel(ui->lbl_vk701_status, "● 振动", "#67c23a");
     } else {
         setStatusLabel(ui->lbl_vk701_status, "振动", "#909399");
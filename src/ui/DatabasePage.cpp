@@ -8,6 +8,7 @@
 #include <QDebug>
 #include <QFileDialog>
 #include <QProgressDialog>
+#include <QSet>
 #include <QTextStream>
 #include <QtConcurrent>
 #include <cmath>
@@ -43,7 +44,7 @@ DatabasePage::DatabasePage(QWidget *parent)
     connect(ui->btn_exec_sql, &QPushButton::clicked, this, &DatabasePage::onExecSql);
 
     // 异步查询信号
-    connect(&m_queryWatcher, &QFutureWatcher<QList<DataQuerier::WindowData>>::finished,
+    connect(&m_queryWatcher, &QFutureWatcher<QueryResult>::finished,
             this, &DatabasePage::onQueryFinished);
 
     // 导出按钮
@@ -245,6 +246,34 @@ void DatabasePage::onDeleteRound()
     }
     int deletedScalar = query.numRowsAffected();
 
+    // 迁移保留的原始标量行（scalar_samples_legacy，已计入scalar_blocks，不重复计数）
+    if (db.tables().contains("scalar_samples_legacy")) {
+        query.prepare("DELETE FROM scalar_samples_legacy WHERE round_id = ?");
+        query.addBindValue(roundId);
+        if (!query.exec()) {
+            db.rollback();
+            QMessageBox::critical(this, "错误", "删除标量数据失败：" + query.lastError().text());
+            return;
+        }
+    }
+
+    // 删除打包的标量块（按样本数计入标量样本）
+    if (m_querier->hasScalarBlocks()) {
+        query.prepare("SELECT COALESCE(SUM(n_samples), 0) FROM scalar_blocks WHERE round_id = ?");
+        query.addBindValue(roundId);
+        if (query.exec() && query.next()) {
+            deletedScalar += query.value(0).toInt();
+        }
+
+        query.prepare("DELETE FROM scalar_blocks WHERE round_id = ?");
+        query.addBindValue(roundId);
+        if (!query.exec()) {
+            db.rollback();
+            QMessageBox::critical(this, "错误", "删除标量数据失败：" + query.lastError().text());
+            return;
+        }
+    }
+
     // 删除振动数据
     query.prepare("DELETE FROM vibration_blocks WHERE round_id = ?");
     query.addBindValue(roundId);
@@ -255,6 +284,37 @@ void DatabasePage::onDeleteRound()
     }
     int deletedVibration = query.numRowsAffected();
 
+    // 删除段文件登记（文件在提交后删除）
+    QStringList segmentFiles;
+    if (m_querier->hasVibrationSegments()) {
+        query.prepare("SELECT segment_id FROM vibration_segments WHERE round_id = ?");
+        query.addBindValue(roundId);
+        if (query.exec()) {
+            while (query.next()) {
+                segmentFiles << VibrationSegmentWriter::fileName(roundId, query.value(0).toLongLong());
+            }
+        }
+
+        query.prepare("DELETE FROM vibration_segments WHERE round_id = ?");
+        query.addBindValue(roundId);
+        if (!query.exec()) {
+            db.rollback();
+            QMessageBox::critical(this, "错误", "删除振动数据失败：" + query.lastError().text());
+            return;
+        }
+    }
+
+    // 删除振动降采样金字塔
+    if (m_querier->hasVibrationPyramid()) {
+        query.prepare("DELETE FROM vibration_pyramid WHERE round_id = ?");
+        query.addBindValue(roundId);
+        if (!query.exec()) {
+            db.rollback();
+            QMessageBox::critical(this, "错误", "删除振动数据失败：" + query.lastError().text());
+            return;
+        }
+    }
+
     // 删除时间窗口
     query.prepare("DELETE FROM time_windows WHERE round_id = ?");
     query.addBindValue(roundId);
@@ -300,6 +360,8 @@ void DatabasePage::onDeleteRound()
         return;
     }
 
+    m_querier->removeSegmentFiles(segmentFiles);
+
     // 显示成功消息
     QString successMsg = QString(
         "轮次 %1 删除成功！\n\n"
@@ -402,13 +464,28 @@ void DatabasePage::onQuery()
     qint64 endUs = m_currentRoundStartUs + (qint64)endSec * 1000000;
     int roundId = m_currentRoundId;
 
+    // 振动曲线按图表宽度取包络（每像素约一点），不解码原始BLOB
+    int maxPoints = qMax(100, m_scalarPlot ? m_scalarPlot->width() : 1000);
+
     // 启动异步查询
-    QFuture<QList<DataQuerier::WindowData>> future = QtConcurrent::run([roundId, startUs, endUs, dbPath]() {
+    QFuture<QueryResult> future = QtConcurrent::run([roundId, startUs, endUs, dbPath, maxPoints]() {
+        QueryResult result;
         DataQuerier tempQuerier(dbPath);
         if (tempQuerier.initialize()) {
-            return tempQuerier.getTimeRangeData(roundId, startUs, endUs);
+            result.windows = tempQuerier.getTimeRangeData(roundId, startUs, endUs, false);
+
+            QSet<int> channels;
+            for (const auto &window : result.windows) {
+                for (auto it = window.vibrationSampleCounts.begin(); it != window.vibrationSampleCounts.end(); ++it) {
+                    channels.insert(it.key());
+                }
+            }
+            for (int channelId : channels) {
+                result.vibration[channelId] =
+                    tempQuerier.getVibrationEnvelope(roundId, channelId, startUs, endUs, maxPoints);
+            }
         }
-        return QList<DataQuerier::WindowData>();
+        return result;
     });
 
     m_queryWatcher.setFuture(future);
@@ -430,8 +507,13 @@ void DatabasePage::displayQueryResult(const QList<DataQuerier::WindowData> &data
 
         // 振动数据采样点数
         for (int ch = 0; ch < 3; ++ch) {
-            int count = data.vibrationData.contains(ch) ? data.vibrationData[ch].size() : 0;
-            ui->table_result->setItem(i, 1 + ch, new QTableWidgetItem(QString::number(count)));
+            int count = data.vibrationSampleCounts.value(ch, 0);
+            QString text = QString::number(count);
+            if (data.vibrationDecimation.contains(ch)) {
+                // 反压降级窗口：样本为包络对，不是原始波形
+                text += QString(" (包络1/%1)").arg(data.vibrationDecimation.value(ch));
+            }
+            ui->table_result->setItem(i, 1 + ch, new QTableWidgetItem(text));
         }
 
         // MDB数据
@@ -498,6 +580,15 @@ void DatabasePage::onExecSql()
 // ==================================================
 static QString sensorTypeToString(int sensorType)
 {
+    // 振动通道组合键 (20000 + 全局通道号)，每张采集卡3个通道
+    if (sensorType >= 20000 && sensorType < 30000) {
+        const int channelId = sensorType - 20000;
+        const QString axis = QString("XYZ").at(channelId % 3);
+        const int cardIndex = channelId / 3;
+        return cardIndex == 0 ? QString("振动%1").arg(axis)
+                              : QString("卡%1振动%2").arg(cardIndex + 1).arg(axis);
+    }
+
     // 处理电机数据的组合键 (sensorType * 100 + motorId)
     // 例如：30002 = Motor_Position for motor 2
     if (sensorType >= 30000 && sensorType < 40000) {
@@ -518,6 +609,7 @@ static QString sensorTypeToString(int sensorType)
         case SensorType::Vibration_X: return "振动X";
         case SensorType::Vibration_Y: return "振动Y";
         case SensorType::Vibration_Z: return "振动Z";
+        case SensorType::Vibration_Summary: return "振动摘要";
         case SensorType::Torque_MDB: return "扭矩(MDB)";
         case SensorType::Force_Upper: return "上拉力(MDB)";
         case SensorType::Force_Lower: return "下拉力(MDB)";
@@ -535,6 +627,10 @@ static QString sensorTypeToString(int sensorType)
 // ==================================================
 static QString sensorTypeToUnit(int sensorType)
 {
+    if (sensorType >= 20000 && sensorType < 30000) {
+        return "g";     // 振动通道组合键
+    }
+
     // 处理电机数据的组合键
     if (sensorType >= 30000 && sensorType < 40000) {
         int baseSensorType = sensorType / 100;
@@ -551,6 +647,7 @@ static QString sensorTypeToUnit(int sensorType)
         case SensorType::Vibration_X:
         case SensorType::Vibration_Y:
         case SensorType::Vibration_Z:
+        case SensorType::Vibration_Summary:
             return "g";  // 重力加速度
         case SensorType::Torque_MDB:
             return "N·m";  // 牛顿米
@@ -619,7 +716,9 @@ void DatabasePage::onQueryFinished()
     }
 
     // 获取结果并保存
-    m_currentQueryData = m_queryWatcher.result();
+    QueryResult result = m_queryWatcher.result();
+    m_currentQueryData = result.windows;
+    m_currentVibration = result.vibration;
 
     // 更新显示
     displayQueryResult(m_currentQueryData);
@@ -666,30 +765,24 @@ void DatabasePage::updateScalarPlot(const QList<DataQuerier::WindowData> &dataLi
     QMap<int, QVector<double>> xData;
     QMap<int, QVector<double>> yData;
 
-    for (const auto &window : dataList) {
-        double winStartSec = (window.windowStartUs - m_currentRoundStartUs) / 1000000.0;
-
-        // 处理振动数据（仅在选择"全部"或"振动"时显示）
-        if (filterType == 0 || filterType == 1) {
-            for (auto it = window.vibrationData.begin(); it != window.vibrationData.end(); ++it) {
-                int channelId = it.key();
-                const QVector<float>& values = it.value();
-
-                if (values.isEmpty()) continue;
-
-                // 计算RMS值作为该窗口的统计指标
-                double sumSq = 0.0;
-                for (float v : values) {
-                    sumSq += v * v;
-                }
-                double rms = std::sqrt(sumSq / values.size());
-
-                // 使用200+channelId作为sensorType
-                int sensorType = 200 + channelId;
-                xData[sensorType].append(winStartSec + 0.5);  // 窗口中心点
-                yData[sensorType].append(rms);
+    // 处理振动数据（仅在选择"全部"或"振动"时显示）：包络的每个桶取RMS，画在桶中心
+    if (filterType == 0 || filterType == 1) {
+        for (auto it = m_currentVibration.begin(); it != m_currentVibration.end(); ++it) {
+            const DataQuerier::VibrationEnvelope &envelope = it.value();
+
+            // 使用组合键20000+全局通道号（多卡时通道号可超过2，避免与210/211等类型冲突）
+            int sensorType = 20000 + it.key();
+            double halfBucketSec = envelope.bucketUs / 2000000.0;
+            for (int i = 0; i < envelope.timestampsUs.size(); ++i) {
+                xData[sensorType].append((envelope.timestampsUs[i] - m_currentRoundStartUs) / 1000000.0
+                                         + halfBucketSec);
+                yData[sensorType].append(envelope.rmsValues[i]);
             }
         }
+    }
+
+    for (const auto &window : dataList) {
+        double winStartSec = (window.windowStartUs - m_currentRoundStartUs) / 1000000.0;
 
         // 处理标量数据（MDB和电机）
         for (auto it = window.scalarData.begin(); it != window.scalarData.end(); ++it) {
@@ -834,6 +927,7 @@ void DatabasePage::startExportAsync(const QString& filePath)
         out << "# 100=上拉力(Force_Upper), 101=下拉力(Force_Lower)\n";
         out << "# 102=扭矩(Torque_MDB), 103=位置(Position_MDB)\n";
         out << "# 200=振动X(Vibration_X), 201=振动Y(Vibration_Y), 202=振动Z(Vibration_Z)\n";
+        out << "# 211=振动摘要(Vibration_Summary，反压降级期间；通道号=全局振动通道*4+统计量，0最小/1最大/2RMS/3均值)\n";
         out << "# 300=电机位置(Motor_Position), 301=电机速度(Motor_Speed)\n";
         out << "# 302=电机扭矩(Motor_Torque), 303=电机电流(Motor_Current)\n";
         out << "# ================================================\n";
@@ -182,6 +182,11 @@ void MdbPage::onDataBlockReceived(const DataBlock &block)
     appendHistory(idx, value);
     updateValueDisplay();
 
+    // 发布 → 刷新完成的渲染延迟
+    if (m_acquisitionManager) {
+        m_acquisitionManager->pipelineLatency()->recordRendered(block);
+    }
+
     // 调试日志（仅前3个样本）
     static int debugCount = 0;
     if (debugCount < 3) {
@@ -105,8 +105,26 @@ void MotorPage::onStopClicked()
 
 void MotorPage::onDataBlockReceived(const DataBlock &block)
 {
-    double val = block.values.isEmpty() ? 0.0 : block.values.first();
-    updateValueDisplay(block.channelId, block.sensorType, val);
+    // 电机快照：一次刷新全部电机的全部参数
+    if (block.sensorType == SensorType::Motor_Snapshot) {
+        for (int param = 0; param < MotorSnapshot::ParamCount; ++param) {
+            for (int motorId = 0; motorId < block.channelCount; ++motorId) {
+                const double value = block.snapshotValue(param, motorId);
+                if (!qIsNaN(value)) {
+                    updateValueDisplay(motorId, MotorSnapshot::paramSensorType(param), value);
+                }
+            }
+        }
+    } else {
+        // 高速采集块包含多个样本，显示最新值
+        double val = block.values.isEmpty() ? 0.0 : block.values.last();
+        updateValueDisplay(block.channelId, block.sensorType, val);
+    }
+
+    // 发布 → 刷新完成的渲染延迟
+    if (m_acquisitionManager) {
+        m_acquisitionManager->pipelineLatency()->recordRendered(block);
+    }
 }
 
 void MotorPage::updateValueDisplay(int motorId, SensorType type, double value)
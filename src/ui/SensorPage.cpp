@@ -90,37 +90,48 @@ void SensorPage::onVK701ConnectClicked()
 {
     if (!m_acquisitionManager) return;
 
-    int cardId = ui->spin_vk701_cardid->value();
-
-    qDebug() << "[SensorPage] Connecting to VK701: Card ID:" << cardId << "(Port 8234 fixed)";
-    ui->label_status->setText("正在连接 VK701...");
-
-    auto *worker = m_acquisitionManager->vibrationWorker();
-    if (!worker) {
+    const QList<VibrationWorker*> workers = m_acquisitionManager->vibrationWorkers();
+    if (workers.isEmpty()) {
         QMessageBox::warning(this, "错误", "VibrationWorker 未初始化");
         ui->label_status->setText("连接失败：Worker未初始化");
         return;
     }
 
-    worker->setCardId(cardId);
+    // 单卡：卡号取界面设置；多卡：卡号由config/acquisition.json决定，逐卡连接
+    if (workers.size() == 1) {
+        workers.first()->setCardId(ui->spin_vk701_cardid->value());
+    }
 
-    bool connected = false;
-    QMetaObject::invokeMethod(worker, "testConnection",
-                              Qt::BlockingQueuedConnection,
-                              Q_RETURN_ARG(bool, connected));
+    QStringList cardIds;
+    QStringList failedCardIds;
+    for (VibrationWorker *worker : workers) {
+        const int cardId = worker->cardId();
+        cardIds << QString::number(cardId);
 
-    if (connected) {
+        qDebug() << "[SensorPage] Connecting to VK701: Card ID:" << cardId << "(Port 8234 fixed)";
+        ui->label_status->setText(QString("正在连接 VK701（卡号%1）...").arg(cardId));
+
+        bool connected = false;
+        QMetaObject::invokeMethod(worker, "testConnection",
+                                  Qt::BlockingQueuedConnection,
+                                  Q_RETURN_ARG(bool, connected));
+        if (!connected) {
+            failedCardIds << QString::number(cardId);
+        }
+    }
+
+    if (failedCardIds.isEmpty()) {
         m_vk701Connected = true;
         updateUIState();
         ui->label_status->setText("VK701已连接");
         QMessageBox::information(this, "连接成功",
-            QString("VK701已连接\n卡号: %1\nTCP端口: 8234 (固定)").arg(cardId));
+            QString("VK701已连接\n卡号: %1\nTCP端口: 8234 (固定)").arg(cardIds.join(", ")));
     } else {
         m_vk701Connected = false;
         updateUIState();
         ui->label_status->setText("VK701连接失败");
         QMessageBox::critical(this, "连接失败",
-            QString("无法连接到 VK701\n卡号: %1\nTCP端口: 8234").arg(cardId));
+            QString("无法连接到 VK701\n卡号: %1\nTCP端口: 8234").arg(failedCardIds.join(", ")));
     }
 }
 
@@ -128,9 +139,10 @@ void SensorPage::onVK701DisconnectClicked()
 {
     if (!m_acquisitionManager) return;
 
-    auto *worker = m_acquisitionManager->vibrationWorker();
-    if (worker && worker->isConnected()) {
-        worker->disconnect();
+    for (VibrationWorker *worker : m_acquisitionManager->vibrationWorkers()) {
+        if (worker->isConnected()) {
+            worker->disconnect();
+        }
     }
 
     m_vk701Connected = false;
@@ -157,8 +169,11 @@ void SensorPage::onVK701FrequencyChanged()
     }
 
     int freq = ui->spin_vk701_frequency->value();
-    if (m_acquisitionManager && m_acquisitionManager->vibrationWorker()) {
-        m_acquisitionManager->vibrationWorker()->setSampleRate(freq);
+    if (m_acquisitionManager) {
+        // 多卡使用同一采样率
+        for (VibrationWorker *worker : m_acquisitionManager->vibrationWorkers()) {
+            worker->setSampleRate(freq);
+        }
         qDebug() << "VK701 sample rate changed to:" << freq << "Hz";
     }
 }
@@ -496,8 +511,11 @@ void SensorPage::updateSensorIndicators()
 {
     // VK701指示灯
     bool vk701Online = m_vk701Connected;
-    if (m_acquisitionManager && m_acquisitionManager->vibrationWorker()) {
-        vk701Online = m_acquisitionManager->vibrationWorker()->isConnected();
+    if (m_acquisitionManager && m_acquisitionManager->vibrationCardCount() > 0) {
+        vk701Online = true;
+        for (VibrationWorker *worker : m_acquisitionManager->vibrationWorkers()) {
+            vk701Online = vk701Online && worker->isConnected();
+        }
     }
     setIndicatorStyle(ui->lbl_vk701_indicator, vk701Online ? "● VK701" : "VK701", vk701Online);
 
@@ -15,6 +15,9 @@ VibrationPage::VibrationPage(QWidget *parent)
     , ui(new Ui::VibrationPage)
     , m_acquisitionManager(nullptr)
     , m_vibrationWorker(nullptr)
+    , m_displayCard(0)
+    , m_drainTimer(new QTimer(this))
+    , m_idleDrainTicks(0)
     , m_displayPoints(1000)
     , m_isAcquiring(false)
     , m_totalSamples(0)
@@ -38,18 +41,45 @@ void VibrationPage::setAcquisitionManager(AcquisitionManager *manager)
     // 从管理器获取VibrationWorker指针
     if (m_acquisitionManager) {
         m_vibrationWorker = m_acquisitionManager->vibrationWorker();
+        m_vibrationWorkers = m_acquisitionManager->vibrationWorkers();
+
+        // 所有卡的数据都进入同一个槽，按全局通道号筛选当前显示的卡
+        // 数据块从UI环形队列拉取；未设置队列的Worker仍通过dataBlockReady接收
+        for (int i = 0; i < m_vibrationWorkers.size(); ++i) {
+            VibrationWorker *worker = m_vibrationWorkers[i];
+            if (worker->uiRing()) {
+                connect(worker, &BaseWorker::blocksAvailable,
+                        this, &VibrationPage::onBlocksAvailable, Qt::QueuedConnection);
+                worker->uiRing()->requestNotify();
+            } else {
+                connect(worker, &BaseWorker::dataBlockReady,
+                        this, &VibrationPage::onDataBlockReceived, Qt::QueuedConnection);
+            }
+            connect(worker, &BaseWorker::statisticsUpdated, this,
+                    [this, i](qint64 samplesCollected, double sampleRate) {
+                        if (i == m_displayCard) {
+                            onStatisticsUpdated(samplesCollected, sampleRate);
+                        }
+                    }, Qt::QueuedConnection);
+        }
 
         if (m_vibrationWorker) {
-            // 连接Worker信号到页面槽函数
-            connect(m_vibrationWorker, &BaseWorker::dataBlockReady,
-                    this, &VibrationPage::onDataBlockReceived, Qt::QueuedConnection);
             connect(m_vibrationWorker, &BaseWorker::stateChanged,
                     this, &VibrationPage::onWorkerStateChanged, Qt::QueuedConnection);
-            connect(m_vibrationWorker, &BaseWorker::statisticsUpdated,
-                    this, &VibrationPage::onStatisticsUpdated, Qt::QueuedConnection);
+            qDebug() << "[VibrationPage] Connected to" << m_vibrationWorkers.size() << "VibrationWorker(s)";
+        }
 
-            qDebug() << "[VibrationPage] Connected to VibrationWorker";
+        // 采集卡选择（单卡时隐藏）
+        ui->combo_card->blockSignals(true);
+        ui->combo_card->clear();
+        for (VibrationWorker *worker : m_vibrationWorkers) {
+            ui->combo_card->addItem(QString("卡 %1").arg(worker->cardId()));
         }
+        ui->combo_card->blockSignals(false);
+        ui->label_card->setVisible(m_vibrationWorkers.size() > 1);
+        ui->combo_card->setVisible(m_vibrationWorkers.size() > 1);
+        m_displayCard = 0;
+        updateChannelTitles();
 
         qDebug() << "[VibrationPage] AcquisitionManager set";
     }
@@ -87,6 +117,11 @@ void VibrationPage::setupConnections()
     connect(ui->btn_start, &QPushButton::clicked, this, &VibrationPage::onStartClicked);
     connect(ui->btn_stop, &QPushButton::clicked, this, &VibrationPage::onStopClicked);
     connect(ui->btn_pause, &QPushButton::clicked, this, &VibrationPage::onPauseClicked);
+    connect(ui->combo_card, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &VibrationPage::onDisplayCardChanged);
+
+    m_drainTimer->setInterval(UI_DRAIN_INTERVAL_MS);
+    connect(m_drainTimer, &QTimer::timeout, this, &VibrationPage::drainUiRings);
 }
 
 void VibrationPage::initializePlots()
@@ -137,15 +172,17 @@ void VibrationPage::onStartClicked()
         return;
     }
 
-    if (!m_vibrationWorker->isConnected()) {
-        QMessageBox::critical(this, "连接错误",
-            "VK701采集卡未连接！\n\n"
-            "请先在【数据采集】页面：\n"
-            "1. 配置VK701连接参数\n"
-            "2. 点击【连接】按钮\n"
-            "3. 确认连接成功后再启动采集");
-        qDebug() << "[VibrationPage] Cannot start: VK701 not connected";
-        return;
+    for (VibrationWorker *worker : m_vibrationWorkers) {
+        if (!worker->isConnected()) {
+            QMessageBox::critical(this, "连接错误",
+                QString("VK701采集卡（卡号%1）未连接！\n\n"
+                "请先在【数据采集】页面：\n"
+                "1. 配置VK701连接参数\n"
+                "2. 点击【连接】按钮\n"
+                "3. 确认连接成功后再启动采集").arg(worker->cardId()));
+            qDebug() << "[VibrationPage] Cannot start: VK701 card" << worker->cardId() << "not connected";
+            return;
+        }
     }
 
     qDebug() << "[VibrationPage] VK701 is connected, starting acquisition...";
@@ -200,8 +237,10 @@ void VibrationPage::onPauseClicked()
 
     // 根据当前状态切换暂停/恢复
     if (m_isAcquiring) {
-        // 暂停采集
-        QMetaObject::invokeMethod(m_vibrationWorker, "pause", Qt::QueuedConnection);
+        // 暂停采集（所有卡）
+        for (VibrationWorker *worker : m_vibrationWorkers) {
+            QMetaObject::invokeMethod(worker, "pause", Qt::QueuedConnection);
+        }
 
         ui->btn_start->setEnabled(true);
         ui->btn_pause->setText("恢复");
@@ -210,8 +249,10 @@ void VibrationPage::onPauseClicked()
 
         qDebug() << "[VibrationPage] Pause command sent";
     } else {
-        // 恢复采集
-        QMetaObject::invokeMethod(m_vibrationWorker, "resume", Qt::QueuedConnection);
+        // 恢复采集（所有卡）
+        for (VibrationWorker *worker : m_vibrationWorkers) {
+            QMetaObject::invokeMethod(worker, "resume", Qt::QueuedConnection);
+        }
 
         ui->btn_start->setEnabled(false);
         ui->btn_pause->setText("暂停");
@@ -222,37 +263,92 @@ void VibrationPage::onPauseClicked()
     }
 }
 
-void VibrationPage::onDataBlockReceived(const DataBlock &block)
+void VibrationPage::onBlocksAvailable()
 {
-    // 检查是否是振动数据
-    if (block.sensorType != SensorType::Vibration_X &&
-        block.sensorType != SensorType::Vibration_Y &&
-        block.sensorType != SensorType::Vibration_Z) {
-        return;  // 不是振动数据，忽略
+    m_idleDrainTicks = 0;
+    if (!m_drainTimer->isActive()) {
+        m_drainTimer->start();
     }
+    drainUiRings();
+}
 
-    // 确定通道ID（0, 1, 2 对应 X, Y, Z）
-    int channelId = block.channelId;
-    if (channelId < 0 || channelId >= 3) {
-        qWarning() << "[VibrationPage] Invalid channel ID:" << channelId;
+void VibrationPage::drainUiRings()
+{
+    bool received = false;
+    for (VibrationWorker *worker : m_vibrationWorkers) {
+        DataBlockRing *ring = worker->uiRing();
+        if (!ring) {
+            continue;
+        }
+        DataBlock block;
+        while (ring->tryPop(block)) {
+            onDataBlockReceived(block);
+            received = true;
+        }
+    }
+
+    if (received) {
+        m_idleDrainTicks = 0;
+        return;
+    }
+    if (++m_idleDrainTicks < UI_IDLE_TICKS) {
         return;
     }
 
-    // 解析BLOB数据
-    int numSamples = block.numSamples;
-    const float *floatData = reinterpret_cast<const float*>(block.blobData.constData());
+    // 持续无数据：停止轮询，改由Worker在下一次写入后通知
+    m_drainTimer->stop();
+    for (VibrationWorker *worker : m_vibrationWorkers) {
+        if (worker->uiRing()) {
+            worker->uiRing()->requestNotify();
+        }
+    }
+    // 请求生效前写入的块不会触发通知，再检查一次
+    for (VibrationWorker *worker : m_vibrationWorkers) {
+        if (worker->uiRing() && !worker->uiRing()->isEmpty()) {
+            onBlocksAvailable();
+            return;
+        }
+    }
+}
 
-    // 准备时间和数值数据
-    QVector<double> timeData(numSamples);
-    QVector<double> valueData(numSamples);
+void VibrationPage::onDataBlockReceived(const DataBlock &block)
+{
+    // 检查是否是振动数据
+    if (!isVibrationType(block.sensorType)) {
+        return;  // 不是振动数据，忽略
+    }
 
-    for (int i = 0; i < numSamples; i++) {
-        timeData[i] = i;  // 简化时间轴（0, 1, 2, ...）
-        valueData[i] = floatData[i] * 1000.0;  // 转换为mV（参考原实现）
+    int numSamples = block.numSamples;
+
+    // 全局通道号 → 当前显示卡的本地通道（0, 1, 2），其他卡的数据不绘制
+    const int channelBase = m_displayCard * AcquisitionManager::VIBRATION_CHANNELS_PER_CARD;
+
+    if (block.isPacked()) {
+        // 打包块：X/Y/Z连续存放，一次更新全部通道（合成负载可能多于3通道，只显示本卡范围内的）
+        bool rendered = false;
+        for (int ch = 0; ch < block.channelCount; ++ch) {
+            const int localChannel = block.channelId + ch - channelBase;
+            if (localChannel >= 0 && localChannel < 3) {
+                appendChannelData(localChannel, block.channelData(ch), numSamples, block.sampleRate);
+                rendered = true;
+            }
+        }
+        if (!rendered) {
+            return;
+        }
+    } else {
+        const int localChannel = block.channelId - channelBase;
+        if (localChannel < 0 || localChannel >= 3) {
+            return;
+        }
+        appendChannelData(localChannel, reinterpret_cast<const float*>(block.payloadData()),
+                          numSamples, block.sampleRate);
     }
 
-    // 更新图表
-    updatePlot(channelId, timeData, valueData);
+    // 发布 → 重绘完成的渲染延迟
+    if (m_acquisitionManager) {
+        m_acquisitionManager->pipelineLatency()->recordRendered(block);
+    }
 
     // 更新统计信息（每100个数据块更新一次）
     static int blockCounter = 0;
@@ -263,6 +359,38 @@ void VibrationPage::onDataBlockReceived(const DataBlock &block)
     }
 }
 
+void VibrationPage::appendChannelData(int channelId, const float *floatData, int numSamples, double sampleRate)
+{
+    // 确定通道ID（0, 1, 2 对应 X, Y, Z）
+    if (channelId < 0 || channelId >= 3) {
+        qWarning() << "[VibrationPage] Invalid channel ID:" << channelId;
+        return;
+    }
+
+    // 滚动显示最近1秒数据（流式模式下每块只有几十毫秒，逐块追加）
+    const int displaySpan = qMax(numSamples, static_cast<int>(sampleRate));
+    QVector<double> &valueData = m_channelValueData[channelId];
+    QVector<double> &timeData = m_channelTimeData[channelId];
+
+    for (int i = 0; i < numSamples; i++) {
+        valueData.append(floatData[i] * 1000.0);  // 转换为mV（参考原实现）
+    }
+    if (valueData.size() > displaySpan) {
+        valueData.remove(0, valueData.size() - displaySpan);
+    }
+
+    // 时间轴（0, 1, 2, ...）只在长度变化时重建
+    if (timeData.size() != valueData.size()) {
+        timeData.resize(valueData.size());
+        for (int i = 0; i < timeData.size(); i++) {
+            timeData[i] = i;
+        }
+    }
+
+    // 更新图表
+    updatePlot(channelId, timeData, valueData);
+}
+
 void VibrationPage::updatePlot(int channelId, const QVector<double> &timeData, const QVector<double> &valueData)
 {
     if (channelId < 0 || channelId >= 3) {
@@ -283,6 +411,9 @@ void VibrationPage::updatePlot(int channelId, const QVector<double> &timeData, c
 
 void VibrationPage::clearAllPlots()
 {
+    m_channelTimeData.clear();
+    m_channelValueData.clear();
+
     for (int i = 0; i < 3; i++) {
         QVector<double> x(m_displayPoints), y(m_displayPoints);
         for (int j = 0; j < m_displayPoints; j++) {
@@ -294,6 +425,30 @@ void VibrationPage::clearAllPlots()
     }
 }
 
+void VibrationPage::onDisplayCardChanged(int cardIndex)
+{
+    if (cardIndex < 0 || cardIndex >= m_vibrationWorkers.size()) {
+        return;
+    }
+
+    m_displayCard = cardIndex;
+    clearAllPlots();
+    updateChannelTitles();
+    qDebug() << "[VibrationPage] Displaying card" << m_vibrationWorkers[cardIndex]->cardId();
+}
+
+void VibrationPage::updateChannelTitles()
+{
+    // 标题显示全局通道号，多卡时与数据库中的channel_id一致
+    static const char *AXIS_NAMES[3] = {"X", "Y", "Z"};
+    QGroupBox *groups[3] = {ui->groupBox_ch1, ui->groupBox_ch2, ui->groupBox_ch3};
+    const int channelBase = m_displayCard * AcquisitionManager::VIBRATION_CHANNELS_PER_CARD;
+
+    for (int i = 0; i < 3; i++) {
+        groups[i]->setTitle(QString("通道 %1 (%2-Axis) - 加速度").arg(channelBase + i + 1).arg(AXIS_NAMES[i]));
+    }
+}
+
 void VibrationPage::onWorkerStateChanged(WorkerState state)
 {
     // 根据WorkerState更新UI